@@ -36,6 +36,7 @@
 #include "ardour/profile.h"
 #include "ardour/region_fx_plugin.h"
 #include "ardour/session.h"
+#include "ardour/source_factory.h"
 
 #include "pbd/memento_command.h"
 
@@ -1346,6 +1347,13 @@ AudioRegionView::create_waves ()
 				// we'll get a PeaksReady signal from the source in the future
 				// and will call create_one_wave(n) then.
 				pending_peak_data->show ();
+
+				/* build peaks of what is visible before the rest */
+				samplepos_t const left  = trackview.editor().leftmost_sample ();
+				samplepos_t const right = left + trackview.editor().current_page_samples ();
+				if (_region->first_sample () < right && _region->last_sample () >= left) {
+					SourceFactory::prioritize_peakfile (audio_region()->audio_source(n));
+				}
 			}
 
 		} else {
@@ -177,6 +177,10 @@ UIConfiguration::build_metadata ()
 	VAR_META (X_("denormal-model"), _("denormal"), _("model"), _("handling"), _("cpu"), _("performance"), _("speed"), _("xruns"), _("dsp"), _("load"),  NULL);
 	VAR_META (X_("denormal-protection"), _("denormal"), _("model"), _("handling"), _("cpu"), _("performance"), _("speed"), _("xruns"), _("dsp"), _("load"),  NULL);
 	VAR_META (X_("discover-plugins-on-start"), _("plugins"), _("scan"), _("discover"), _("rescan"), _("reload"), _("startup"),  NULL);
+	VAR_META (X_("disk-readahead-hints"), _("disk"), _("disc"), _("i/o"), _("io"), _("readahead"), _("prefetch"), _("performance"),  NULL);
+	VAR_META (X_("graph-work-stealing"), _("cpu"), _("threads"), _("parallel"), _("performance"), _("dsp"), _("scheduler"),  NULL);
+	VAR_META (X_("concurrent-route-processors"), _("cpu"), _("threads"), _("parallel"), _("performance"), _("dsp"), _("send"), _("meter"),  NULL);
+	VAR_META (X_("parallel-plugin-instance-threshold"), _("cpu"), _("threads"), _("parallel"), _("performance"), _("dsp"), _("plugin"), _("surround"),  NULL);
 	VAR_META (X_("history-depth"), _("history"), _("undo"), _("redo"), _("depth"), _("length"), _("size"),  NULL);
 	VAR_META (X_("layer-model"), _("editing"), _("layering"), _("model"), _("style"), _("type"),  NULL);
 	VAR_META (X_("link-send-and-route-panner"), _("mixing"), _("panning"), _("send"), _("panner"), _("link"), _("connect"), _("tie"),  NULL);
@@ -205,6 +209,7 @@ UIConfiguration::build_metadata ()
 	VAR_META (X_("minimum-disk-write-bytes"), _("disk"), _("disc"), _("i/o"), _("io"), _("chunk"), _("write"), _("size"), _("bytes"), _("buffering"),  NULL);
 	VAR_META (X_("mmc-receive-device-id"), _("midi"), _("machine"), _("control"), _("mmc"), _("receive"), _("receiving"), _("device"), _("id"),  NULL);
 	VAR_META (X_("mmc-send-device-id"), _("midi"), _("machine"), _("control"), _("mmc"), _("send"), _("sending"), _("device"), _("id"),  NULL);
+	VAR_META (X_("mmap-audio-sources"), _("disk"), _("disc"), _("i/o"), _("io"), _("mmap"), _("memory"), _("map"), _("performance"),  NULL);
 	VAR_META (X_("monitoring-model"), _("monitoring"), _("model"), _("style"), _("type"),  NULL);
 	VAR_META (X_("mtc-qf-speed-tolerance"), _("transport"), _("synchronization"), _("MIDI"), _("timecode"), _("time"), _("code"), _("threshold"), _("tolerance"), _("sensitivity"), _("quarter"), _("frame"),  NULL);
 	VAR_META (X_("mute-affects-control-outs"), _("mute"), _("muting"), _("monitor"), _("outs"), _("control"), _("outputs"),  NULL);
@@ -5117,6 +5117,45 @@ These settings will only take effect after %1 is restarted.\n\
 		procs->set_note (string_compose (_("This setting will only take effect when %1 is restarted."), PROGRAM_NAME));
 
 		add_option (_("Performance"), procs);
+
+		BoolOption* ws = new BoolOption (
+				"graph-work-stealing",
+				_("Use per-thread work-stealing queues for parallel processing"),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::get_graph_work_stealing),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::set_graph_work_stealing)
+				);
+
+		set_tooltip (ws->tip_widget(), _("When enabled, each DSP thread keeps the tracks and busses that become ready to run in its own queue, and idle threads take work from busy ones. This reduces contention on systems with many CPU cores and large sessions. When disabled, all threads share a single queue."));
+
+		add_option (_("Performance"), ws);
+
+		ComboOption<uint32_t>* ppi = new ComboOption<uint32_t> (
+				"parallel-plugin-instance-threshold",
+				_("Run replicated plugin instances in parallel"),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::get_parallel_plugin_instance_threshold),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::set_parallel_plugin_instance_threshold)
+				);
+
+		ppi->add (0, _("never"));
+		ppi->add (25, string_compose (_("above %1 usec per instance"), 25));
+		ppi->add (50, string_compose (_("above %1 usec per instance"), 50));
+		ppi->add (100, string_compose (_("above %1 usec per instance"), 100));
+		ppi->add (250, string_compose (_("above %1 usec per instance"), 250));
+
+		set_tooltip (ppi->tip_widget(), _("When a plugin is replicated for each channel (e.g. a mono plugin on a surround bus), the instances are processed one after another by default. With this option, instances whose average processing time exceeds the given value are distributed to idle DSP threads."));
+
+		add_option (_("Performance"), ppi);
+
+		BoolOption* crp = new BoolOption (
+				"concurrent-route-processors",
+				_("Run sends and meters of a track or bus in parallel"),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::get_concurrent_route_processors),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::set_concurrent_route_processors)
+				);
+
+		set_tooltip (crp->tip_widget(), _("When enabled, consecutive sends and meters in a processor box, which only read the signal, are distributed to idle DSP threads instead of being processed one after another. This can help heavily loaded busses with many sends."));
+
+		add_option (_("Performance"), crp);
 	}
 
 #if !(defined PLATFORM_WINDOWS || defined __APPLE__)
@@ -5229,6 +5268,29 @@ These settings will only take effect after %1 is restarted.\n\
 
 	add_option (_("Performance"), new BufferingOptions (_rc_config));
 
+	BoolOption* rah = new BoolOption (
+			"disk-readahead-hints",
+			_("Request read-ahead for all tracks before reading from disk"),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::get_disk_readahead_hints),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::set_disk_readahead_hints)
+			);
+
+	set_tooltip (rah->tip_widget(), _("When enabled, the disk reader asks the operating system to start loading the data needed by all tracks at once, before the I/O threads read it. This can improve disk throughput with large track-counts. Only uncompressed WAV, RF64, CAF and AIFF files benefit from this, and it currently has no effect on Windows and macOS."));
+
+	add_option (_("Performance"), rah);
+
+	BoolOption* mmap = new BoolOption (
+			"mmap-audio-sources",
+			_("Read uncompressed audio files via memory mapping"),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::get_mmap_audio_sources),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::set_mmap_audio_sources)
+			);
+
+	set_tooltip (mmap->tip_widget(), _("When enabled, 16, 24 and 32 bit integer and 32 bit float WAV and RF64 files are read directly from the operating system's file cache instead of being copied through the sound file library. This reduces CPU use for disk reads. Do not use this option if session files are stored on a network share or removable disk."));
+	mmap->set_note (_("This setting only affects sources that are opened after it was changed."));
+
+	add_option (_("Performance"), mmap);
+
 	if (hwcpus > 1) {
 		ComboOption<int32_t>* procs = new ComboOption<int32_t> (
 				"io-thread-count",
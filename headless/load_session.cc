@@ -17,6 +17,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <cstdlib>
 #if defined COMPILER_MSVC && defined WAF_BUILD
 #include "msvc/getopt.h"
@@ -62,6 +63,8 @@ static string backend_name = "JACK/Pipewire";
 static string backend_name = "JACK";
 #endif
 
+static double bench_seconds = 0;
+
 /** @param dir Session directory.
  *  @param state Session state file, without .ardour suffix.
  */
@@ -112,6 +115,62 @@ engine_halted (const char* reason)
 	xthread.deliver ('x');
 }
 
+/** Roll for bench_seconds of engine time using the Dummy backend's
+ * "Benchmark" driver, which runs process cycles back to back.
+ * Cycles are only recorded during this window, not while the session
+ * loads.
+ */
+static int
+run_benchmark (Session* s)
+{
+	AudioEngine*                  engine  = AudioEngine::instance ();
+	std::shared_ptr<AudioBackend> backend = engine->current_backend ();
+
+	/* the driver name is not translated */
+	std::vector<std::string> drivers = backend->enumerate_drivers ();
+	if (std::find (drivers.begin (), drivers.end (), "Benchmark") == drivers.end ()) {
+		cerr << "The Dummy backend does not offer a Benchmark driver\n";
+		return -1;
+	}
+
+	s->request_roll ();
+
+	int timeout = 500;
+	while (!s->transport_rolling () && --timeout > 0) {
+		Glib::usleep (10000);
+	}
+	if (!s->transport_rolling ()) {
+		cerr << "Transport did not start\n";
+		return -1;
+	}
+
+	std::string const driver = backend->driver_name ();
+	samplepos_t const target = engine->sample_time () + (samplepos_t) (bench_seconds * engine->sample_rate ());
+	int64_t const     start  = g_get_monotonic_time ();
+
+	backend->set_driver ("Benchmark");
+
+	char msg;
+	while (engine->running () && engine->sample_time () < target) {
+		if (0 == xthread.receive (msg, false)) {
+			break;
+		}
+		Glib::usleep (1000);
+	}
+
+	/* leaving the Benchmark driver writes the report */
+	backend->set_driver (driver);
+
+	double const wall = (g_get_monotonic_time () - start) * 1e-6;
+	cout << "Rolled " << bench_seconds << " sec in " << wall << " sec";
+	if (wall > 0) {
+		cout << " (" << bench_seconds / wall << "x realtime)";
+	}
+	cout << endl;
+
+	return engine->sample_time () < target ? -1 : 0;
+}
+
 #ifndef PLATFORM_WINDOWS
 static void
 wearedone (int)
@@ -149,6 +208,8 @@ print_help ()
 	     << "  -D, --debug <options>       Set debug flags. Use \"-D list\" to see available options\n"
 	     << "  -O, --no-hw-optimizations   Disable h/w specific optimizations\n"
 	     << "  -P, --no-connect-ports      Do not connect any ports at startup\n"
+	     << "  -T, --bench <sec>           Use the Dummy backend, roll <sec> seconds as fast as possible and exit\n"
+	     << "  -R, --bench-report <file>   Write per-cycle timing of --bench to <file> (.json or .csv)\n"
 #ifdef WINDOWS_VST_SUPPORT
 	     << "  -V, --novst                 Do not use VST support\n"
 #endif
@@ -158,7 +219,7 @@ print_help ()
 int
 main (int argc, char* argv[])
 {
-	const char* optstring = "vhBdD:c:OU:P";
+	const char* optstring = "vhBdD:c:OU:PT:R:";
 
 	/* clang-format off */
 	const struct option longopts[] = {
@@ -170,6 +231,8 @@ main (int argc, char* argv[])
 		{ "name",                required_argument, 0, 'c' },
 		{ "no-hw-optimizations", no_argument,       0, 'O' },
 		{ "no-connect-ports",    no_argument,       0, 'P' },
+		{ "bench",               required_argument, 0, 'T' },
+		{ "bench-report",        required_argument, 0, 'R' },
 		{ 0, 0, 0, 0 }
 	};
 	/* clang-format on */
@@ -220,6 +283,20 @@ main (int argc, char* argv[])
 				ARDOUR::Port::set_connecting_blocked (true);
 				break;
 
+			case 'T':
+				bench_seconds = atof (optarg);
+				if (bench_seconds <= 0) {
+					cerr << "Invalid benchmark duration: " << optarg << "\n";
+					exit (EXIT_FAILURE);
+				}
+				backend_name = "None (Dummy)";
+				break;
+
+			case 'R':
+				/* read by the Dummy backend */
+				g_setenv ("ARDOUR_DUMMY_BENCH_REPORT", optarg, 1);
+				break;
+
 			default:
 				print_help ();
 				exit (EXIT_FAILURE);
@@ -274,16 +351,22 @@ main (int argc, char* argv[])
 	signal (SIGTERM, wearedone);
 #endif
 
-	s->request_roll ();
+	int rv = 0;
 
-	char msg;
-	do {
-	} while (0 == xthread.receive (msg, true));
+	if (bench_seconds > 0) {
+		rv = run_benchmark (s);
+	} else {
+		s->request_roll ();
+
+		char msg;
+		do {
+		} while (0 == xthread.receive (msg, true));
+	}
 
 	AudioEngine::instance ()->remove_session ();
 	delete s;
 	AudioEngine::instance ()->stop ();
 
 	ARDOUR::cleanup ();
-	return 0;
+	return rv == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
 }
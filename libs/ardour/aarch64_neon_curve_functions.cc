@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "pbd/control_math.h"
+
+#include "ardour/mix.h"
+
+#ifdef ARM_NEON_SUPPORT
+
+#include <arm_neon.h>
+
+/* Curve interpolation kernels. These need double precision lanes, which
+ * 32 bit ARM NEON lacks, so they are AArch64 only.
+ */
+
+static const double neon_index[4] = { 0., 1., 2., 3. };
+
+/* pack 2 x 2 doubles into 4 floats */
+static inline float32x4_t
+neon_cvt_f32 (float64x2_t x0, float64x2_t x1)
+{
+	return vcombine_f32 (vcvt_f32_f64 (x0), vcvt_f32_f64 (x1));
+}
+
+/**
+ * @brief 2^x for 2 x 2 doubles, as 4 floats
+ *
+ * 2^x = 2^n * 2^f with n = round (x) and |f| <= 0.5. The split is done in
+ * double precision, only 2^f is evaluated in single precision, by its
+ * Taylor series to degree 7. Relative error < 1e-7, x is clamped to
+ * [-126, 126].
+ */
+static inline float32x4_t
+neon_exp2 (float64x2_t x0, float64x2_t x1)
+{
+	const float64x2_t lo = vdupq_n_f64 (-126.);
+	const float64x2_t hi = vdupq_n_f64 (126.);
+
+	x0 = vminq_f64 (vmaxq_f64 (x0, lo), hi);
+	x1 = vminq_f64 (vmaxq_f64 (x1, lo), hi);
+
+	const float64x2_t n0 = vrndnq_f64 (x0);
+	const float64x2_t n1 = vrndnq_f64 (x1);
+	const float32x4_t f  = neon_cvt_f32 (vsubq_f64 (x0, n0), vsubq_f64 (x1, n1));
+
+	float32x4_t p = vdupq_n_f32 (1.5252734e-5f);
+	p = vfmaq_f32 (vdupq_n_f32 (1.5403530e-4f), p, f);
+	p = vfmaq_f32 (vdupq_n_f32 (1.3333558e-3f), p, f);
+	p = vfmaq_f32 (vdupq_n_f32 (9.6181291e-3f), p, f);
+	p = vfmaq_f32 (vdupq_n_f32 (5.5504109e-2f), p, f);
+	p = vfmaq_f32 (vdupq_n_f32 (2.4022651e-1f), p, f);
+	p = vfmaq_f32 (vdupq_n_f32 (6.9314718e-1f), p, f);
+	p = vfmaq_f32 (vdupq_n_f32 (1.f), p, f);
+
+	const int32x4_t n = vcombine_s32 (vmovn_s64 (vcvtq_s64_f64 (n0)), vmovn_s64 (vcvtq_s64_f64 (n1)));
+
+	return vmulq_f32 (p, vreinterpretq_f32_s32 (vshlq_n_s32 (vaddq_s32 (n, vdupq_n_s32 (127)), 23)));
+}
+
+/* 33 * p^(1/8) - 32, the exponent of position_to_gain (p) */
+static inline float64x2_t
+neon_gain_exponent (float64x2_t p)
+{
+	p = vmaxq_f64 (p, vdupq_n_f64 (0.));
+
+	const float64x2_t q = vsqrtq_f64 (vsqrtq_f64 (vsqrtq_f64 (p)));
+
+	return vfmaq_f64 (vdupq_n_f64 (-32.), q, vdupq_n_f64 (33.));
+}
+
+/* scale where p > 0, 0 otherwise: position_to_gain (0) == 0 */
+static inline float64x2_t
+neon_gain_scale (float64x2_t p, float64x2_t scale)
+{
+	return vreinterpretq_f64_u64 (vandq_u64 (vcgtq_f64 (p, vdupq_n_f64 (0.)), vreinterpretq_u64_f64 (scale)));
+}
+
+/**
+ * @brief ARM NEON optimized linear ramp, dst[i] = start + i * step
+ *
+ * The ramp is computed in double precision, the result is rounded
+ * once to float.
+ *
+ * @param[out] dst Pointer to destination buffer
+ * @param nframes Number of samples to process
+ * @param start Value of the first sample
+ * @param step Increment per sample
+ */
+void
+arm_neon_linear_ramp (float* dst, uint32_t nframes, double start, double step)
+{
+	const float64x2_t s0 = vdupq_n_f64 (start);
+	const float64x2_t d0 = vdupq_n_f64 (step);
+	const float64x2_t d4 = vdupq_n_f64 (4.);
+
+	float64x2_t i0 = vld1q_f64 (neon_index);
+	float64x2_t i1 = vld1q_f64 (neon_index + 2);
+	uint32_t    i  = 0;
+
+	for (; i + 4 <= nframes; i += 4) {
+		vst1q_f32 (dst + i, neon_cvt_f32 (vfmaq_f64 (s0, i0, d0), vfmaq_f64 (s0, i1, d0)));
+
+		i0 = vaddq_f64 (i0, d4);
+		i1 = vaddq_f64 (i1, d4);
+	}
+
+	for (; i < nframes; ++i) {
+		dst[i] = start + i * step;
+	}
+}
+
+/**
+ * @brief ARM NEON optimized exponential ramp, dst[i] = 2^(start + i * step)
+ *
+ * Relative error < 2e-7.
+ */
+void
+arm_neon_exp2_ramp (float* dst, uint32_t nframes, double start, double step)
+{
+	const float64x2_t s0 = vdupq_n_f64 (start);
+	const float64x2_t d0 = vdupq_n_f64 (step);
+	const float64x2_t d4 = vdupq_n_f64 (4.);
+
+	float64x2_t i0 = vld1q_f64 (neon_index);
+	float64x2_t i1 = vld1q_f64 (neon_index + 2);
+	uint32_t    i  = 0;
+
+	for (; i + 4 <= nframes; i += 4) {
+		vst1q_f32 (dst + i, neon_exp2 (vfmaq_f64 (s0, i0, d0), vfmaq_f64 (s0, i1, d0)));
+
+		i0 = vaddq_f64 (i0, d4);
+		i1 = vaddq_f64 (i1, d4);
+	}
+
+	for (; i < nframes; ++i) {
+		dst[i] = exp2 (start + i * step);
+	}
+}
+
+/**
+ * @brief ARM NEON optimized gain ramp,
+ * dst[i] = position_to_gain (start + i * step) * scale
+ *
+ * position_to_gain (p) = 2^(33 * p^(1/8) - 32), the exponent is computed
+ * in double precision. Relative error < 2e-7.
+ */
+void
+arm_neon_gain_ramp (float* dst, uint32_t nframes, double start, double step, double scale)
+{
+	const float64x2_t s0 = vdupq_n_f64 (start);
+	const float64x2_t d0 = vdupq_n_f64 (step);
+	const float64x2_t d4 = vdupq_n_f64 (4.);
+	const float64x2_t g0 = vdupq_n_f64 (scale);
+
+	float64x2_t i0 = vld1q_f64 (neon_index);
+	float64x2_t i1 = vld1q_f64 (neon_index + 2);
+	uint32_t    i  = 0;
+
+	for (; i + 4 <= nframes; i += 4) {
+		const float64x2_t p0 = vfmaq_f64 (s0, i0, d0);
+		const float64x2_t p1 = vfmaq_f64 (s0, i1, d0);
+		const float32x4_t g  = neon_cvt_f32 (neon_gain_scale (p0, g0), neon_gain_scale (p1, g0));
+
+		vst1q_f32 (dst + i, vmulq_f32 (neon_exp2 (neon_gain_exponent (p0), neon_gain_exponent (p1)), g));
+
+		i0 = vaddq_f64 (i0, d4);
+		i1 = vaddq_f64 (i1, d4);
+	}
+
+	for (; i < nframes; ++i) {
+		dst[i] = position_to_gain (start + i * step) * scale;
+	}
+}
+
+#endif // ARM_NEON_SUPPORT
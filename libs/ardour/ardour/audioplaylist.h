@@ -24,6 +24,8 @@
 #include <vector>
 #include <list>
 
+#include "pbd/mutex.h"
+
 #include "ardour/ardour.h"
 #include "ardour/playlist.h"
 
@@ -44,6 +46,9 @@ public:
 
 	timecnt_t read (Sample *dst, Sample *mixdown, float *gain_buffer, timepos_t const & start, timecnt_t const & cnt, uint32_t chan_n=0);
 
+	/** Hint that all channels of the given range will be read soon */
+	void prefetch (timepos_t const & start, timecnt_t const & cnt);
+
 	bool destroy_region (std::shared_ptr<Region>);
 
 protected:
@@ -58,6 +63,36 @@ private:
 	bool region_changed (const PBD::PropertyChange&, std::shared_ptr<Region>);
 	void source_offset_changed (std::shared_ptr<AudioRegion>);
         void load_legacy_crossfades (const XMLNode&, int version);
+
+	/** A part of a region that needs to be read, in session samples */
+	struct ReadSegment {
+		AudioRegion* region;
+		samplepos_t  start;
+		samplepos_t  end;      ///< exclusive
+		samplepos_t  max_end;  ///< maximum end of this and all earlier segments of a ReadPlan
+		size_t       order;    ///< segments with a higher order are read first
+		samplepos_t  region_position;
+		samplecnt_t  region_length;
+	};
+
+	/** Layering of the complete playlist, resolved into segments that
+	 * are sorted by start, so that read () only needs to find the
+	 * segments that overlap the requested range. Regions are only valid
+	 * as long as the region generation has not changed.
+	 */
+	struct ReadPlan {
+		ReadPlan (uint64_t g) : generation (g) {}
+
+		uint64_t                 generation;
+		std::vector<ReadSegment> segments;
+	};
+
+	void plan_segments (RegionVector const & sorted, samplepos_t start, samplepos_t end, bool solo_selection, std::vector<ReadSegment>&);
+	std::shared_ptr<ReadPlan const> read_plan ();
+	void setup_read_plan ();
+
+	std::shared_ptr<ReadPlan const> _read_plan;
+	PBD::Mutex                      _read_plan_lock;
 };
 
 } /* namespace ARDOUR */
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 
 #include <time.h>
@@ -36,6 +37,8 @@
 
 namespace ARDOUR {
 
+class PeakPyramid;
+
 class LIBARDOUR_API AudioSource : virtual public Source, public ARDOUR::AudioReadable
 {
   public:
@@ -53,6 +56,9 @@ class LIBARDOUR_API AudioSource : virtual public Source, public ARDOUR::AudioRea
 	virtual samplecnt_t read (Sample *dst, samplepos_t start, samplecnt_t cnt, int channel=0) const;
 	virtual samplecnt_t write (Sample const * src, samplecnt_t cnt);
 
+	/** Hint that the given range will be read soon. This must not block on I/O */
+	void prefetch (samplepos_t start, samplecnt_t cnt) const;
+
 	virtual float sample_rate () const = 0;
 
 	virtual void mark_streaming_write_completed (const WriterLock& lock, Temporal::timecnt_t const & duration);
@@ -90,6 +96,11 @@ class LIBARDOUR_API AudioSource : virtual public Source, public ARDOUR::AudioRea
 	int close_peakfile ();
 
 	int prepare_for_peakfile_writes ();
+
+	/** Stop a build_peaks_from_scratch () that is in progress, or
+	 * about to start. The request is reset when the build ends.
+	 */
+	void cancel_peak_build (bool yn = true) { _peak_build_cancelled.store (yn); }
 	void done_with_peakfile_writes (bool done = true);
 
 	/** @return true if the each source sample s must be clamped to -1 < s < 1 */
@@ -123,12 +134,19 @@ class LIBARDOUR_API AudioSource : virtual public Source, public ARDOUR::AudioRea
 
 	virtual samplecnt_t read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) const = 0;
 	virtual samplecnt_t write_unlocked (Sample const * dst, samplecnt_t cnt) = 0;
+	virtual void prefetch_unlocked (samplepos_t /*start*/, samplecnt_t /*cnt*/) const {}
 	virtual std::string construct_peak_filepath (const std::string& audio_path, const bool in_session = false, const bool old_peak_name = false) const = 0;
 
 	virtual int read_peaks_with_fpp (PeakData *peaks,
 					 samplecnt_t npeaks, samplepos_t start, samplecnt_t cnt,
 					 double samples_per_visual_peak, samplecnt_t fpp) const;
 
+	bool read_peaks_from_pyramid (PeakData *peaks,
+	                              samplecnt_t npeaks, samplepos_t start, samplecnt_t cnt,
+	                              double samples_per_visual_peak) const;
+	void setup_peak_pyramid ();
+	void drop_peak_pyramid (std::string const& peakpath) const;
+
 	int compute_and_write_peaks (Sample const * buf, samplecnt_t first_sample, samplecnt_t cnt,
 				     bool force, bool intermediate_peaks_ready_signal,
 				     samplecnt_t samples_per_peak);
@@ -145,6 +163,7 @@ class LIBARDOUR_API AudioSource : virtual public Source, public ARDOUR::AudioRea
         PBD::Mutex _initialize_peaks_lock;
 
 	int        _peakfile_fd;
+	std::atomic<bool> _peak_build_cancelled;
 	samplecnt_t peak_leftover_cnt;
 	samplecnt_t peak_leftover_size;
 	Sample*    peak_leftovers;
@@ -155,6 +174,8 @@ class LIBARDOUR_API AudioSource : virtual public Source, public ARDOUR::AudioRea
 	mutable off_t _last_map_off;
 	mutable size_t  _last_raw_map_length;
 	mutable std::unique_ptr<PeakData[]> peak_cache;
+	mutable std::unique_ptr<PeakPyramid> _pyramid;
+	mutable PBD::Mutex                   _pyramid_lock;
 };
 
 }
@@ -75,6 +75,17 @@ public:
 
 	LIBARDOUR_API float buffer_load () const;
 
+	/** @return number of samples that can be played before the buffer runs empty */
+	LIBARDOUR_API samplecnt_t underrun_margin () const;
+	/** @return number of samples that a refill can read into the buffer */
+	LIBARDOUR_API samplecnt_t refill_space () const;
+
+	/* called by the Butler before scheduling a refill,
+	 * ignored unless rolling, and for MIDI-only tracks */
+	LIBARDOUR_API void record_underrun_margin (samplecnt_t);
+	LIBARDOUR_API bool get_underrun_margin_stats (samplecnt_t& min, double& avg, uint32_t& n_underruns) const;
+	LIBARDOUR_API void reset_underrun_margin_stats ();
+
 	LIBARDOUR_API void move_processor_automation (std::weak_ptr<Processor>, std::list<Temporal::RangeMove> const&);
 
 	/* called by the Butler in a non-realtime context as part of its normal
@@ -83,6 +94,12 @@ public:
 	 */
 	LIBARDOUR_API int do_refill ();
 
+	/** Ask the OS to start reading the data that the next do_refill ()
+	 * will need, without waiting for it. Called by the Butler for all
+	 * tracks before any refill is started.
+	 */
+	LIBARDOUR_API void do_prefetch ();
+
 	/** For contexts outside the normal butler refill loop (allocates temporary working buffers) */
 	int do_refill_with_alloc (bool partial_fill, bool reverse);
 
@@ -199,6 +216,8 @@ protected:
 	};
 
 private:
+	bool midi_refill_pending () const;
+
 	samplepos_t    overwrite_sample;
 	sampleoffset_t overwrite_offset;
 	samplepos_t    new_file_sample;
@@ -256,6 +275,11 @@ private:
 
 	bool _midi_catchup;
 	bool _need_midi_catchup;
+
+	std::atomic<samplecnt_t> _margin_min;
+	std::atomic<samplecnt_t> _margin_sum;
+	std::atomic<uint32_t>    _margin_cnt;
+	std::atomic<uint32_t>    _underrun_cnt;
 };
 
 } // namespace ARDOUR
@@ -88,6 +88,11 @@ public:
 
 	static PBD::Signal<int(std::string,std::vector<std::string> )> AmbiguousFileName;
 
+	/** When set, find() in the calling thread fails for an ambiguous
+	 * file name instead of emitting AmbiguousFileName, which asks the user.
+	 */
+	static void set_non_interactive_find (bool);
+
 	void existence_check ();
 	virtual void prevent_deletion ();
 
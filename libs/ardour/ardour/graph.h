@@ -24,6 +24,7 @@
 
 #include <atomic>
 #include <list>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
@@ -32,6 +33,7 @@
 
 #include "pbd/mpmc_queue.h"
 #include "pbd/semutils.h"
+#include "pbd/ws_deque.h"
 
 #include "ardour/audio_backend.h"
 #include "ardour/libardour_visibility.h"
@@ -46,6 +48,7 @@ class Graph;
 
 class IOPlug;
 class Route;
+class RTSubtasks;
 class RTTaskList;
 class Session;
 class GraphEdges;
@@ -62,16 +65,22 @@ struct GraphChain {
 	bool plot (std::string const&) const;
 
 	node_list_t _nodes_rt;
-	/** Nodes that are not fed by any other nodes */
+	/** Nodes that are not fed by any other nodes, ordered by descending critical path */
 	node_list_t _init_trigger_list;
 	/** The number of nodes that do not feed any other node */
 	int _n_terminal_nodes;
+	/** Estimated cost of each node plus the longest path of nodes downstream of it */
+	std::map<GraphNode const*, float> _critical_path;
+
+private:
+	float critical_path (node_ptr_t const&, GraphEdges const&);
 };
 
 class LIBARDOUR_API Graph : public SessionHandleRef
 {
 public:
 	Graph (Session& session);
+	~Graph ();
 
 	/* public API for use by session-process */
 	int process_routes (std::shared_ptr<GraphChain> chain, pframes_t nframes, samplepos_t start_sample, samplepos_t end_sample, bool& need_butler);
@@ -85,6 +94,7 @@ public:
 	/* called by GraphNode */
 	void trigger (ProcessNode* n);
 	void reached_terminal_node ();
+	bool lifo_trigger () const { return _work_stealing; }
 
 	/* called by virtual GraphNode::process() */
 	void process_one_route (Route* route);
@@ -93,6 +103,9 @@ public:
 	/* RTTasks */
 	void process_tasklist (RTTaskList const&);
 
+	/* called by RTSubtasks from inside a graph node */
+	void process_subtasks (RTSubtasks&);
+
 protected:
 	virtual void session_going_away ();
 
@@ -104,9 +117,18 @@ private:
 	void prep ();
 
 	void helper_thread ();
+	bool pop_node (ProcessNode*&);
 
 	PBD::MPMCQueue<ProcessNode*> _trigger_queue;      ///< nodes that can be processed
-	std::atomic<uint32_t>        _trigger_queue_size; ///< number of entries in trigger-queue
+	std::atomic<uint32_t>        _trigger_queue_size; ///< number of entries in trigger-queue and all work-queues
+
+	/** Per process-thread deques, used when work-stealing is enabled.
+	 * Index 0 is the main graph thread, 1..n the helper threads.
+	 */
+	std::vector<PBD::WSDeque<ProcessNode*>*> _work_queues;
+
+	/** Use _work_queues for the current cycle, cached at the start of each cycle */
+	bool _work_stealing;
 
 	/** Start worker threads */
 	PBD::Semaphore _execution_sem;
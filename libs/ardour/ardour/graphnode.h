@@ -54,17 +54,17 @@ public:
 	GraphActivision ();
 	virtual ~GraphActivision () {}
 
-	typedef std::map<GraphChain const*, node_set_t> ActivationMap;
-	typedef std::map<GraphChain const*, int>        RefCntMap;
+	typedef std::map<GraphChain const*, node_list_t> ActivationMap;
+	typedef std::map<GraphChain const*, int>         RefCntMap;
 
-	node_set_t const& activation_set (GraphChain const* const g) const;
+	node_list_t const& activation_set (GraphChain const* const g) const;
 	int               init_refcount (GraphChain const* const g) const;
 	void              flush_graph_activision_rcu ();
 
 protected:
 	friend struct GraphChain;
 
-	/** Nodes that we directly feed */
+	/** Nodes that we directly feed, ordered by descending critical path */
 	SerializedRCUManager<ActivationMap> _activation_set;
 	/** The number of nodes that we directly feed us (one count for each chain) */
 	SerializedRCUManager<RefCntMap> _init_refcount;
@@ -85,6 +85,9 @@ public:
 
 	virtual bool direct_feeds_according_to_reality (std::shared_ptr<GraphNode>, bool* via_send_only = 0) = 0;
 
+	/** @return average time spent in process() in microseconds */
+	float process_time () const { return _process_time.load (); }
+
 protected:
 	void trigger ();
 	virtual void process () = 0;
@@ -94,7 +97,8 @@ protected:
 private:
 	void finish (GraphChain const*);
 
-	std::atomic<int> _refcount;
+	std::atomic<int>   _refcount;
+	std::atomic<float> _process_time;
 };
 
 } // namespace ARDOUR
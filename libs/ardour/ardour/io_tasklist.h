@@ -39,14 +39,21 @@ public:
 
 	/** process tasks in list in parallel, wait for them to complete */
 	void process ();
-	void push_back (std::function<void ()> fn);
+
+	/** add a task.
+	 * @param priority tasks with a lower value are started first,
+	 * e.g. the time until a track's playback buffer runs empty
+	 */
+	void push_back (std::function<void ()> fn, double priority = 0);
 
 private:
 	static void* _worker_thread (void*);
 
 	void io_thread ();
 
-	std::vector<std::function<void ()>> _tasks;
+	typedef std::pair<double, std::function<void ()>> Task;
+
+	std::vector<Task> _tasks;
 
 	uint32_t               _n_threads;
 	std::atomic<uint32_t>  _n_workers;
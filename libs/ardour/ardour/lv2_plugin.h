@@ -185,6 +185,9 @@ class LIBARDOUR_API LV2Plugin : public ARDOUR::Plugin, public ARDOUR::Workee
 	int work_response(uint32_t size, const void* data);
 
 	void                       set_property(uint32_t key, const Variant& value);
+	void                       set_property_at (uint32_t key, const Variant& value, sampleoffset_t when);
+	bool                       timestamped_properties () const { return _patch_port_in_index != (uint32_t)-1; }
+	void                       drop_timed_properties ();
 	const PropertyDescriptors& get_supported_properties (bool readonly) const {
 		return readonly ? _ro_property_descriptors : _property_descriptors;
 	}
@@ -322,6 +325,18 @@ class LIBARDOUR_API LV2Plugin : public ARDOUR::Plugin, public ARDOUR::Workee
 	PBD::RingBuffer<uint8_t>* _to_ui;
 	PBD::RingBuffer<uint8_t>* _from_ui;
 
+	/// patch:Set messages queued by set_property_at (), process thread only
+	struct TimedProperty {
+		uint32_t time;
+		uint32_t offset;
+	};
+
+	std::vector<TimedProperty> _timed_properties; // sorted by time
+	std::vector<uint8_t>       _timed_property_atoms;
+	size_t                     _timed_property_pos;  // next one to write
+
+	void write_timed_properties (uint32_t until, pframes_t nframes);
+
 	PBD::Mutex _work_mutex;
 
 	PBD::Mutex                   _slave_lock;
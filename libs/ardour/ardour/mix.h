@@ -49,9 +49,17 @@ extern "C" {
 LIBARDOUR_API void x86_sse_avx_find_peaks               (float const* buf, uint32_t nsamples, float* min, float* max);
 #endif
 
+/* AVX curve interpolation, see Evoral::Curve */
+LIBARDOUR_API void  x86_avx_linear_ramp                 (float* dst, uint32_t nframes, double start, double step);
+LIBARDOUR_API void  x86_avx_exp2_ramp                   (float* dst, uint32_t nframes, double start, double step);
+LIBARDOUR_API void  x86_avx_gain_ramp                   (float* dst, uint32_t nframes, double start, double step, double scale);
+
 /* FMA functions */
 #ifdef FPU_AVX_FMA_SUPPORT
 LIBARDOUR_API void  x86_fma_mix_buffers_with_gain       (float* dst, float const* src, uint32_t nframes, float gain);
+LIBARDOUR_API void  x86_fma_linear_ramp                 (float* dst, uint32_t nframes, double start, double step);
+LIBARDOUR_API void  x86_fma_exp2_ramp                   (float* dst, uint32_t nframes, double start, double step);
+LIBARDOUR_API void  x86_fma_gain_ramp                   (float* dst, uint32_t nframes, double start, double step, double scale);
 #endif
 
 /* AVX512F functions */
@@ -62,6 +70,9 @@ LIBARDOUR_API void  x86_avx512f_mix_buffers_with_gain   (float* dst, float const
 LIBARDOUR_API void  x86_avx512f_mix_buffers_no_gain     (float* dst, float const* src, uint32_t nframes);
 LIBARDOUR_API void  x86_avx512f_copy_vector             (float* dst, float const* src, uint32_t nframes);
 LIBARDOUR_API void  x86_avx512f_find_peaks              (float const* buf, uint32_t nsamples, float* min, float* max);
+LIBARDOUR_API void  x86_avx512f_linear_ramp             (float* dst, uint32_t nframes, double start, double step);
+LIBARDOUR_API void  x86_avx512f_exp2_ramp               (float* dst, uint32_t nframes, double start, double step);
+LIBARDOUR_API void  x86_avx512f_gain_ramp               (float* dst, uint32_t nframes, double start, double step, double scale);
 #endif
 
 /* debug wrappers for SSE functions */
@@ -94,6 +105,13 @@ extern "C" {
 	LIBARDOUR_API void  arm_neon_mix_buffers_no_gain   (float* dst, float const* src, uint32_t nframes);
 	LIBARDOUR_API void  arm_neon_mix_buffers_with_gain (float* dst, float const* src, uint32_t nframes, float gain);
 }
+
+#ifdef __aarch64__
+/* NEON curve interpolation, see Evoral::Curve */
+LIBARDOUR_API void  arm_neon_linear_ramp               (float* dst, uint32_t nframes, double start, double step);
+LIBARDOUR_API void  arm_neon_exp2_ramp                 (float* dst, uint32_t nframes, double start, double step);
+LIBARDOUR_API void  arm_neon_gain_ramp                 (float* dst, uint32_t nframes, double start, double step, double scale);
+#endif
 #endif
 
 /* non-optimized functions */
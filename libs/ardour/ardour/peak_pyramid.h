@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace ARDOUR {
+
+/** Multi-resolution peak data, derived from a complete peakfile.
+ *
+ * Each level of the pyramid combines `factor` peaks of the level
+ * below it, the first level combines `factor` peaks of the peakfile.
+ * Zoomed out views can use the level closest to the requested
+ * resolution, and only need to read a few pages of data, regardless
+ * of the length of the source.
+ *
+ * File layout, native byte-order:
+ *   Header, Level[n_levels], PeakData[] for each level.
+ */
+class LIBARDOUR_API PeakPyramid
+{
+public:
+	PeakPyramid ();
+	~PeakPyramid ();
+
+	static const uint32_t version = 1;
+	static const uint32_t factor  = 4;
+
+	/** Write a pyramid file.
+	 * @param peakfile complete peakfile to read
+	 * @param path file to write
+	 * @param fpp samples per peak of the peakfile
+	 * @param length length of the source in samples
+	 * @return 0 on success
+	 */
+	static int build (std::string const& peakfile, std::string const& path, samplecnt_t fpp, samplecnt_t length);
+
+	/** Map an existing pyramid file.
+	 * @return 0 on success, -1 if the file does not exist or was not
+	 * built from the given peakfile.
+	 */
+	int  load (std::string const& path, std::string const& peakfile, samplecnt_t fpp, samplecnt_t length);
+	void unload ();
+
+	bool valid () const { return _header != 0; }
+
+	/** @return samples per peak of the level that read () would use, or 0 */
+	samplecnt_t level_fpp (double samples_per_visual_peak) const;
+
+	/** Compute peaks from the closest level that has at least the requested resolution.
+	 * @return false if no level has a suitable resolution.
+	 */
+	bool read (PeakData* peaks, samplecnt_t npeaks, samplepos_t start, samplecnt_t cnt, double samples_per_visual_peak) const;
+
+private:
+	struct Header {
+		char     magic[8];
+		uint32_t version;
+		uint32_t factor;
+		int64_t  base_fpp;
+		int64_t  base_size; ///< size of the peakfile in bytes
+		int64_t  length;
+		uint32_t n_levels;
+		uint32_t reserved;
+	};
+
+	struct Level {
+		int64_t fpp;
+		int64_t offset;
+		int64_t n_peaks;
+	};
+
+	Level const* level (double samples_per_visual_peak) const;
+
+	static const char magic[8];
+
+	char*         _data;
+	size_t        _size;
+	Header const* _header;
+	Level const*  _levels;
+};
+
+} // namespace ARDOUR
@@ -39,6 +39,7 @@
 
 #include <glib.h>
 
+#include "pbd/mutex.h"
 #include "pbd/rwlock.h"
 #include "pbd/sequence_property.h"
 #include "pbd/stateful.h"
@@ -325,6 +326,7 @@ protected:
 		    , playlist (pl)
 		    , block_notify (do_block_notify)
 		{
+			playlist->_region_index_writer.store (true);
 			if (block_notify) {
 				playlist->delay_notifications ();
 			}
@@ -332,6 +334,8 @@ protected:
 
 		~RegionWriteLock ()
 		{
+			playlist->_region_index_writer.store (false);
+			playlist->invalidate_region_index ();
 			PBD::RWLock::WriterLock::release ();
 			thawlist.release ();
 			if (block_notify) {
@@ -403,6 +407,20 @@ protected:
 
 	std::shared_ptr<RegionList> regions_touched_locked (timepos_t const & start, timepos_t const & end, bool with_tail);
 
+	/** Like regions_touched_locked (), but fills in the given vector, which is
+	 * cleared first and does not need to allocate once it has grown enough.
+	 * Regions are in order of position. Caller must hold the region lock.
+	 */
+	void regions_touched_locked (timepos_t const & start, timepos_t const & end, bool with_tail, RegionVector&);
+
+	/** Mark data derived from the region list and the bounds of regions as
+	 * out of date. This drops the index' references to regions.
+	 */
+	void invalidate_region_index ();
+
+	/** @return a counter that changes whenever invalidate_region_index () is called */
+	uint64_t region_generation () const { return _region_generation.load (); }
+
 	bool region_is_audible_at_locked (std::shared_ptr<Region>, timepos_t const&);
 	bool region_is_audible_at_internal (std::shared_ptr<RegionList> const&, std::shared_ptr<Region>, timepos_t const&);
 
@@ -475,6 +493,35 @@ private:
 	void coalesce_and_check_crossfades (std::list<Temporal::TimeRange>);
 	std::shared_ptr<RegionList> find_regions_at (timepos_t const &);
 
+	/* Regions sorted by position, with the maximum end (including the tail)
+	 * of all regions up to and including each one, so that the regions
+	 * touching a range can be found by binary search.
+	 *
+	 * The index is cleared when the region list was modified (under the
+	 * write lock) or a region's bounds changed, and rebuilt on demand.
+	 * While the write lock is held, queries use a linear walk of the
+	 * region list.
+	 */
+	struct RegionIndexEntry {
+		RegionIndexEntry (std::shared_ptr<Region> const & r, timepos_t const & s, timepos_t const & e)
+			: region (r), start (s), end (e), max_end (e) {}
+
+		std::shared_ptr<Region> region;
+		timepos_t               start;
+		timepos_t               end;
+		timepos_t               max_end;
+	};
+
+	template<typename Predicate> void find_regions (timepos_t const & start, timepos_t const & end, Predicate, RegionVector&);
+
+	void rebuild_region_index ();
+
+	std::vector<RegionIndexEntry> _region_index;
+	PBD::Mutex                    _region_index_lock;
+	std::atomic<bool>             _region_index_dirty;
+	std::atomic<bool>             _region_index_writer; // a RegionWriteLock is held
+	std::atomic<uint64_t>         _region_generation;
+
 	mutable std::optional<std::pair<timepos_t, timepos_t> > _cached_extent;
 	timepos_t _end_space;  //this is used when we are pasting a range with extra space at the end
 	bool _playlist_shift_active;
@@ -103,6 +103,11 @@ public:
 		void           catch_up_with_external_value (double val);
 		XMLNode&       get_state () const;
 
+		/** Set the value from automation playback, the plugin(s) apply
+		 * it at sample offset @a when of the next run (process thread only).
+		 */
+		void           set_value_at (double val, sampleoffset_t when);
+
 	protected:
 		virtual void    actually_set_value (double value, PBD::Controllable::GroupControlDisposition);
 		PlugInsertBase* _pib;
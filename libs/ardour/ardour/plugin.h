@@ -365,6 +365,30 @@ public:
 	 */
 	virtual void set_property (uint32_t key, const Variant& value) {}
 
+	/** Set a property from the process thread, at sample offset @a when of
+	 * the next run. This is used for property automation.
+	 *
+	 * @see timestamped_properties
+	 */
+	virtual void set_property_at (uint32_t key, const Variant& value, sampleoffset_t /*when*/)
+	{
+		set_property (key, value);
+	}
+
+	/** @return true if set_parameter () applies a change at its sample offset
+	 * during the next run. Automation of this plugin's parameters can then be
+	 * passed as timestamped events, instead of splitting the cycle.
+	 */
+	virtual bool timestamped_parameters () const { return false; }
+
+	/** @return true if set_property_at () honors the sample offset */
+	virtual bool timestamped_properties () const { return false; }
+
+	/** Discard changes queued by set_property_at () that were not applied,
+	 * because the plugin did not run.
+	 */
+	virtual void drop_timed_properties () {}
+
 	virtual Variant get_property_value (uint32_t) const
 	{
 		return Variant();
@@ -50,6 +50,7 @@ namespace ARDOUR {
 class Session;
 class Route;
 class Plugin;
+class RTSubtasks;
 
 /** Plugin inserts: send data through a plugin
  */
@@ -358,6 +359,8 @@ private:
 	ChanMapping _thru_map; // out-idx <=  in-idx
 
 	void automate_and_run (BufferSet& bufs, samplepos_t start, samplepos_t end, double speed, pframes_t nframes);
+	bool automation_splits_cycle () const;
+	bool timestamped_automation (Evoral::Parameter const&) const;
 	void connect_and_run (BufferSet& bufs, samplepos_t start, samplecnt_t end, double speed, pframes_t nframes, samplecnt_t offset, bool with_auto);
 	void bypass (BufferSet& bufs, pframes_t nframes);
 	void inplace_silence_unconnected (BufferSet&, const PinMappings&, samplecnt_t nframes, samplecnt_t offset) const;
@@ -392,6 +395,33 @@ private:
 	PBD::TimingStats  _timing_stats;
 	std::atomic<int> _stat_reset;
 	std::atomic<int> _flush;
+
+	/* replicated instances that only use their own buffers can be run
+	 * concurrently on idle process threads, when they are expensive
+	 * enough (see Config->get_parallel_plugin_instance_threshold)
+	 */
+	struct InstanceRun {
+		BufferSet*         bufs;
+		samplepos_t        start;
+		samplepos_t        end;
+		double             speed;
+		pframes_t          nframes;
+		samplecnt_t        offset;
+		PinMappings const* in_map;
+		PinMappings const* out_map;
+	};
+
+	bool check_parallel () const;
+	void setup_subtasks ();
+	void run_instance (uint32_t);
+
+	bool                        _parallel_ok;
+	bool                        _run_parallel;
+	float                       _instance_cost; ///< average usec per instance and cycle
+	InstanceRun                 _instance_run;
+	std::atomic<int64_t>        _instance_time;
+	std::atomic<int>            _instance_failed;
+	std::unique_ptr<RTSubtasks> _subtasks;
 };
 
 } // namespace ARDOUR
@@ -89,6 +89,18 @@ class LIBARDOUR_API BackendPort : public ProtoPort
 		return _connections;
 	}
 
+	typedef std::vector<BackendPort*> PortList;
+
+	/** Connected ports, for use in the process callback.
+	 *
+	 * A flat copy of get_connections () which is published (RCU) whenever
+	 * connections change, so it remains valid while ports are connected
+	 * or disconnected concurrently.
+	 */
+	std::shared_ptr<PortList const> rt_connections () const {
+		return _rt_connections.reader ();
+	}
+
 	int  connect (BackendPortHandle port, BackendPortHandle self);
 	int  disconnect (BackendPortHandle port, BackendPortHandle self);
 	void disconnect_all (BackendPortHandle self);
@@ -116,8 +128,11 @@ private:
 	LatencyRange           _playback_latency_range;
 	std::set<BackendPortPtr> _connections;
 
+	SerializedRCUManager<PortList> _rt_connections;
+
 	void store_connection (BackendPortHandle);
 	void remove_connection (BackendPortHandle);
+	void update_rt_connections ();
 
 }; // class BackendPort
 
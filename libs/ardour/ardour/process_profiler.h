@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <map>
+
+#include "pbd/id.h"
+#include "pbd/microseconds.h"
+#include "pbd/mutex.h"
+#include "pbd/pthread_utils.h"
+#include "pbd/ringbuffer.h"
+
+#include "ardour/libardour_visibility.h"
+
+namespace ARDOUR
+{
+
+/** Opt-in, realtime-safe profiler for process-graph nodes and processors.
+ *
+ * Process threads record start/end timestamps of Route, IOPlug and
+ * Processor::run invocations into per-thread lock-free ringbuffers.
+ * A background thread collects the samples into per-object histograms,
+ * which can be queried by object ID.
+ */
+class LIBARDOUR_API ProcessProfiler
+{
+public:
+	static void set_enabled (bool);
+	static bool enabled () { return _enabled.load (std::memory_order_relaxed); }
+
+	/** Record the time span of an object's process call. realtime-safe */
+	static void record (PBD::ID const&, PBD::microseconds_t start, PBD::microseconds_t end);
+
+	/** Query statistics, values are in microseconds.
+	 * @return false if no data is available for the given object
+	 */
+	static bool get_stats (PBD::ID const&, PBD::microseconds_t& min, PBD::microseconds_t& max, double& avg, PBD::microseconds_t& p99);
+
+	/** @return the number of samples that could not be recorded */
+	static uint64_t dropped () { return _dropped.load (); }
+
+	static void reset ();
+
+	/** Drop the statistics of an object that is going away */
+	static void forget (PBD::ID const&);
+
+	/** Time the lifetime of this object, if profiling is enabled */
+	class Scope
+	{
+	public:
+		Scope (PBD::ID const& id)
+			: _id (id)
+			, _start (enabled () ? PBD::get_microseconds () : 0)
+		{}
+
+		~Scope ()
+		{
+			if (_start > 0) {
+				record (_id, _start, PBD::get_microseconds ());
+			}
+		}
+
+	private:
+		PBD::ID const&      _id;
+		PBD::microseconds_t _start;
+	};
+
+private:
+	struct Sample {
+		Sample () : id ((uint64_t)0), start (0), end (0) {}
+		Sample (PBD::ID const& i, PBD::microseconds_t s, PBD::microseconds_t e) : id (i), start (s), end (e) {}
+		PBD::ID             id;
+		PBD::microseconds_t start;
+		PBD::microseconds_t end;
+	};
+
+	class Histogram
+	{
+	public:
+		Histogram ();
+		void add (PBD::microseconds_t);
+		bool get_stats (PBD::microseconds_t& min, PBD::microseconds_t& max, double& avg, PBD::microseconds_t& p99) const;
+
+		static const size_t n_bins = 256;
+
+	private:
+		static size_t              bin (PBD::microseconds_t);
+		static PBD::microseconds_t bin_upper (size_t);
+
+		uint64_t            _cnt;
+		PBD::microseconds_t _min;
+		PBD::microseconds_t _max;
+		double              _sum;
+		uint32_t            _bins[n_bins];
+	};
+
+	friend struct ProcessProfilerThreadClaim;
+
+	struct ThreadBuffer {
+		ThreadBuffer () : rb (8192) { in_use.store (0); }
+		PBD::RingBuffer<Sample> rb;
+		std::atomic<int>        in_use;
+	};
+
+	static ThreadBuffer* thread_buffer ();
+	static void          collect ();
+	static void          thread ();
+
+	static const size_t          n_thread_buffers = 32;
+	static ThreadBuffer*         _buffers;
+	static std::atomic<bool>     _enabled;
+	static std::atomic<uint64_t> _dropped;
+	static PBD::Thread*          _thread;
+	static std::atomic<bool>     _run_thread;
+	static PBD::Mutex            _lock;
+
+	static std::map<PBD::ID, Histogram> _histograms;
+};
+
+} // namespace ARDOUR
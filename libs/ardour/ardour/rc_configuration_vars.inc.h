@@ -103,6 +103,8 @@ CONFIG_VARIABLE (float, audio_capture_buffer_seconds, "capture-buffer-seconds",
 CONFIG_VARIABLE (float, audio_playback_buffer_seconds, "playback-buffer-seconds", 5.0)
 CONFIG_VARIABLE (float, midi_track_buffer_seconds, "midi-track-buffer-seconds", 1.0)
 CONFIG_VARIABLE (uint32_t, disk_choice_space_threshold,  "disk-choice-space-threshold", 57600000)
+CONFIG_VARIABLE (bool, disk_readahead_hints, "disk-readahead-hints", false)
+CONFIG_VARIABLE (bool, mmap_audio_sources, "mmap-audio-sources", false)
 CONFIG_VARIABLE (bool, auto_analyse_audio, "auto-analyse-audio", false)
 CONFIG_VARIABLE (float, transient_sensitivity, "transient-sensitivity", 50)
 CONFIG_VARIABLE (float, max_transport_speed, "max-transport-speed", 2.0)
@@ -208,6 +210,7 @@ CONFIG_VARIABLE (bool, verify_remove_last_capture, "verify-remove-last-capture",
 CONFIG_VARIABLE (bool, save_history, "save-history", true)
 CONFIG_VARIABLE (int32_t, saved_history_depth, "save-history-depth", 20)
 CONFIG_VARIABLE (int32_t, history_depth, "history-depth", 20)
+CONFIG_VARIABLE (uint32_t, history_memory_budget, "history-memory-budget", 256) /* MB, 0: unlimited */
 CONFIG_VARIABLE (RegionEquivalence, region_equivalence, "region-equivalency", LayerTime)
 CONFIG_VARIABLE (bool, periodic_safety_backups, "periodic-safety-backups", true)
 CONFIG_VARIABLE (uint32_t, periodic_safety_backup_interval, "periodic-safety-backup-interval", 120)
@@ -223,6 +226,9 @@ CONFIG_VARIABLE (std::string, clip_library_dir, "clip-library-dir", "@default@")
 CONFIG_VARIABLE (std::string, sample_lib_path, "sample-lib-path", "") /* custom paths */
 CONFIG_VARIABLE (bool, allow_special_bus_removal, "allow-special-bus-removal", false)
 CONFIG_VARIABLE (int32_t, processor_usage, "processor-usage", -1)
+CONFIG_VARIABLE (bool, graph_work_stealing, "graph-work-stealing", false)
+CONFIG_VARIABLE (uint32_t, parallel_plugin_instance_threshold, "parallel-plugin-instance-threshold", 0) /* usec, 0: off */
+CONFIG_VARIABLE (bool, concurrent_route_processors, "concurrent-route-processors", false)
 CONFIG_VARIABLE (int32_t, cpu_dma_latency, "cpu-dma-latency", -1) /* >=0 to enable */
 CONFIG_VARIABLE (int32_t, io_thread_count, "io-thread-count", -2)
 CONFIG_VARIABLE (int32_t, io_thread_policy, "io-thread-policy", 0)
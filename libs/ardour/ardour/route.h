@@ -86,6 +86,7 @@ class PortSet;
 class Processor;
 class PluginInsert;
 class RouteGroup;
+class RTSubtasks;
 class Send;
 class InternalReturn;
 class Location;
@@ -822,6 +823,31 @@ private:
 
 	RoutePinWindowProxy*   _pinmgr_proxy;
 	PatchChangeGridDialog* _patch_selector_dialog;
+
+	/* Consecutive processors that only read the route's buffers (sends,
+	 * meters) do not depend on each other and can run concurrently.
+	 * The groups are found when processors are configured, and used by
+	 * process_output_buffers() if Config->get_concurrent_route_processors().
+	 */
+	struct ConcurrentRun {
+		Processor*  proc;
+		samplepos_t start;
+		samplepos_t end;
+		double      speed;
+		bool        result_required;
+	};
+
+	static bool can_run_concurrently (std::shared_ptr<Processor> const&);
+	void   setup_concurrent_processors ();
+	size_t prepare_concurrent_run (std::pair<size_t, size_t> const&, ProcessorList::const_iterator, samplepos_t start_sample, samplepos_t end_sample, int speed, samplecnt_t& latency);
+	void   run_concurrent_processor (uint32_t);
+
+	std::vector<Processor*>                _concurrent_procs;  ///< members of all groups, in processor order
+	std::vector<std::pair<size_t, size_t>> _concurrent_groups; ///< offset, length in _concurrent_procs
+	std::vector<ConcurrentRun>             _concurrent_run;
+	BufferSet*                             _concurrent_bufs;
+	pframes_t                              _concurrent_nframes;
+	std::unique_ptr<RTSubtasks>            _concurrent_tasks;
 };
 
 } // namespace ARDOUR
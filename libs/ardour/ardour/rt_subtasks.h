@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "ardour/graphnode.h"
+#include "ardour/libardour_visibility.h"
+
+namespace ARDOUR
+{
+class Graph;
+
+/** Fork/join of small tasks from inside a process-graph node.
+ *
+ * Unlike RTTaskList, which runs a task-list while the graph is idle,
+ * this is used while a graph cycle is in progress, e.g. by a route
+ * that is being processed. The calling thread runs tasks itself and
+ * hands out the remaining ones to process threads that are idle at
+ * the time. It never runs unrelated graph nodes, so the thread-local
+ * buffers of the caller remain untouched.
+ */
+class LIBARDOUR_API RTSubtasks
+{
+public:
+	/** @param fn called with the index of the task to run
+	 *  @param max_helpers the maximum number of other threads to use
+	 */
+	RTSubtasks (std::shared_ptr<Graph>, std::function<void (uint32_t)> const& fn, uint32_t max_helpers);
+	~RTSubtasks ();
+
+	/** Call fn (0) .. fn (n - 1) and return when all calls completed.
+	 * Tasks may run concurrently and in any order. When not called
+	 * from a process graph thread the tasks are run in sequence.
+	 */
+	void process (uint32_t n);
+
+	/** @return the maximum number of other threads that are used */
+	uint32_t max_helpers () const { return _helpers.size (); }
+
+private:
+	friend class Graph;
+
+	class Helper : public ProcessNode
+	{
+	public:
+		enum State {
+			Idle,
+			Queued,
+			Running,
+			Cancelled, ///< still queued, will be ignored
+		};
+
+		Helper (RTSubtasks& o)
+			: _owner (o)
+			, _state (Idle)
+		{}
+
+		void prep (GraphChain const*) {}
+		void run (GraphChain const*);
+
+	private:
+		friend class Graph;
+		friend class RTSubtasks;
+		RTSubtasks&        _owner;
+		std::atomic<int>   _state;
+	};
+
+	void run_tasks ();
+
+	std::function<void (uint32_t)> _f;
+	std::shared_ptr<Graph>         _graph;
+	std::vector<Helper*>           _helpers;
+	std::atomic<uint32_t>          _next;
+	uint32_t                       _n_tasks;
+};
+
+} // namespace ARDOUR
@@ -90,6 +90,11 @@ public:
 
 	void run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_sample, double speed, pframes_t nframes, bool);
 
+	/** @return true if run() writes to the buffers it is given,
+	 * which is the case while the thru signal is delayed
+	 */
+	bool modifies_input () const { return !_thru_delay->idle (); }
+
 	bool can_support_io_configuration (const ChanCount& in, ChanCount& out);
 	bool configure_io (ChanCount in, ChanCount out);
 
@@ -55,6 +55,7 @@
 #include "pbd/event_loop.h"
 #include "pbd/file_archive.h"
 #include "pbd/history_owner.h"
+#include "pbd/microseconds.h"
 #include "pbd/mpmc_queue.h"
 #include "pbd/mutex.h"
 #include "pbd/rcu.h"
@@ -115,6 +116,7 @@ namespace PBD {
 class Controllable;
 class Progress;
 class Command;
+class Thread;
 }
 
 namespace luabridge {
@@ -339,6 +341,7 @@ public:
 	}
 
 	std::shared_ptr<RTTaskList> rt_tasklist () { return _rt_tasklist; }
+	std::shared_ptr<Graph>      process_graph () const { return _process_graph; }
 	std::shared_ptr<IOTaskList> io_tasklist () { return _io_tasklist; }
 
 	RouteList get_routelist (bool mixer_order = false, PresentationInfo::Flag fl = PresentationInfo::MixerRoutes) const;
@@ -625,6 +628,17 @@ public:
 	                bool for_archive = false,
 	                bool only_used_assets = false);
 
+	/** save a pending (recovery) state without blocking the caller.
+	 *
+	 * The session state is captured in the calling thread, the file is
+	 * written, synced to disk and renamed into place by a background thread,
+	 * which emits PendingStateSaved when done. A save that is superseded
+	 * by a later save_state() before it was written is discarded.
+	 *
+	 * @return zero if the save was started
+	 */
+	int save_pending_state_async ();
+
 	enum ArchiveEncode {
 		NO_ENCODE,
 		FLAC_16BIT,
@@ -654,6 +668,13 @@ public:
 	PBD::Signal<void(std::string)> StateSaved;
 	PBD::Signal<void()> StateReady;
 
+	/** emitted from the save thread when save_pending_state_async() finished, zero on success */
+	PBD::Signal<void(int)> PendingStateSaved;
+
+	/** Time spent in each phase of the last set_state(), in order */
+	typedef std::vector<std::pair<std::string, PBD::microseconds_t> > LoadTimings;
+	LoadTimings const & load_timings () const { return _load_timings; }
+
 	/* emitted when session needs to be saved due to some internal
 	 * event or condition (i.e. not in response to a user request).
 	 *
@@ -1668,6 +1689,18 @@ private:
 	PBD::Mutex save_source_lock;
 	PBD::Mutex peak_cleanup_lock;
 
+	struct AsyncSave;
+
+	uint32_t         _save_generation; // protected by save_state_lock
+	PBD::Thread*     _async_save_thread;
+	std::atomic<int> _async_save_running;
+	std::atomic<int> _async_save_result;
+
+	int  write_state_file (XMLTree&, std::string const& tmp_path, std::string const& xml_path, bool sync);
+	void make_safety_backup (std::string const& xml_path);
+	void async_save_thread (AsyncSave*);
+	void join_async_save ();
+
 	int        load_options (const XMLNode&);
 	int        load_state (std::string snapshot_name, bool from_template = false);
 	static int parse_stateful_loading_version (const std::string&);
@@ -2102,8 +2135,11 @@ private:
 	SourceMap sources;
 
 	int load_sources (const XMLNode& node);
+	void preload_sources (const XMLNodeList&, std::vector<std::shared_ptr<Source> >&);
 	XMLNode& get_sources_as_xml ();
 
+	LoadTimings _load_timings;
+
 	std::shared_ptr<Source> XMLSourceFactory (const XMLNode&);
 
 	/* PLAYLISTS */
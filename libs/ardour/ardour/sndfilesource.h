@@ -24,6 +24,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include <sndfile.h>
 
 #include "ardour/audiofilesource.h"
@@ -84,6 +86,8 @@ class LIBARDOUR_API SndFileSource : public AudioFileSource {
 
 	samplecnt_t read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) const;
 	samplecnt_t write_unlocked (Sample const * dst, samplecnt_t cnt);
+	void prefetch_unlocked (samplepos_t start, samplecnt_t cnt) const;
+	samplecnt_t read_mapped (Sample *dst, samplepos_t start, samplecnt_t cnt) const;
 	samplecnt_t write_float (Sample const * data, samplepos_t pos, samplecnt_t cnt);
 
   private:
@@ -91,6 +95,28 @@ class LIBARDOUR_API SndFileSource : public AudioFileSource {
 	SF_INFO _info;
 	BroadcastInfo *_broadcast_info;
 
+	/* file descriptor and layout of uncompressed PCM data, used for
+	 * read-ahead hints. _data_offset < 0 if unknown or compressed.
+	 */
+	int   _fd;
+	off_t _data_offset;
+	int   _bytes_per_sample;
+
+	/* optional read-only memory-map of the file, _map_data points
+	 * to the first sample.
+	 */
+	void*                       _map_base;
+	size_t                      _map_size;
+	uint8_t const*              _map_data;
+
+	/* start of the previous read_mapped(), only used to guess the
+	 * direction of the next read. Concurrent readers may interleave.
+	 */
+	mutable std::atomic<samplepos_t> _map_last_read;
+
+	void map_data ();
+	void advise_mapped (samplepos_t start, samplecnt_t cnt) const;
+
 	void init_sndfile ();
 	int open();
 	int setup_broadcast_info (samplepos_t when, struct tm&, time_t);
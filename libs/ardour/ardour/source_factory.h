@@ -44,7 +44,7 @@ public:
 
 	static PBD::Signal<void(std::shared_ptr<Source>)> SourceCreated;
 
-	static std::shared_ptr<Source> create (Session&, const XMLNode& node, bool async = false);
+	static std::shared_ptr<Source> create (Session&, const XMLNode& node, bool async = false, bool announce = true);
 	static std::shared_ptr<Source> createSilent (Session&, const XMLNode& node, samplecnt_t, float sample_rate);
 	static std::shared_ptr<Source> createExternal (DataType, Session&, const std::string& path, int chn, Source::Flag, bool announce = true, bool async = false);
 	static std::shared_ptr<Source> createWritable (DataType, Session&, const std::string& path, samplecnt_t rate, bool announce = true, bool async = false);
@@ -61,6 +61,21 @@ public:
 
 	static int peak_work_queue_length ();
 	static int setup_peakfile (std::shared_ptr<Source>, bool async);
+
+	/** Move a source that is waiting for its peakfile to the front of the
+	 * queue, e.g. because it is visible.
+	 */
+	static void prioritize_peakfile (std::shared_ptr<AudioSource>);
+
+	/** Remove a source from the queue, or stop building its peakfile.
+	 * PeaksReady is not emitted, this is meant for sources that are removed.
+	 */
+	static void cancel_peakfile (std::shared_ptr<AudioSource>);
+
+	/** Cancel all queued and pending peakfile builds (session teardown,
+	 * or before peakfiles are cleaned up and queued again).
+	 */
+	static void cancel_peak_building ();
 };
 
 } // namespace ARDOUR
@@ -149,7 +149,13 @@ public:
 	void reset_write_sources (bool mark_write_complete);
 	float playback_buffer_load () const;
 	float capture_buffer_load () const;
+	samplecnt_t playback_underrun_margin () const;
+	samplecnt_t playback_refill_space () const;
+	void record_playback_underrun_margin (samplecnt_t);
+	bool get_playback_margin_stats (samplecnt_t& min, double& avg, uint32_t& n_underruns) const;
+	void reset_playback_margin_stats ();
 	int do_refill ();
+	void do_prefetch ();
 	int do_flush (RunContext, bool force = false);
 	void set_pending_overwrite (OverwriteReason);
 	int seek (samplepos_t, bool complete_refill = false);
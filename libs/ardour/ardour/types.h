@@ -114,6 +114,7 @@ typedef std::list<std::pair<sampleoffset_t, sampleoffset_t> > AudioIntervalResul
 typedef std::map<std::shared_ptr<ARDOUR::Region>,AudioIntervalResult> AudioIntervalMap;
 
 typedef std::list<std::shared_ptr<Region> > RegionList;
+typedef std::vector<std::shared_ptr<Region> > RegionVector;
 typedef std::set<std::shared_ptr<Playlist> > PlaylistSet;
 typedef std::list<std::shared_ptr<RouteGroup>> RouteGroupList;
 	
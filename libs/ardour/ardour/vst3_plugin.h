@@ -397,6 +397,7 @@ public:
 	float    default_value (uint32_t port);
 	void     set_parameter (uint32_t port, float val, sampleoffset_t when);
 	float    get_parameter (uint32_t port) const;
+	bool     timestamped_parameters () const { return true; }
 	int      get_parameter_descriptor (uint32_t which, ParameterDescriptor&) const;
 	uint32_t nth_parameter (uint32_t port, bool& ok) const;
 	bool     print_parameter (uint32_t, std::string&) const;
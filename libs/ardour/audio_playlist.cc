@@ -22,6 +22,8 @@
  */
 
 #include <algorithm>
+#include <limits>
+#include <map>
 
 #include <cstdlib>
 
@@ -50,6 +52,8 @@ AudioPlaylist::AudioPlaylist (Session& session, const XMLNode& node, bool hidden
 	assert(!prop || DataType(prop->value()) == DataType::AUDIO);
 #endif
 
+	setup_read_plan ();
+
 	in_set_state++;
 	if (set_state (node, Stateful::loading_state_version)) {
 		throw failed_constructor();
@@ -64,16 +68,20 @@ AudioPlaylist::AudioPlaylist (Session& session, const XMLNode& node, bool hidden
 AudioPlaylist::AudioPlaylist (Session& session, string name, bool hidden)
 	: Playlist (session, name, DataType::AUDIO, hidden)
 {
+	setup_read_plan ();
 }
 
 AudioPlaylist::AudioPlaylist (std::shared_ptr<const AudioPlaylist> other, string name, bool hidden)
 	: Playlist (other, name, hidden)
 {
+	setup_read_plan ();
 }
 
 AudioPlaylist::AudioPlaylist (std::shared_ptr<const AudioPlaylist> other, timepos_t const & start, timepos_t const & cnt, string name, bool hidden)
 	: Playlist (other, start, cnt, name, hidden)
 {
+	setup_read_plan ();
+
 	RegionReadLock rlock2 (const_cast<AudioPlaylist*> (other.get()));
 	in_set_state++;
 
@@ -152,7 +160,7 @@ AudioPlaylist::AudioPlaylist (std::shared_ptr<const AudioPlaylist> other, timepo
 
 /** Sort by descending layer and then by ascending position */
 struct ReadSorter {
-    bool operator() (std::shared_ptr<Region> a, std::shared_ptr<Region> b) {
+    bool operator() (std::shared_ptr<Region> const & a, std::shared_ptr<Region> const & b) const {
 	    if (a->layer() != b->layer()) {
 		    return a->layer() > b->layer();
 	    }
@@ -161,13 +169,172 @@ struct ReadSorter {
     }
 };
 
-/** A segment of region that needs to be read */
-struct Segment {
-	Segment (std::shared_ptr<AudioRegion> r, Temporal::Range a) : region (r), range (a) {}
+/** Add the range @p start .. @p end to a set of non-overlapping ranges */
+static void
+add_range (std::map<samplepos_t, samplepos_t>& ranges, samplepos_t start, samplepos_t end)
+{
+	std::map<samplepos_t, samplepos_t>::iterator i = ranges.upper_bound (start);
+
+	if (i != ranges.begin ()) {
+		std::map<samplepos_t, samplepos_t>::iterator p = std::prev (i);
+		if (p->second >= start) {
+			start = p->first;
+			end   = max (end, p->second);
+			i     = p;
+		}
+	}
+
+	while (i != ranges.end () && i->first <= end) {
+		end = max (end, i->second);
+		i   = ranges.erase (i);
+	}
 
-	std::shared_ptr<AudioRegion> region; ///< the region
-	Temporal::Range range;       ///< range of the region to read, in session samples
-};
+	ranges[start] = end;
+}
+
+/** Work out which parts of the given regions need to be read for the
+ *  range @p start .. @p end (exclusive), in session samples.
+ *
+ *  @param sorted regions, sorted by descending layer and ascending position.
+ *  @param segs segments are appended in the reverse of the order in which
+ *  they need to be read.
+ */
+void
+AudioPlaylist::plan_segments (RegionVector const & sorted, samplepos_t start, samplepos_t end, bool solo_selection, std::vector<ReadSegment>& segs)
+{
+	/* This will be a set of the bits of our read range that we have
+	   handled completely (ie for which no more regions need to be read),
+	   mapping start to end.
+	*/
+	std::map<samplepos_t, samplepos_t> done;
+
+	std::vector<std::pair<samplepos_t, samplepos_t> > region_to_do;
+
+	for (auto const & r : sorted) {
+		AudioRegion* ar = dynamic_cast<AudioRegion*> (r.get ());
+
+		/* muted regions don't figure into it at all */
+		if (!ar || ar->muted()) {
+			continue;
+		}
+
+		/* check for the case of solo_selection */
+		if (solo_selection && !SoloSelectedListIncludes (ar)) {
+			continue;
+		}
+
+		samplepos_t const position = ar->position_sample ();
+		samplecnt_t const length   = ar->length_samples ();
+		samplecnt_t const tail     = ar->tail ().samples ();
+
+		/* Work out which bits of this region need to be read;
+		   first, trim to the range we are reading...
+		*/
+		samplepos_t       pos = max (position, start);
+		samplepos_t const lim = min (position + length + tail, end);
+
+		/* ... and then remove the bits that are already done */
+		region_to_do.clear ();
+
+		std::map<samplepos_t, samplepos_t>::const_iterator i = done.upper_bound (pos);
+
+		if (i != done.begin () && std::prev (i)->second > pos) {
+			--i;
+		}
+
+		while (pos < lim) {
+			if (i != done.end () && i->first <= pos) {
+				pos = i->second;
+				++i;
+				continue;
+			}
+			samplepos_t const e = (i != done.end () && i->first < lim) ? i->first : lim;
+			region_to_do.push_back (std::make_pair (pos, e));
+			pos = e;
+		}
+
+		/* Make a note to read those bits, adding their bodies (the parts between end-of-fade-in
+		   and start-of-fade-out) to the `done' list.
+		*/
+
+		Temporal::Range const body   = ar->body_range ();
+		samplepos_t const     bstart = body.start().samples();
+		samplepos_t const     bend   = body.end().samples();
+
+		for (auto const & d : region_to_do) {
+			ReadSegment seg;
+			seg.region          = ar;
+			seg.start           = d.first;
+			seg.end             = d.second;
+			seg.max_end         = d.second;
+			seg.order           = segs.size ();
+			seg.region_position = position;
+			seg.region_length   = length;
+			segs.push_back (seg);
+
+			if (ar->opaque ()) {
+				/* Cut this range down to just the body and mark it done */
+				samplepos_t const ds = max (d.first, bstart);
+				samplepos_t const de = min (d.second - tail, bend);
+
+				/* the body is empty if the fades overlap */
+				if (ds < de) {
+					add_range (done, ds, de);
+				}
+			}
+		}
+	}
+}
+
+void
+AudioPlaylist::setup_read_plan ()
+{
+	/* region changes and changes of the region list already invalidate
+	 * the region index, this catches everything else that affects
+	 * layering (e.g. fades, opacity).
+	 */
+	ContentsChanged.connect_same_thread (*this, std::bind (&AudioPlaylist::invalidate_region_index, this));
+	LayeringChanged.connect_same_thread (*this, std::bind (&AudioPlaylist::invalidate_region_index, this));
+	RegionsExtended.connect_same_thread (*this, std::bind (&AudioPlaylist::invalidate_region_index, this));
+}
+
+/** @return the read plan for the current state of the playlist.
+ *  Caller must hold the region lock.
+ */
+std::shared_ptr<AudioPlaylist::ReadPlan const>
+AudioPlaylist::read_plan ()
+{
+	uint64_t const generation = region_generation ();
+
+	{
+		PBD::Mutex::Lock lm (_read_plan_lock);
+		if (_read_plan && _read_plan->generation == generation) {
+			return _read_plan;
+		}
+	}
+
+	std::shared_ptr<ReadPlan> plan (new ReadPlan (generation));
+
+	RegionVector sorted (regions.begin (), regions.end ());
+	std::stable_sort (sorted.begin (), sorted.end (), ReadSorter ());
+
+	plan_segments (sorted, std::numeric_limits<samplepos_t>::min (), std::numeric_limits<samplepos_t>::max (), false, plan->segments);
+
+	std::vector<ReadSegment>& segs (plan->segments);
+
+	std::stable_sort (segs.begin (), segs.end (), [] (ReadSegment const & a, ReadSegment const & b) { return a.start < b.start; });
+
+	for (size_t n = 1; n < segs.size (); ++n) {
+		segs[n].max_end = max (segs[n - 1].max_end, segs[n].end);
+	}
+
+	DEBUG_TRACE (DEBUG::AudioPlayback, string_compose ("Playlist %1 new read plan with %2 segments for %3 regions\n", name (), segs.size (), sorted.size ()));
+
+	PBD::Mutex::Lock lm (_read_plan_lock);
+	_read_plan = plan;
+
+	return plan;
+}
 
 /** @param start Start position in session samples.
  *  @param cnt Number of samples to read.
@@ -186,6 +353,8 @@ AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, ti
 				_session.transport_sample () / (float)_session.sample_rate ()));
 
 	samplecnt_t const scnt (cnt.samples ());
+	samplepos_t const s (start.samples ());
+	samplepos_t const e (s + scnt);
 
 	/* optimizing this memset() away involves a lot of conditionals
 	   that may well cause more of a hit due to cache misses
@@ -208,81 +377,73 @@ AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, ti
 
 	Playlist::RegionReadLock rl (this);
 
-	/* Find all the regions that are involved in the bit we are reading,
-	   and sort them by descending layer and ascending position.
-	*/
-	std::shared_ptr<RegionList> all = regions_touched_locked (start, start + cnt, true);
-	all->sort (ReadSorter ());
+	/* This will be a list of the bits of regions that we need to read,
+	   in the order in which they need to be read.
 
-	/* This will be a list of the bits of our read range that we have
-	   handled completely (ie for which no more regions need to be read).
-	   It is a list of ranges in session samples.
+	   Note: this must not be shared with other calls in the same thread,
+	   reading a compound region calls read () for its nested playlist.
 	*/
-	Temporal::RangeList done;
+	std::vector<ReadSegment> to_do;
 
-	/* This will be a list of the bits of regions that we need to read */
-	list<Segment> to_do;
+	const bool solo_selection = _session.solo_selection_active() && SoloSelectedActive();
+	bool       use_plan       = !solo_selection;
 
-	/* Now go through the `all' list filling in `to_do' and `done' */
-	for (RegionList::iterator i = all->begin(); i != all->end(); ++i) {
-		std::shared_ptr<AudioRegion> ar = std::dynamic_pointer_cast<AudioRegion> (*i);
+	if (use_plan) {
+		std::shared_ptr<ReadPlan const> plan = read_plan ();
+		std::vector<ReadSegment> const& segs (plan->segments);
 
-		/* muted regions don't figure into it at all */
-		if (ar->muted()) {
-			continue;
-		}
+		/* segments that start at or after the end of the range are not involved */
+		std::vector<ReadSegment>::const_iterator last = std::lower_bound (segs.begin (), segs.end (), e,
+				[] (ReadSegment const & seg, samplepos_t pos) { return seg.start < pos; });
 
-		/* check for the case of solo_selection */
-		const bool force_transparent = (_session.solo_selection_active() && SoloSelectedActive() && !SoloSelectedListIncludes( (const Region*) &(**i)));
-		if (force_transparent) {
-			continue;
-		}
+		/* .. and max_end is monotonic, neither are segments before the first that ends after the start */
+		std::vector<ReadSegment>::const_iterator first = std::upper_bound (segs.begin (), last, s,
+				[] (samplepos_t pos, ReadSegment const & seg) { return pos < seg.max_end; });
 
-		/* Work out which bits of this region need to be read;
-		   first, trim to the range we are reading...
-		*/
-		Temporal::Range rrange = ar->range_samples ();
-		Temporal::Range region_range (max (rrange.start(), start),
-		                              min (rrange.end() + ar->tail (), start + cnt));
+		for (std::vector<ReadSegment>::const_iterator i = first; i != last; ++i) {
+			if (i->end <= s) {
+				continue;
+			}
+			if (i->region->position_sample () != i->region_position || i->region->length_samples () != i->region_length) {
+				/* region was modified, and the playlist not (yet) told about it */
+				invalidate_region_index ();
+				use_plan = false;
+				break;
+			}
+			ReadSegment seg (*i);
+			seg.start = max (seg.start, s);
+			seg.end   = min (seg.end, e);
+			to_do.push_back (seg);
+		}
 
-		/* ... and then remove the bits that are already done */
+		std::sort (to_do.begin (), to_do.end (), [] (ReadSegment const & a, ReadSegment const & b) { return a.order > b.order; });
+	}
 
-		Temporal::RangeList region_to_do = region_range.subtract (done);
+	if (!use_plan) {
+		to_do.clear ();
 
-		/* Make a note to read those bits, adding their bodies (the parts between end-of-fade-in
-		   and start-of-fade-out) to the `done' list.
+		/* Find all the regions that are involved in the bit we are reading,
+		   and sort them by descending layer and ascending position.
 		*/
+		RegionVector all;
+		regions_touched_locked (start, start + cnt, true, all);
+		std::stable_sort (all.begin (), all.end (), ReadSorter ());
 
-		Temporal::RangeList::List t = region_to_do.get ();
-
-		for (Temporal::RangeList::List::iterator j = t.begin(); j != t.end(); ++j) {
-			Temporal::Range d = *j;
-			to_do.push_back (Segment (ar, d));
-
-			if (ar->opaque ()) {
-				/* Cut this range down to just the body and mark it done */
-				Temporal::Range body = ar->body_range ();
-
-				if (body.start() < d.end().earlier (ar->tail ()) && body.end() > d.start()) {
-					d.set_start (max (d.start(), body.start()));
-					d.set_end (min (d.end().earlier (ar->tail ()), body.end()));
-					done.add (d);
-				}
-			}
-		}
+		plan_segments (all, s, e, solo_selection, to_do);
+		std::reverse (to_do.begin (), to_do.end ());
 	}
 
-	/* Now go backwards through the to_do list doing the actual reads */
+	/* Now go through the to_do list doing the actual reads */
 
-	for (list<Segment>::reverse_iterator i = to_do.rbegin(); i != to_do.rend(); ++i) {
+	for (std::vector<ReadSegment>::const_iterator i = to_do.begin(); i != to_do.end(); ++i) {
 		DEBUG_TRACE (DEBUG::AudioPlayback, string_compose ("\tPlaylist %1 read %2 @ %3 for %4, channel %5, buf @ %6 offset %7\n",
-		                                                   name(), i->region->name(), i->range.start(),
-		                                                   i->range.length(), (int) chan_n,
-		                                                   buf, i->range.start().earlier (start)));
+		                                                   name(), i->region->name(), i->start,
+		                                                   i->end - i->start, (int) chan_n,
+		                                                   buf, i->start - s));
 
-		samplepos_t read_pos (i->range.start().samples());
-		samplecnt_t read_cnt (i->range.start().distance (i->range.end()).samples());
-		samplecnt_t soffset = start.distance (i->range.start()).samples();
+		samplepos_t read_pos (i->start);
+		samplecnt_t read_cnt (i->end - i->start);
+		samplecnt_t soffset = i->start - s;
 
 		assert (soffset < scnt);
 
@@ -297,8 +458,8 @@ AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, ti
 				<< " in " << i->region->name()
 				<< " for chn " << chan_n
 				<< " to offset " << soffset
-				<< " using range " << i->range.start().samples() << " .. " << i->range.end().samples()
-				<< " len " << i->range.length().samples() << std::endl;
+				<< " using range " << i->start << " .. " << i->end
+				<< " len " << i->end - i->start << std::endl;
 #ifndef NDEBUG
 			/* forward error to DiskReader::audio_read. This does 2 things:
 			 *  - error "DiskReader %1: when refilling, cannot read ..."
@@ -314,6 +475,47 @@ AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, ti
 	return cnt;
 }
 
+/** Issue read-ahead hints for the source data of all regions that
+ *  overlap the given range. Unlike read () this does not consider
+ *  layering, so data of regions that are hidden by opaque regions
+ *  above them may be prefetched as well.
+ *
+ *  @param start Start position in session samples.
+ *  @param cnt Number of samples.
+ */
+void
+AudioPlaylist::prefetch (timepos_t const & start, timecnt_t const & cnt)
+{
+	samplepos_t const s = start.samples ();
+	samplepos_t const e = s + cnt.samples ();
+
+	RegionReadLock rl (this);
+
+	RegionVector all;
+	regions_touched_locked (start, start + cnt, false, all);
+
+	for (auto const& r : all) {
+		std::shared_ptr<AudioRegion> ar = std::dynamic_pointer_cast<AudioRegion> (r);
+
+		if (!ar || ar->muted ()) {
+			continue;
+		}
+
+		samplepos_t const rs = max (s, ar->position_sample ());
+		samplepos_t const re = min (e, ar->position_sample () + ar->length_samples ());
+
+		if (re <= rs) {
+			continue;
+		}
+
+		samplepos_t const offset = ar->start_sample () + rs - ar->position_sample ();
+
+		for (uint32_t n = 0; n < ar->n_channels (); ++n) {
+			ar->audio_source (n)->prefetch (offset, re - rs);
+		}
+	}
+}
+
 void
 AudioPlaylist::dump () const
 {
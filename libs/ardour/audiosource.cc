@@ -58,6 +58,8 @@
 #include "pbd/xml++.h"
 
 #include "ardour/audiosource.h"
+#include "ardour/filename_extensions.h"
+#include "ardour/peak_pyramid.h"
 #include "ardour/rc_configuration.h"
 #include "ardour/runtime_functions.h"
 #include "ardour/session.h"
@@ -83,6 +85,7 @@ AudioSource::AudioSource (Session& s, const string& name)
 	, _peak_byte_max (0)
 	, _peaks_built (false)
 	, _peakfile_fd (-1)
+	, _peak_build_cancelled (false)
 	, peak_leftover_cnt (0)
 	, peak_leftover_size (0)
 	, peak_leftovers (0)
@@ -99,6 +102,7 @@ AudioSource::AudioSource (Session& s, const XMLNode& node)
 	, _peak_byte_max (0)
 	, _peaks_built (false)
 	, _peakfile_fd (-1)
+	, _peak_build_cancelled (false)
 	, peak_leftover_cnt (0)
 	, peak_leftover_size (0)
 	, peak_leftovers (0)
@@ -271,6 +275,9 @@ AudioSource::rename_peakfile (string newpath)
 
 	_peakpath = newpath;
 
+	/* the pyramid is re-created with the next peakfile */
+	drop_peak_pyramid (oldpath);
+
 	return 0;
 }
 
@@ -345,7 +352,12 @@ AudioSource::initialize_peakfile (const string& audio_path, const bool in_sessio
 		}
 	}
 
-	if (!empty() && !_peaks_built && _build_missing_peakfiles && _build_peakfiles) {
+	if (_peaks_built) {
+		/* open the pyramid of the existing peakfile, or build it
+		 * if it is missing or stale.
+		 */
+		setup_peak_pyramid ();
+	} else if (!empty() && _build_missing_peakfiles && _build_peakfiles) {
 		build_peaks_from_scratch ();
 	}
 
@@ -377,12 +389,90 @@ AudioSource::write (Sample const * src, samplecnt_t cnt)
 	return write_unlocked (src, cnt);
 }
 
+void
+AudioSource::prefetch (samplepos_t start, samplecnt_t cnt) const
+{
+	/* a shared lock is sufficient here, prefetch_unlocked() does not
+	 * use the SNDFILE object, only the file-descriptor.
+	 */
+	ReaderLock lm (_lock);
+	prefetch_unlocked (start, cnt);
+}
+
 int
 AudioSource::read_peaks (PeakData *peaks, samplecnt_t npeaks, samplepos_t start, samplecnt_t cnt, double samples_per_visual_peak) const
 {
+	if (samples_per_visual_peak >= PeakPyramid::factor * _FPP && read_peaks_from_pyramid (peaks, npeaks, start, cnt, samples_per_visual_peak)) {
+		return 0;
+	}
 	return read_peaks_with_fpp (peaks, npeaks, start, cnt, samples_per_visual_peak, _FPP);
 }
 
+/** Use the closest level of the peak pyramid, for zoomed out views.
+ *  The pyramid is built in the peak-building thread, see setup_peak_pyramid().
+ *
+ *  @return false if no pyramid is available (yet), and the peakfile has to be used.
+ */
+bool
+AudioSource::read_peaks_from_pyramid (PeakData *peaks, samplecnt_t npeaks, samplepos_t start, samplecnt_t cnt, double samples_per_visual_peak) const
+{
+	{
+		PBD::Mutex::Lock lp (_peaks_ready_lock);
+		if (!_peaks_built || _peakpath.empty () || (_flags & NoPeakFile)) {
+			return false;
+		}
+	}
+
+	/* the pyramid is independent of the audio file, no need for _lock */
+	PBD::Mutex::Lock lm (_pyramid_lock);
+
+	if (!_pyramid || !_pyramid->valid ()) {
+		return false;
+	}
+
+	DEBUG_TRACE (DEBUG::Peaks, string_compose ("PYRAMID PEAKS @ %1 spp for %2 spp\n", _pyramid->level_fpp (samples_per_visual_peak), samples_per_visual_peak));
+
+	return _pyramid->read (peaks, npeaks, start, cnt, samples_per_visual_peak);
+}
+
+/** Open the peak pyramid of the complete peakfile, or build it if it
+ *  is missing or does not match the peakfile. This reads the whole
+ *  peakfile, and is called where the peakfile is set up or built,
+ *  usually the peak-building thread.
+ */
+void
+AudioSource::setup_peak_pyramid ()
+{
+	if (_peakpath.empty () || (_flags & NoPeakFile)) {
+		return;
+	}
+
+	std::string const            path = _peakpath + peakpyramid_suffix;
+	std::unique_ptr<PeakPyramid> pyramid (new PeakPyramid);
+
+	if (pyramid->load (path, _peakpath, _FPP, _length.samples ())) {
+		if (PeakPyramid::build (_peakpath, path, _FPP, _length.samples ()) || pyramid->load (path, _peakpath, _FPP, _length.samples ())) {
+			return;
+		}
+	}
+
+	PBD::Mutex::Lock lm (_pyramid_lock);
+	_pyramid.swap (pyramid);
+}
+
+/** Close the peak pyramid, and remove its file. It is re-built by
+ *  setup_peak_pyramid() once the peakfile is complete again.
+ */
+void
+AudioSource::drop_peak_pyramid (std::string const& peakpath) const
+{
+	PBD::Mutex::Lock lm (_pyramid_lock);
+	_pyramid.reset ();
+	if (!peakpath.empty ()) {
+		::g_unlink ((peakpath + peakpyramid_suffix).c_str ());
+	}
+}
+
 /** @param peaks Buffer to write peak data.
  *  @param npeaks Number of peaks to write.
  */
@@ -876,7 +966,7 @@ AudioSource::build_peaks_from_scratch ()
 
 			lp.release(); // allow butler to refill buffers
 
-			if (_session.deletion_in_progress() || _session.peaks_cleanup_in_progres()) {
+			if (_session.deletion_in_progress() || _session.peaks_cleanup_in_progres() || _peak_build_cancelled.load ()) {
 				cerr << "peak file creation interrupted: " << _name << endmsg;
 				lp.acquire();
 				done_with_peakfile_writes (false);
@@ -904,7 +994,13 @@ AudioSource::build_peaks_from_scratch ()
 		}
 	}
 
+	if (ret == 0) {
+		setup_peak_pyramid ();
+	}
+
   out:
+	_peak_build_cancelled.store (false);
+
 	if (ret) {
 		DEBUG_TRACE (DEBUG::Peaks, string_compose("Could not write peak data, attempting to remove peakfile %1\n", _peakpath));
 		::g_unlink (_peakpath.c_str());
@@ -924,6 +1020,7 @@ AudioSource::close_peakfile ()
 	if (!_peakpath.empty()) {
 		::g_unlink (_peakpath.c_str());
 	}
+	drop_peak_pyramid (_peakpath);
 	_peaks_built = false;
 	return 0;
 }
@@ -963,6 +1060,9 @@ AudioSource::done_with_peakfile_writes (bool done)
 	}
 
 	if (done) {
+		/* the peakfile changed, the pyramid is stale */
+		drop_peak_pyramid (_peakpath);
+
 		PBD::Mutex::Lock lm (_peaks_ready_lock);
 		_peaks_built = true;
 		PeaksReady (); /* EMIT SIGNAL */
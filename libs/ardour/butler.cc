@@ -279,6 +279,45 @@ Butler::thread_work ()
 
 		std::shared_ptr<IOTaskList> tl = _session.io_tasklist ();
 
+		auto refill = [&disk_work_outstanding] (std::shared_ptr<Track> const& tr) {
+			switch (tr->do_refill ()) {
+				case 0:
+					//DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill done %1\n", tr->name()));
+					break;
+				case -1:
+					DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill unfinished %1\n", tr->name ()));
+					disk_work_outstanding = true;
+					break;
+				default:
+					error << string_compose (_("Butler read ahead failure on dstream %1"), tr->name ()) << endmsg;
+#ifndef NDEBUG
+					std::cerr << string_compose (_("Butler read ahead failure on dstream %1"), tr->name ()) << std::endl;
+#endif
+					break;
+			}
+		};
+
+		/* Tracks are refilled in order of their underrun margin (samples
+		 * left to play before the buffer runs empty). Transport speed
+		 * is the same for all tracks, so this is also the order of
+		 * time-to-underrun.
+		 *
+		 * Tracks that need only a small read are batched into a single
+		 * task, to reduce per task overhead with large track-counts.
+		 */
+		samplecnt_t const small_read = 2 * DiskReader::chunk_samples ();
+		size_t const      max_batch  = 8;
+
+		std::shared_ptr<std::vector<std::shared_ptr<Track>>> batch;
+		samplecnt_t                                          batch_margin = 0;
+
+		/* Optionally let the kernel start reading the data for all
+		 * tracks (and all their regions and channels) at once, before
+		 * any of the I/O threads begins its synchronous reads. This
+		 * keeps more requests in flight than there are I/O threads.
+		 */
+		bool const prefetch = Config->get_disk_readahead_hints ();
+
 		for (i = rl_with_auditioner.begin (); !transport_work_requested () && should_run && i != rl_with_auditioner.end (); ++i) {
 			std::shared_ptr<Track> tr = std::dynamic_pointer_cast<Track> (*i);
 
@@ -294,23 +333,35 @@ Butler::thread_work ()
 				continue;
 			}
 
-			tl->push_back ([tr, &disk_work_outstanding]() {
-				switch (tr->do_refill ()) {
-					case 0:
-						//DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill done %1\n", tr->name()));
-						break;
-					case -1:
-						DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill unfinished %1\n", tr->name ()));
-						disk_work_outstanding = true;
-						break;
-					default:
-						error << string_compose (_("Butler read ahead failure on dstream %1"), tr->name ()) << endmsg;
-#ifndef NDEBUG
-						std::cerr << string_compose (_("Butler read ahead failure on dstream %1"), tr->name ()) << std::endl;
-#endif
-						break;
-				}
-			});
+			if (prefetch) {
+				tr->do_prefetch ();
+			}
+
+			samplecnt_t margin = tr->playback_underrun_margin ();
+			tr->record_playback_underrun_margin (margin);
+
+			if (tr->playback_refill_space () >= small_read) {
+				tl->push_back ([tr, refill]() { refill (tr); }, margin);
+				continue;
+			}
+
+			if (!batch) {
+				batch.reset (new std::vector<std::shared_ptr<Track>>);
+				batch_margin = margin;
+			}
+
+			batch->push_back (tr);
+			batch_margin = std::min (batch_margin, margin);
+
+			if (batch->size () == max_batch) {
+				tl->push_back ([batch, refill]() { for (auto const& t : *batch) { refill (t); } }, batch_margin);
+				batch.reset ();
+			}
+		}
+
+		if (batch) {
+			tl->push_back ([batch, refill]() { for (auto const& t : *batch) { refill (t); } }, batch_margin);
+			batch.reset ();
 		}
 
 		tl->process ();
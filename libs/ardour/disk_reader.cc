@@ -17,6 +17,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <limits>
+
 #include "pbd/enumwriter.h"
 #include "pbd/memento_command.h"
 #include "pbd/playback_buffer.h"
@@ -69,6 +71,7 @@ DiskReader::DiskReader (Session& s, Track& t, string const& str, Temporal::TimeD
 	file_sample[DataType::AUDIO] = 0;
 	file_sample[DataType::MIDI]  = 0;
 	_pending_overwrite.store (OverwriteReason (0));
+	reset_underrun_margin_stats ();
 }
 
 DiskReader::~DiskReader ()
@@ -261,6 +264,88 @@ DiskReader::buffer_load () const
 	return (float)((double)b->read_space () / (double)b->bufsize ());
 }
 
+samplecnt_t
+DiskReader::underrun_margin () const
+{
+	std::shared_ptr<ChannelList const> c = channels.reader ();
+
+	if (c->empty ()) {
+		/* MIDI is played from the rendered RTMidiBuffer, which holds the
+		 * complete playlist. It only needs the butler when the transport
+		 * direction changed and it has to be reversed, until then
+		 * playback is wrong.
+		 */
+		return midi_refill_pending () ? 0 : std::numeric_limits<samplecnt_t>::max ();
+	}
+
+	samplecnt_t margin = std::numeric_limits<samplecnt_t>::max ();
+	for (auto const& chan : *c) {
+		margin = std::min<samplecnt_t> (margin, chan->rbuf->read_space ());
+	}
+	return margin;
+}
+
+samplecnt_t
+DiskReader::refill_space () const
+{
+	std::shared_ptr<ChannelList const> c = channels.reader ();
+
+	if (c->empty ()) {
+		return midi_refill_pending () ? std::numeric_limits<samplecnt_t>::max () : 0;
+	}
+
+	return c->front ()->rbuf->write_space ();
+}
+
+bool
+DiskReader::midi_refill_pending () const
+{
+	std::shared_ptr<MidiPlaylist> mpl = std::dynamic_pointer_cast<MidiPlaylist> (_playlists[DataType::MIDI]);
+
+	if (!mpl) {
+		return false;
+	}
+
+	return mpl->rendered ()->reversed () == _session.transport_will_roll_forwards ();
+}
+
+void
+DiskReader::record_underrun_margin (samplecnt_t margin)
+{
+	if (channels.reader ()->empty () || !_session.transport_rolling ()) {
+		/* only audio can underrun, and only while playing */
+		return;
+	}
+
+	if (margin < _margin_min.load ()) {
+		_margin_min.store (margin);
+	}
+	_margin_sum.fetch_add (margin);
+	_margin_cnt.fetch_add (1);
+}
+
+bool
+DiskReader::get_underrun_margin_stats (samplecnt_t& min, double& avg, uint32_t& n_underruns) const
+{
+	uint32_t cnt = _margin_cnt.load ();
+	n_underruns  = _underrun_cnt.load ();
+	if (cnt == 0) {
+		return false;
+	}
+	min = _margin_min.load ();
+	avg = _margin_sum.load () / (double)cnt;
+	return true;
+}
+
+void
+DiskReader::reset_underrun_margin_stats ()
+{
+	_margin_min.store (std::numeric_limits<samplecnt_t>::max ());
+	_margin_sum.store (0);
+	_margin_cnt.store (0);
+	_underrun_cnt.store (0);
+}
+
 void
 DiskReader::adjust_buffering ()
 {
@@ -459,6 +544,7 @@ DiskReader::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_samp
 								name (), available, disk_samples_to_consume,
 								std::setprecision (3), std::fixed,
 								start_sample / (float)_session.sample_rate ()));
+					_underrun_cnt.fetch_add (1);
 					Underrun ();
 					return;
 				}
@@ -1159,6 +1245,58 @@ DiskReader::do_refill ()
 	return refill (_sum_buffer, _mixdown_buffer, _gain_buffer, 0, reversed);
 }
 
+void
+DiskReader::do_prefetch ()
+{
+	if (_session.loading ()) {
+		return;
+	}
+
+	std::shared_ptr<AudioPlaylist> pl = audio_playlist ();
+
+	if (!pl) {
+		return;
+	}
+
+	samplecnt_t cnt = refill_space ();
+
+	if (cnt < _chunk_samples) {
+		/* refill_audio () will not read anything */
+		return;
+	}
+
+	samplepos_t start = file_sample[DataType::AUDIO];
+	Location*   loc   = _loop_location;
+
+	if (!_session.transport_will_roll_forwards ()) {
+		cnt   = min (cnt, start);
+		start = start - cnt;
+		loc   = 0;
+	} else if (start > max_samplepos - cnt) {
+		cnt = max_samplepos - start;
+	}
+
+	if (loc) {
+		/* same as audio_read (): wrap around at the loop end */
+		samplepos_t const loop_start = loc->start_sample ();
+		samplepos_t const loop_end   = loc->end_sample ();
+
+		const Temporal::Range loop_range (loc->start (), loc->end ());
+		start = loop_range.squish (timepos_t (start)).samples ();
+
+		if (loop_end - start < cnt) {
+			samplecnt_t const first = loop_end - start;
+			pl->prefetch (timepos_t (start), timecnt_t::from_samples (first));
+			start = loop_start;
+			cnt   = min (cnt - first, loop_end - loop_start);
+		}
+	}
+
+	if (cnt > 0) {
+		pl->prefetch (timepos_t (start), timecnt_t::from_samples (cnt));
+	}
+}
+
 int
 DiskReader::do_refill_with_alloc (bool partial_fill, bool reversed)
 {
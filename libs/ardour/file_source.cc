@@ -55,6 +55,14 @@ using namespace Glib;
 
 PBD::Signal<int(std::string,std::vector<std::string> )> FileSource::AmbiguousFileName;
 
+static thread_local bool non_interactive_find = false;
+
+void
+FileSource::set_non_interactive_find (bool yn)
+{
+	non_interactive_find = yn;
+}
+
 FileSource::FileSource (Session& session, DataType type, const string& path, const string& origin, Source::Flag flag)
 	: Source(session, type, path, flag)
 	, _path (path)
@@ -287,9 +295,11 @@ FileSource::find (Session& s, DataType type, const string& path, bool must_exist
 
                 if (de_duped_hits.size() > 1) {
 
-			/* more than one match: ask the user */
+			/* more than one match: ask the user, unless this is
+			 * a thread that must not interact with the GUI.
+			 */
 
-                        int which = FileSource::AmbiguousFileName (path, de_duped_hits).value_or (-1);
+                        int which = non_interactive_find ? -1 : FileSource::AmbiguousFileName (path, de_duped_hits).value_or (-1);
 
                         if (which < 0) {
                                 goto out;
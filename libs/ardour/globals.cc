@@ -121,6 +121,7 @@
 #include "ardour/panner_manager.h"
 #include "ardour/plugin_manager.h"
 #include "ardour/presentation_info.h"
+#include "ardour/process_profiler.h"
 #include "ardour/process_thread.h"
 #include "ardour/profile.h"
 #include "ardour/rc_configuration.h"
@@ -130,6 +131,7 @@
 #include "ardour/session.h"
 #include "ardour/session_event.h"
 #include "ardour/source_factory.h"
+#include "ardour/track.h"
 #include "ardour/transport_fsm.h"
 #include "ardour/transport_master_manager.h"
 #include "ardour/triggerbox.h"
@@ -137,6 +139,8 @@
 
 #include "audiographer/routines.h"
 
+#include "evoral/Curve.h"
+
 #if defined(__APPLE__)
 #include <CoreFoundation/CoreFoundation.h>
 #endif
@@ -196,6 +200,10 @@ setup_hardware_optimization (bool try_optimization)
 {
 	bool generic_mix_functions = true;
 
+	Evoral::Curve::ramp_t      linear_ramp = Evoral::Curve::default_linear_ramp;
+	Evoral::Curve::ramp_t      exp2_ramp   = Evoral::Curve::default_exp2_ramp;
+	Evoral::Curve::gain_ramp_t gain_ramp   = Evoral::Curve::default_gain_ramp;
+
 	if (try_optimization) {
 		FPU* fpu = FPU::instance ();
 
@@ -214,6 +222,10 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_no_gain   = x86_avx512f_mix_buffers_no_gain;
 			copy_vector           = x86_avx512f_copy_vector;
 
+			linear_ramp           = x86_avx512f_linear_ramp;
+			exp2_ramp             = x86_avx512f_exp2_ramp;
+			gain_ramp             = x86_avx512f_gain_ramp;
+
 			generic_mix_functions = false;
 
 		} else
@@ -231,6 +243,10 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 			copy_vector           = x86_sse_avx_copy_vector;
 
+			linear_ramp           = x86_fma_linear_ramp;
+			exp2_ramp             = x86_fma_exp2_ramp;
+			gain_ramp             = x86_fma_gain_ramp;
+
 			generic_mix_functions = false;
 
 		} else
@@ -246,6 +262,10 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 			copy_vector           = x86_sse_avx_copy_vector;
 
+			linear_ramp           = x86_avx_linear_ramp;
+			exp2_ramp             = x86_avx_exp2_ramp;
+			gain_ramp             = x86_avx_gain_ramp;
+
 			generic_mix_functions = false;
 
 		} else if (fpu->has_sse ()) {
@@ -274,6 +294,12 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_no_gain   = arm_neon_mix_buffers_no_gain;
 			copy_vector           = arm_neon_copy_vector;
 
+#ifdef __aarch64__
+			linear_ramp           = arm_neon_linear_ramp;
+			exp2_ramp             = arm_neon_exp2_ramp;
+			gain_ramp             = arm_neon_gain_ramp;
+#endif
+
 			generic_mix_functions = false;
 		}
 
@@ -311,6 +337,10 @@ setup_hardware_optimization (bool try_optimization)
 
 	AudioGrapher::Routines::override_compute_peak (compute_peak);
 	AudioGrapher::Routines::override_apply_gain_to_buffer (apply_gain_to_buffer);
+
+	Evoral::Curve::override_linear_ramp (linear_ramp);
+	Evoral::Curve::override_exp2_ramp (exp2_ramp);
+	Evoral::Curve::override_gain_ramp (gain_ramp);
 }
 
 static void
@@ -843,6 +873,7 @@ ARDOUR::cleanup ()
 
 	Analyser::terminate ();
 	SourceFactory::terminate ();
+	ProcessProfiler::set_enabled (false);
 
 	release_dma_latency ();
 	config_connection.disconnect ();
@@ -1077,6 +1108,13 @@ ARDOUR::reset_performance_meters (Session *session)
 		for (size_t n = 0; n < Session::NTT; ++n) {
 			session->dsp_stats[n].queue_reset ();
 		}
+		std::shared_ptr<RouteList const> rl = session->get_routes ();
+		for (auto const& r : *rl) {
+			std::shared_ptr<Track> tr = std::dynamic_pointer_cast<Track> (r);
+			if (tr) {
+				tr->reset_playback_margin_stats ();
+			}
+		}
 	}
 	for (size_t n = 0; n < AudioEngine::NTT; ++n) {
 		AudioEngine::instance()->dsp_stats[n].queue_reset ();
@@ -1084,6 +1122,7 @@ ARDOUR::reset_performance_meters (Session *session)
 	for (size_t n = 0; n < AudioBackend::NTT; ++n) {
 		AudioEngine::instance()->current_backend()->dsp_stats[n].queue_reset ();
 	}
+	ProcessProfiler::reset ();
 }
 
 ARDOUR::AnyTime::AnyTime (std::string const & str)
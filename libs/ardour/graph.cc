@@ -20,6 +20,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <cmath>
 #include <stdio.h>
 
@@ -34,7 +35,10 @@
 #include "ardour/debug.h"
 #include "ardour/graph.h"
 #include "ardour/io_plug.h"
+#include "ardour/process_profiler.h"
 #include "ardour/process_thread.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/rt_subtasks.h"
 #include "ardour/route.h"
 #include "ardour/rt_task.h"
 #include "ardour/rt_tasklist.h"
@@ -47,6 +51,9 @@ using namespace ARDOUR;
 using namespace PBD;
 using namespace std;
 
+/* index of the calling thread in Graph::_work_queues, -1 for non-graph threads */
+static thread_local int32_t graph_thread_id = -1;
+
 #ifdef DEBUG_RT_ALLOC
 static Graph* graph = 0;
 
@@ -62,6 +69,7 @@ alloc_allowed ()
 
 Graph::Graph (Session& session)
 	: SessionHandleRef (session)
+	, _work_stealing (false)
 	, _execution_sem ("graph_execution", 0)
 	, _callback_start_sem ("graph_start", 0)
 	, _callback_done_sem ("graph_done", 0)
@@ -89,6 +97,13 @@ Graph::Graph (Session& session)
 #endif
 }
 
+Graph::~Graph ()
+{
+	for (auto const& q : _work_queues) {
+		delete q;
+	}
+}
+
 void
 Graph::engine_stopped ()
 {
@@ -121,6 +136,18 @@ Graph::reset_thread_list ()
 		drop_threads ();
 	}
 
+	/* one work-queue per thread, threads are not running at this point */
+	while (_work_queues.size () > num_threads) {
+		delete _work_queues.back ();
+		_work_queues.pop_back ();
+	}
+	while (_work_queues.size () < num_threads) {
+		_work_queues.push_back (new WSDeque<ProcessNode*> (_trigger_queue.capacity ()));
+	}
+	for (auto const& q : _work_queues) {
+		q->clear ();
+	}
+
 	/* Allow threads to run */
 	_terminate.store (0);
 
@@ -153,6 +180,9 @@ Graph::session_going_away ()
 	/* now drop all references on the nodes. */
 	_trigger_queue_size.store (0);
 	_trigger_queue.clear ();
+	for (auto const& q : _work_queues) {
+		q->clear ();
+	}
 	_graph_chain = 0;
 }
 
@@ -218,6 +248,20 @@ Graph::prep ()
 		_trigger_queue.reserve (_graph_chain->_nodes_rt.size ());
 	}
 
+	/* All other threads are idle, so the scheduler can be switched
+	 * and work-queues can be resized (this is not rt-safe, but rare,
+	 * same as _trigger_queue above).
+	 */
+	_work_stealing = Config->get_graph_work_stealing ();
+
+	if (_work_stealing) {
+		for (auto const& q : _work_queues) {
+			if (q->capacity () < _graph_chain->_nodes_rt.size ()) {
+				q->reserve (_graph_chain->_nodes_rt.size ());
+			}
+		}
+	}
+
 	_terminal_refcnt.store (_graph_chain->_n_terminal_nodes);
 
 	/* Trigger the initial nodes for processing, which are the ones at the `input' end */
@@ -231,9 +275,49 @@ void
 Graph::trigger (ProcessNode* n)
 {
 	_trigger_queue_size.fetch_add (1);
+
+	/* keep nodes triggered by a graph thread local to that thread,
+	 * idle threads will steal them */
+	if (_work_stealing && graph_thread_id >= 0) {
+		if (_work_queues[graph_thread_id]->push_back (n)) {
+			return;
+		}
+	}
+
 	_trigger_queue.push_back (n);
 }
 
+/** Find a node to process.
+ *
+ * With work-stealing, the calling thread first takes the most recently
+ * triggered node from its own deque, then looks at the shared queue
+ * (initial nodes, RTTasks) and finally steals the oldest entry
+ * from the other threads' deques.
+ */
+bool
+Graph::pop_node (ProcessNode*& to_run)
+{
+	if (!_work_stealing || graph_thread_id < 0) {
+		return _trigger_queue.pop_front (to_run);
+	}
+
+	if (_work_queues[graph_thread_id]->pop_back (to_run)) {
+		return true;
+	}
+
+	if (_trigger_queue.pop_front (to_run)) {
+		return true;
+	}
+
+	size_t n_queues = _work_queues.size ();
+	for (size_t i = 1; i < n_queues; ++i) {
+		if (_work_queues[(graph_thread_id + i) % n_queues]->steal (to_run)) {
+			return true;
+		}
+	}
+	return false;
+}
+
 /** Called when a node at the `output' end of the chain (ie one that has no-one to feed)
  *  is finished.
  */
@@ -243,26 +327,43 @@ Graph::reached_terminal_node ()
 	if (PBD::atomic_dec_and_test (_terminal_refcnt)) {
 	again:
 
+		/* Only RTSubtasks helpers that were cancelled by their owner
+		 * can be left in the queue, running them is a no-op.
+		 */
+		while (_trigger_queue_size.load () > 0) {
+			ProcessNode* n;
+			if (pop_node (n)) {
+				PBD::atomic_dec_and_test (_trigger_queue_size);
+				n->run (_graph_chain);
+			} else {
+				sched_yield ();
+			}
+		}
+
 		/* We have run all the nodes that are at the `output' end of
 		 * the graph, so there is nothing more to do this time around.
 		 */
 		assert (_trigger_queue_size.load() == 0);
 
-		/* Notify caller */
-		DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 cycle done.\n", pthread_name ()));
-
-		_callback_done_sem.signal ();
-
 		/* Ensure that all background threads are idle.
 		 * When freewheeling there may be an immediate restart:
 		 * If there are more threads than CPU cores, some worker-
 		 * threads may only be "on the way" to become idle.
+		 * This must happen before notifying the caller: a thread
+		 * may still be running a cancelled RTSubtasks helper that
+		 * it popped before the queue was drained, and its owner
+		 * can be destroyed once the cycle is done.
 		 */
 		uint32_t n_workers = _n_workers.load();
 		while (_idle_thread_cnt.load() != n_workers) {
 			sched_yield ();
 		}
 
+		/* Notify caller */
+		DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 cycle done.\n", pthread_name ()));
+
+		_callback_done_sem.signal ();
+
 		/* Block until the a process callback */
 		_callback_start_sem.wait ();
 
@@ -295,7 +396,7 @@ Graph::run_one ()
 		return;
 	}
 
-	if (_trigger_queue.pop_front (to_run)) {
+	if (pop_node (to_run)) {
 		/* Wake up idle threads, but at most as many as there's
 		 * work in the trigger queue that can be processed by
 		 * other threads.
@@ -328,7 +429,7 @@ Graph::run_one ()
 		PBD::atomic_dec_and_test (_idle_thread_cnt);
 
 		/* Try to find some work to do */
-		_trigger_queue.pop_front (to_run);
+		pop_node (to_run);
 	}
 
 	/* Update the thread-local tempo map ptr.
@@ -349,8 +450,10 @@ Graph::run_one ()
 void
 Graph::helper_thread ()
 {
-	_n_workers.fetch_add (1);
-	uint32_t id = _n_workers.load();
+	uint32_t id = _n_workers.fetch_add (1) + 1;
+
+	assert (id < _work_queues.size ());
+	graph_thread_id = id;
 
 	/* This is needed for ARDOUR::Session requests called from rt-processors
 	 * in particular Lua scripts may do cross-thread calls */
@@ -382,6 +485,8 @@ Graph::main_thread ()
 {
 	/* first time setup */
 
+	graph_thread_id = 0;
+
 	suspend_rt_malloc_checks ();
 	ProcessThread* pt = new ProcessThread ();
 
@@ -538,6 +643,8 @@ Graph::process_one_route (Route* route)
 
 	DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 runs route %2\n", pthread_name (), route->name ()));
 
+	ProcessProfiler::Scope ps (route->id ());
+
 	switch (_process_mode) {
 		case Roll:
 			retval = route->roll (_process_nframes, _process_start_sample, _process_end_sample, need_butler);
@@ -563,6 +670,7 @@ Graph::process_one_route (Route* route)
 void
 Graph::process_one_ioplug (IOPlug* ioplug)
 {
+	ProcessProfiler::Scope ps (ioplug->id ());
 	ioplug->connect_and_run (_process_start_sample, _process_nframes);
 }
 
@@ -599,6 +707,67 @@ Graph::process_tasklist (RTTaskList const& rt)
 	DEBUG_TRACE (DEBUG::ProcessThreads, "graph execution complete\n");
 }
 
+/** Run the tasks of @a st using the calling thread and as many idle
+ * process threads as are available. Helpers are only queued for idle
+ * threads; those that no thread has picked up by the time the calling
+ * thread ran out of tasks are cancelled rather than waited for, so a
+ * busy graph never stalls the caller.
+ */
+void
+Graph::process_subtasks (RTSubtasks& st)
+{
+	typedef RTSubtasks::Helper Helper;
+
+	uint32_t const idle = _idle_thread_cnt.load ();
+
+	if (graph_thread_id < 0 || idle == 0) {
+		st.run_tasks ();
+		return;
+	}
+
+	uint32_t const want   = std::min (idle, st._n_tasks - 1);
+	uint32_t       queued = 0;
+
+	for (auto const& h : st._helpers) {
+		if (queued == want) {
+			break;
+		}
+		int state = Helper::Idle;
+		if (!h->_state.compare_exchange_strong (state, Helper::Queued)) {
+			/* cancelled in a previous call, still queued */
+			continue;
+		}
+		_trigger_queue_size.fetch_add (1);
+		if (!_trigger_queue.push_back (h)) {
+			PBD::atomic_dec_and_test (_trigger_queue_size);
+			h->_state.store (Helper::Idle);
+			break;
+		}
+		++queued;
+	}
+
+	for (uint32_t i = 0; i < queued; ++i) {
+		_execution_sem.signal ();
+	}
+
+	st.run_tasks ();
+
+	for (auto const& h : st._helpers) {
+		int state = Helper::Queued;
+		if (h->_state.compare_exchange_strong (state, Helper::Cancelled)) {
+			/* retract its wake-up, unless a thread is already awake */
+			_execution_sem.try_wait ();
+		}
+	}
+
+	/* wait for helpers that are still running their last task */
+	for (auto const& h : st._helpers) {
+		while (h->_state.load () == Helper::Running) {
+			sched_yield ();
+		}
+	}
+}
+
 /* ****************************************************************************/
 
 GraphChain::GraphChain (GraphNodeList const& nodelist, GraphEdges const& edges)
@@ -620,6 +789,15 @@ GraphChain::GraphChain (GraphNodeList const& nodelist, GraphEdges const& edges)
 		_nodes_rt.push_back (ni);
 	}
 
+	/* estimate the critical path of every node, used to order processing */
+	for (auto const& ni : _nodes_rt) {
+		critical_path (ni, edges);
+	}
+
+	auto by_critical_path = [this] (node_ptr_t const& a, node_ptr_t const& b) {
+		return _critical_path[a.get ()] > _critical_path[b.get ()];
+	};
+
 	/* now add refs for the connections. */
 	for (auto const& ni : _nodes_rt) {
 		/* The nodes that are directly fed by ni */
@@ -631,16 +809,16 @@ GraphChain::GraphChain (GraphNodeList const& nodelist, GraphEdges const& edges)
 		/* Set up ni's activation set */
 		if (has_output) {
 			std::shared_ptr<GraphActivision::ActivationMap const> m (ni->_activation_set.reader ());
+			auto mm = const_cast<GraphActivision::ActivationMap*> (&(*m));
 			for (auto const& i : fed_from_r) {
-				auto mm = const_cast<GraphActivision::ActivationMap*> (&(*m));
-				auto it = (*mm)[this].insert (i);
-				assert (it.second);
+				(*mm)[this].push_back (i);
 
 				/* Increment the refcount of any node that we directly feed */
-				std::shared_ptr<GraphActivision::RefCntMap const> a ((*it.first)->_init_refcount.reader ());
+				std::shared_ptr<GraphActivision::RefCntMap const> a (i->_init_refcount.reader ());
 				auto aa = const_cast<GraphActivision::RefCntMap*> (&(*a));
 				(*aa)[this] += 1;
 			}
+			(*mm)[this].sort (by_critical_path);
 		}
 
 		/* ni has an input if there are some incoming edges to r in the graph */
@@ -658,9 +836,37 @@ GraphChain::GraphChain (GraphNodeList const& nodelist, GraphEdges const& edges)
 			_n_terminal_nodes += 1;
 		}
 	}
+
+	/* start with the longest chain */
+	_init_trigger_list.sort (by_critical_path);
+
 	dump ();
 }
 
+/** Recursively compute the cost of the longest path starting at the given node.
+ *
+ * Each node costs one unit, plus its measured average processing time
+ * in microseconds. Without measurements this is the number of nodes
+ * along the longest downstream path.
+ */
+float
+GraphChain::critical_path (node_ptr_t const& n, GraphEdges const& edges)
+{
+	auto it = _critical_path.find (n.get ());
+	if (it != _critical_path.end ()) {
+		return it->second;
+	}
+
+	float downstream = 0;
+	for (auto const& i : edges.from (n)) {
+		downstream = std::max (downstream, critical_path (i, edges));
+	}
+
+	float cp = 1.f + n->process_time () + downstream;
+	_critical_path[n.get ()] = cp;
+	return cp;
+}
+
 GraphChain::~GraphChain ()
 {
 	/* clear chain */
@@ -726,7 +932,7 @@ GraphChain::dump () const
 #ifndef NDEBUG
 	DEBUG_TRACE (DEBUG::Graph, "--8<-- Graph dump ----------------------------\n");
 	for (auto const& ni : _nodes_rt) {
-		DEBUG_TRACE (DEBUG::Graph, string_compose ("GraphNode: %1  refcount: %2\n", ni->graph_node_name (), ni->init_refcount (this)));
+		DEBUG_TRACE (DEBUG::Graph, string_compose ("GraphNode: %1  refcount: %2 critical path: %3\n", ni->graph_node_name (), ni->init_refcount (this), _critical_path.at (ni.get ())));
 		for (auto const& ai : ni->activation_set (this)) {
 			DEBUG_TRACE (DEBUG::Graph, string_compose ("  triggers: %1\n", ai->graph_node_name ()));
 		}
@@ -19,6 +19,7 @@
  */
 
 #include "pbd/atomic.h"
+#include "pbd/microseconds.h"
 
 #include "ardour/graphnode.h"
 #include "ardour/graph.h"
@@ -32,7 +33,7 @@ GraphActivision::GraphActivision ()
 {
 }
 
-node_set_t const&
+node_list_t const&
 GraphActivision::activation_set (GraphChain const* const g) const
 {
 	std::shared_ptr<ActivationMap const> m (_activation_set.reader ());
@@ -58,6 +59,7 @@ GraphNode::GraphNode (std::shared_ptr<Graph> graph)
 	: _graph (graph)
 {
 	_refcount.store (0);
+	_process_time.store (0);
 }
 
 void
@@ -70,7 +72,14 @@ GraphNode::prep (GraphChain const* chain)
 void
 GraphNode::run (GraphChain const* chain)
 {
+	PBD::microseconds_t t0 = PBD::get_microseconds ();
 	process ();
+	PBD::microseconds_t t1 = PBD::get_microseconds ();
+
+	/* low-pass filter, used by GraphChain to estimate the critical path */
+	float pt = _process_time.load (std::memory_order_relaxed);
+	_process_time.store (pt + .05f * ((t1 - t0) - pt), std::memory_order_relaxed);
+
 	finish (chain);
 }
 
@@ -92,13 +101,22 @@ GraphNode::trigger ()
 void
 GraphNode::finish (GraphChain const* chain)
 {
-	node_set_t::iterator i;
-	bool                 feeds = false;
+	node_list_t const& as (activation_set (chain));
+	bool const         feeds = !as.empty ();
 
-	/* Notify downstream nodes that depend on this node */
-	for (auto const& i : activation_set (chain)) {
-		i->trigger ();
-		feeds = true;
+	/* Notify downstream nodes that depend on this node.
+	 * The activation set is sorted by descending critical path.
+	 * Nodes are queued FIFO, except with work-stealing where the
+	 * last node that is triggered will be processed next by this thread.
+	 */
+	if (_graph->lifo_trigger ()) {
+		for (auto i = as.rbegin (); i != as.rend (); ++i) {
+			(*i)->trigger ();
+		}
+	} else {
+		for (auto const& i : as) {
+			i->trigger ();
+		}
 	}
 
 	if (!feeds) {
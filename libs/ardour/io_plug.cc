@@ -31,6 +31,7 @@
 #include "ardour/io.h"
 #include "ardour/io_plug.h"
 #include "ardour/lv2_plugin.h"
+#include "ardour/process_profiler.h"
 #include "ardour/readonly_control.h"
 #include "ardour/session.h"
 #include "ardour/utils.h"
@@ -70,6 +71,8 @@ IOPlug::IOPlug (Session& s, std::shared_ptr<Plugin> p, bool pre)
 
 IOPlug::~IOPlug ()
 {
+	ProcessProfiler::forget (id ());
+
 	for (CtrlOutMap::const_iterator i = _control_outputs.begin(); i != _control_outputs.end(); ++i) {
 		std::dynamic_pointer_cast<ReadOnlyControl>(i->second)->drop_references ();
 	}
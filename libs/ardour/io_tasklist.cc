@@ -16,6 +16,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+
 #ifdef HAVE_IOPRIO
 #include <sys/syscall.h>
 #endif
@@ -101,15 +103,19 @@ IOTaskList::~IOTaskList ()
 }
 
 void
-IOTaskList::push_back (std::function<void ()> fn)
+IOTaskList::push_back (std::function<void ()> fn, double priority)
 {
-	_tasks.push_back (fn);
+	_tasks.push_back (std::make_pair (priority, fn));
 }
 
 void
 IOTaskList::process ()
 {
 	assert (strcmp (pthread_name (), "butler") == 0);
+
+	/* worker threads pop tasks from the back, most urgent task last */
+	std::stable_sort (_tasks.begin (), _tasks.end (), [] (Task const& a, Task const& b) { return a.first > b.first; });
+
 	if (_n_threads > 1 && _tasks.size () > 2) {
 		uint32_t wakeup = std::min<uint32_t> (_n_threads, _tasks.size ());
 		DEBUG_TRACE (PBD::DEBUG::IOTaskList, string_compose ("IOTaskList process wakeup %1 thread for %2 tasks.\n", wakeup, _tasks.size ()))
@@ -121,8 +127,8 @@ IOTaskList::process ()
 		}
 	} else {
 		DEBUG_TRACE (PBD::DEBUG::IOTaskList, string_compose ("IOTaskList process %1 task(s) in main thread.\n", _tasks.size ()))
-		for (auto const& fn : _tasks) {
-			fn ();
+		for (auto t = _tasks.rbegin (); t != _tasks.rend (); ++t) {
+			t->second ();
 		}
 	}
 	_tasks.clear ();
@@ -176,7 +182,7 @@ IOTaskList::io_thread ()
 			if (_tasks.empty ()) {
 				break;
 			}
-			fn = _tasks.back ();
+			fn = _tasks.back ().second;
 			_tasks.pop_back ();
 			lm.release ();
 
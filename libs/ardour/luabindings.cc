@@ -94,6 +94,7 @@
 #include "ardour/plugin_manager.h"
 #include "ardour/polarity_processor.h"
 #include "ardour/port_manager.h"
+#include "ardour/process_profiler.h"
 #include "ardour/raw_midi_parser.h"
 #include "ardour/runtime_functions.h"
 #include "ardour/region.h"
@@ -1631,6 +1632,10 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("use_copy_playlist", &Track::use_copy_playlist)
 		.addFunction ("use_new_playlist", &Track::use_new_playlist)
 		.addFunction ("find_and_use_playlist", &Track::find_and_use_playlist)
+		.addFunction ("playback_buffer_load", &Track::playback_buffer_load)
+		.addFunction ("playback_underrun_margin", &Track::playback_underrun_margin)
+		.addRefFunction ("get_playback_margin_stats", &Track::get_playback_margin_stats)
+		.addFunction ("reset_playback_margin_stats", &Track::reset_playback_margin_stats)
 		.endClass ()
 
 		.deriveWSPtrClass <AudioTrack, Track> ("AudioTrack")
@@ -3383,6 +3388,14 @@ LuaBindings::common (lua_State* L)
 		.endClass ()
 
 		.endNamespace () // end LuaAPI
+
+		.beginNamespace ("ProcessProfiler")
+		.addFunction ("set_enabled", &ProcessProfiler::set_enabled)
+		.addFunction ("enabled", &ProcessProfiler::enabled)
+		.addFunction ("dropped", &ProcessProfiler::dropped)
+		.addFunction ("reset", &ProcessProfiler::reset)
+		.addRefFunction ("get_stats", &ProcessProfiler::get_stats)
+		.endNamespace () // end ProcessProfiler
 		.endNamespace ();// end ARDOUR
 
 	// DSP functions
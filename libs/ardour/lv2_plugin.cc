@@ -474,6 +474,7 @@ LV2Plugin::LV2Plugin (AudioEngine& engine,
 	, _uri_map(URIMap::instance())
 	, _no_sample_accurate_ctrl (false)
 	, _connect_all_audio_outputs (false)
+	, _timed_property_pos (0)
 {
 	init(c_plugin, rate);
 	latency_compute_run();
@@ -494,6 +495,7 @@ LV2Plugin::LV2Plugin (const LV2Plugin& other)
 	, _uri_map(URIMap::instance())
 	, _no_sample_accurate_ctrl (false)
 	, _connect_all_audio_outputs (false)
+	, _timed_property_pos (0)
 {
 	init(other._impl->plugin, other._sample_rate);
 
@@ -845,6 +847,9 @@ LV2Plugin::init(const void* c_plugin, samplecnt_t rate)
 					flags |= PORT_PATCHMSG;
 					if (flags & PORT_INPUT) {
 						_patch_port_in_index = i;
+						/* room for property automation, see set_property_at() */
+						_timed_properties.reserve (256);
+						_timed_property_atoms.reserve (16384);
 					} else {
 						_patch_port_out_index = i;
 					}
@@ -2016,6 +2021,36 @@ forge_variant(LV2_Atom_Forge* forge, const Variant& value)
 	}
 }
 
+/** Forge a patch:Set message for property @p key into @p buf */
+static void
+forge_patch_set(LV2_Atom_Forge*       forge,
+                const URIMap::URIDs&  urids,
+                uint8_t*              buf,
+                uint32_t              size,
+                uint32_t              key,
+                const Variant&        value)
+{
+	LV2_Atom_Forge_Frame frame;
+
+	lv2_atom_forge_set_buffer(forge, buf, size);
+
+	// Serialize patch:Set message to set property
+#ifdef HAVE_LV2_1_10_0
+	lv2_atom_forge_object(forge, &frame, 0, urids.patch_Set);
+	lv2_atom_forge_key(forge, urids.patch_property);
+	lv2_atom_forge_urid(forge, key);
+	lv2_atom_forge_key(forge, urids.patch_value);
+#else
+	lv2_atom_forge_blank(forge, &frame, 0, urids.patch_Set);
+	lv2_atom_forge_property_head(forge, urids.patch_property, 0);
+	lv2_atom_forge_urid(forge, key);
+	lv2_atom_forge_property_head(forge, urids.patch_value, 0);
+#endif
+
+	forge_variant(forge, value);
+	lv2_atom_forge_pop(forge, &frame);
+}
+
 /** Get a variant type from a URI, return false iff no match found. */
 static bool
 uri_to_variant_type(const std::string& uri, Variant::Type& type)
@@ -2054,26 +2089,8 @@ LV2Plugin::set_property(uint32_t key, const Variant& value)
 	}
 
 	// Set up forge to write to temporary buffer on the stack
-	LV2_Atom_Forge*      forge = &_impl->ui_forge;
-	LV2_Atom_Forge_Frame frame;
-	uint8_t              buf[PATH_MAX];  // Ought to be enough for anyone...
-
-	lv2_atom_forge_set_buffer(forge, buf, sizeof(buf));
-
-	// Serialize patch:Set message to set property
-#ifdef HAVE_LV2_1_10_0
-	lv2_atom_forge_object(forge, &frame, 0, _uri_map.urids.patch_Set);
-	lv2_atom_forge_key(forge, _uri_map.urids.patch_property);
-	lv2_atom_forge_urid(forge, key);
-	lv2_atom_forge_key(forge, _uri_map.urids.patch_value);
-#else
-	lv2_atom_forge_blank(forge, &frame, 0, _uri_map.urids.patch_Set);
-	lv2_atom_forge_property_head(forge, _uri_map.urids.patch_property, 0);
-	lv2_atom_forge_urid(forge, key);
-	lv2_atom_forge_property_head(forge, _uri_map.urids.patch_value, 0);
-#endif
-
-	forge_variant(forge, value);
+	uint8_t buf[PATH_MAX];  // Ought to be enough for anyone...
+	forge_patch_set(&_impl->ui_forge, _uri_map.urids, buf, sizeof(buf), key, value);
 
 	// Write message to UI=>Plugin ring
 	const LV2_Atom* const atom = (const LV2_Atom*)buf;
@@ -2083,6 +2100,84 @@ LV2Plugin::set_property(uint32_t key, const Variant& value)
 	              (const uint8_t*)atom);
 }
 
+void
+LV2Plugin::set_property_at (uint32_t key, const Variant& value, sampleoffset_t when)
+{
+	if (_patch_port_in_index == (uint32_t)-1 || value.type () == Variant::NOTHING) {
+		set_property (key, value);
+		return;
+	}
+
+	uint8_t buf[PATH_MAX];
+	forge_patch_set (&_impl->forge, _uri_map.urids, buf, sizeof (buf), key, value);
+
+	const LV2_Atom* const atom = (const LV2_Atom*)buf;
+	const uint32_t        size = lv2_atom_total_size (atom);
+
+	if (_timed_properties.size () == _timed_properties.capacity () ||
+	    _timed_property_atoms.size () + lv2_atom_pad_size (size) > _timed_property_atoms.capacity ()) {
+		/* do not allocate in the process thread, the change is
+		 * applied at the end of the next run instead.
+		 */
+		set_property (key, value);
+		return;
+	}
+
+	TimedProperty tp;
+	tp.time   = std::max<sampleoffset_t> (0, when);
+	tp.offset = _timed_property_atoms.size ();
+
+	/* pad, so that the next atom is aligned */
+	_timed_property_atoms.insert (_timed_property_atoms.end (), buf, buf + size);
+	_timed_property_atoms.resize (tp.offset + lv2_atom_pad_size (size), 0);
+
+	/* keep events of different properties in time order */
+	std::vector<TimedProperty>::iterator i = _timed_properties.end ();
+	while (i != _timed_properties.begin () && (i - 1)->time > tp.time) {
+		--i;
+	}
+	_timed_properties.insert (i, tp);
+}
+
+/** Write the queued properties up to sample @a until (inclusive) to the
+ * patch port. This is interleaved with writing MIDI and position events,
+ * so that the port's atom:Sequence is in time order.
+ */
+void
+LV2Plugin::write_timed_properties (uint32_t until, pframes_t nframes)
+{
+	if (_timed_property_pos == _timed_properties.size () || nframes == 0) {
+		return;
+	}
+
+	LV2_Evbuf_Iterator end = lv2_evbuf_end (_ev_buffers[_patch_port_in_index]);
+
+	for (; _timed_property_pos < _timed_properties.size (); ++_timed_property_pos) {
+		TimedProperty const& tp (_timed_properties[_timed_property_pos]);
+		if (tp.time > until) {
+			break;
+		}
+		const LV2_Atom* const atom = (const LV2_Atom*)&_timed_property_atoms[tp.offset];
+		const uint32_t        when = std::min<uint32_t> (tp.time, nframes - 1);
+		if (!lv2_evbuf_write (&end, when, 0, atom->type, atom->size, (const uint8_t*)(atom + 1))) {
+			error << "Failed to write data to LV2 event buffer\n";
+			_timed_property_pos = _timed_properties.size ();
+			break;
+		}
+	}
+}
+
+/** Discard queued properties, after they were written or when the plugin
+ * was not run.
+ */
+void
+LV2Plugin::drop_timed_properties ()
+{
+	_timed_properties.clear ();
+	_timed_property_atoms.clear ();
+	_timed_property_pos = 0;
+}
+
 const ParameterDescriptor&
 LV2Plugin::get_property_descriptor(uint32_t id) const
 {
@@ -3026,9 +3121,10 @@ LV2Plugin::connect_and_run(BufferSet& bufs,
 					? bufs.get_midi(index).end()
 					: m;
 
-				// Now merge MIDI and any transport events into the buffer
-				const uint32_t     type = _uri_map.urids.midi_MidiEvent;
-				const samplepos_t  tend = end;
+				// Now merge MIDI, transport events and property automation into the buffer
+				const uint32_t     type  = _uri_map.urids.midi_MidiEvent;
+				const samplepos_t  tend  = end;
+				const bool         patch = port_index == _patch_port_in_index;
 
 				/* move to next explicit point
 				 * (if any)
@@ -3052,6 +3148,9 @@ LV2Plugin::connect_and_run(BufferSet& bufs,
 						const Evoral::Event<samplepos_t> ev (*m, false);
 
 						if (ev.time() >= offset && ev.time() < offset + nframes) {
+							if (patch) {
+								write_timed_properties (ev.time() - offset, nframes);
+							}
 							LV2_Evbuf_Iterator eend = lv2_evbuf_end(_ev_buffers[port_index]);
 							lv2_evbuf_write(&eend, ev.time() - offset, 0, type, ev.size(), ev.buffer());
 						}
@@ -3064,6 +3163,10 @@ LV2Plugin::connect_and_run(BufferSet& bufs,
 						const Temporal::BBT_Time bbt = tempo_map_point->bbt();
 						double bpm = (superclock_ticks_per_second() * 60) / tempo_map_point->superclocks_per_note_type_at_superclock (tempo_map_point->sclock());
 
+						if (patch) {
+							write_timed_properties (sample - start, nframes);
+						}
+
 						write_position(&_impl->forge, _ev_buffers[port_index],
 						               *tempo_map_point, bbt, speed, Port::speed_ratio (),
 						               bpm, sample, sample - start);
@@ -3102,6 +3205,12 @@ LV2Plugin::connect_and_run(BufferSet& bufs,
 		lilv_instance_connect_port(_impl->instance, port_index, buf);
 	}
 
+	// Write property automation after the last MIDI or position event
+	if (_patch_port_in_index != (uint32_t)-1) {
+		write_timed_properties (UINT32_MAX, nframes);
+		drop_timed_properties ();
+	}
+
 	// Read messages from UI and push into appropriate buffers
 	if (_from_ui) {
 		uint32_t read_space = _from_ui->read_space();
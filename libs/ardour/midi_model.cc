@@ -550,7 +550,7 @@ MidiModel::NoteDiffCommand::unmarshal_note (XMLNode *xml_note)
 		warning << "note information missing velocity" << endmsg;
 	}
 
-	NotePtr note_ptr(new Evoral::Note<TimeType>(channel, time, length, note, velocity));
+	NotePtr note_ptr (MidiModel::make_note (channel, time, length, note, velocity));
 	note_ptr->set_id (id);
 
 	return note_ptr;
@@ -1511,7 +1511,6 @@ MidiModel::resolve_overlaps_unlocked (const NotePtr note, void* arg)
 	TimeType ea  = note->end_time();
 
 	const Pitches& p (pitches (note->channel()));
-	NotePtr search_note(new Note<TimeType>(0, TimeType(), TimeType(), note->note()));
 	set<NotePtr> to_be_deleted;
 	bool set_note_length = false;
 	bool set_note_time = false;
@@ -1520,7 +1519,7 @@ MidiModel::resolve_overlaps_unlocked (const NotePtr note, void* arg)
 
 	DEBUG_TRACE (DEBUG::Sequence, string_compose ("%1 checking overlaps for note %2 @ %3\n", this, (int)note->note(), note->time()));
 
-	for (Pitches::const_iterator i = p.lower_bound (search_note);
+	for (Pitches::const_iterator i = p.lower_bound (note->note());
 	     i != p.end() && (*i)->note() == note->note(); ++i) {
 
 		TimeType sb = (*i)->time();
@@ -0,0 +1,348 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#ifdef COMPILER_MSVC
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#ifndef PLATFORM_WINDOWS
+#include <sys/mman.h>
+#endif
+
+#include <glib.h>
+#include "pbd/gstdio_compat.h"
+
+#include "pbd/compose.h"
+#include "pbd/error.h"
+#include "pbd/scoped_file_descriptor.h"
+
+#include "ardour/debug.h"
+#include "ardour/filename_extensions.h"
+#include "ardour/peak_pyramid.h"
+
+#include "pbd/i18n.h"
+
+using namespace ARDOUR;
+using namespace PBD;
+
+const char PeakPyramid::magic[8] = { 'A', 'R', 'D', 'P', 'E', 'A', 'K', 'S' };
+
+static const uint32_t max_levels = 16;
+
+PeakPyramid::PeakPyramid ()
+	: _data (0)
+	, _size (0)
+	, _header (0)
+	, _levels (0)
+{
+}
+
+PeakPyramid::~PeakPyramid ()
+{
+	unload ();
+}
+
+int
+PeakPyramid::build (std::string const& peakfile, std::string const& path, samplecnt_t fpp, samplecnt_t length)
+{
+	GStatBuf statbuf;
+
+	if (g_stat (peakfile.c_str (), &statbuf) != 0) {
+		return -1;
+	}
+
+	ScopedFileDescriptor ifd (g_open (peakfile.c_str (), O_RDONLY, 0444));
+
+	if (ifd < 0) {
+		error << string_compose (_("Cannot open peakfile @ %1 for reading (%2)"), peakfile, strerror (errno)) << endmsg;
+		return -1;
+	}
+
+	int64_t const n_base = std::min<int64_t> (statbuf.st_size / sizeof (PeakData), (length + fpp - 1) / fpp);
+
+	if (n_base < (int64_t) factor) {
+		/* the peakfile is small enough */
+		return -1;
+	}
+
+	std::vector<std::vector<PeakData> > levels;
+	int64_t                             n = n_base;
+
+	while (n > 1 && levels.size () < max_levels) {
+		n = (n + factor - 1) / factor;
+		levels.push_back (std::vector<PeakData> ());
+		levels.back ().reserve (n);
+	}
+
+	/* stream the peakfile into the first level */
+
+	const size_t          chunk = 16384 * factor;
+	std::vector<PeakData> buf (chunk);
+	int64_t               done  = 0;
+
+	while (done < n_base) {
+		size_t const  to_read = std::min<int64_t> (chunk, n_base - done);
+		ssize_t const nread   = ::read (ifd, &buf[0], to_read * sizeof (PeakData));
+
+		if (nread != (ssize_t) (to_read * sizeof (PeakData))) {
+			error << string_compose (_("Cannot read peakfile @ %1 (%2)"), peakfile, strerror (errno)) << endmsg;
+			return -1;
+		}
+
+		for (size_t i = 0; i < to_read; i += factor) {
+			PeakData p = buf[i];
+			for (size_t k = i + 1; k < std::min<size_t> (i + factor, to_read); ++k) {
+				p.min = std::min (p.min, buf[k].min);
+				p.max = std::max (p.max, buf[k].max);
+			}
+			levels[0].push_back (p);
+		}
+
+		done += to_read;
+	}
+
+	/* each further level combines `factor` peaks of the previous one */
+
+	for (size_t l = 1; l < levels.size (); ++l) {
+		std::vector<PeakData> const& src = levels[l - 1];
+		for (size_t i = 0; i < src.size (); i += factor) {
+			PeakData p = src[i];
+			for (size_t k = i + 1; k < std::min<size_t> (i + factor, src.size ()); ++k) {
+				p.min = std::min (p.min, src[k].min);
+				p.max = std::max (p.max, src[k].max);
+			}
+			levels[l].push_back (p);
+		}
+	}
+
+	Header hdr;
+	memset (&hdr, 0, sizeof (hdr));
+	memcpy (hdr.magic, magic, sizeof (magic));
+	hdr.version   = version;
+	hdr.factor    = factor;
+	hdr.base_fpp  = fpp;
+	hdr.base_size = statbuf.st_size;
+	hdr.length    = length;
+	hdr.n_levels  = levels.size ();
+
+	std::vector<Level> table (levels.size ());
+	int64_t            offset = sizeof (Header) + levels.size () * sizeof (Level);
+	int64_t            lfpp   = fpp;
+
+	for (size_t l = 0; l < levels.size (); ++l) {
+		lfpp *= factor;
+		table[l].fpp     = lfpp;
+		table[l].offset  = offset;
+		table[l].n_peaks = levels[l].size ();
+		offset += levels[l].size () * sizeof (PeakData);
+	}
+
+	/* write to a temporary file, and rename it when complete, so that
+	 * readers never see a partial file.
+	 */
+	std::string const tmp = path + temp_suffix;
+
+	{
+		ScopedFileDescriptor ofd (g_open (tmp.c_str (), O_CREAT | O_TRUNC | O_WRONLY, 0664));
+
+		if (ofd < 0) {
+			error << string_compose (_("Cannot open peak pyramid @ %1 for writing (%2)"), tmp, strerror (errno)) << endmsg;
+			return -1;
+		}
+
+		bool ok = ::write (ofd, &hdr, sizeof (hdr)) == (ssize_t) sizeof (hdr);
+		ok = ok && ::write (ofd, &table[0], table.size () * sizeof (Level)) == (ssize_t) (table.size () * sizeof (Level));
+
+		for (size_t l = 0; ok && l < levels.size (); ++l) {
+			ssize_t const bytes = levels[l].size () * sizeof (PeakData);
+			ok = ::write (ofd, &levels[l][0], bytes) == bytes;
+		}
+
+		if (!ok) {
+			error << string_compose (_("Cannot write peak pyramid @ %1 (%2)"), tmp, strerror (errno)) << endmsg;
+			::g_unlink (tmp.c_str ());
+			return -1;
+		}
+	}
+
+	if (::g_rename (tmp.c_str (), path.c_str ()) != 0) {
+		::g_unlink (tmp.c_str ());
+		return -1;
+	}
+
+	DEBUG_TRACE (DEBUG::Peaks, string_compose ("Built peak pyramid %1 with %2 levels from %3 peaks\n", path, levels.size (), n_base));
+	return 0;
+}
+
+int
+PeakPyramid::load (std::string const& path, std::string const& peakfile, samplecnt_t fpp, samplecnt_t length)
+{
+	unload ();
+
+	GStatBuf statbuf;
+	GStatBuf peakstat;
+
+	if (g_stat (path.c_str (), &statbuf) != 0 || g_stat (peakfile.c_str (), &peakstat) != 0) {
+		return -1;
+	}
+
+	if (statbuf.st_size < (off_t) sizeof (Header)) {
+		return -1;
+	}
+
+	ScopedFileDescriptor fd (g_open (path.c_str (), O_RDONLY, 0444));
+
+	if (fd < 0) {
+		return -1;
+	}
+
+	size_t const size = statbuf.st_size;
+
+#ifdef PLATFORM_WINDOWS
+	char* data = (char*) malloc (size);
+	if (!data || ::read (fd, data, size) != (ssize_t) size) {
+		free (data);
+		return -1;
+	}
+#else
+	/* only the pages that are used are read from disk */
+	char* data = (char*) mmap (0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (data == MAP_FAILED) {
+		return -1;
+	}
+#endif
+
+	_data = data;
+	_size = size;
+
+	Header const* hdr = reinterpret_cast<Header const*> (_data);
+
+	if (memcmp (hdr->magic, magic, sizeof (magic)) != 0 || hdr->version != version || hdr->factor != factor
+	    || hdr->base_fpp != fpp || hdr->base_size != (int64_t) peakstat.st_size || hdr->length != length
+	    || hdr->n_levels == 0 || hdr->n_levels > max_levels
+	    || _size < sizeof (Header) + hdr->n_levels * sizeof (Level)) {
+		DEBUG_TRACE (DEBUG::Peaks, string_compose ("Peak pyramid %1 is stale or invalid\n", path));
+		unload ();
+		return -1;
+	}
+
+	Level const* levels = reinterpret_cast<Level const*> (_data + sizeof (Header));
+
+	for (uint32_t l = 0; l < hdr->n_levels; ++l) {
+		if (levels[l].offset < 0 || levels[l].n_peaks <= 0 || (size_t) (levels[l].offset + levels[l].n_peaks * sizeof (PeakData)) > _size) {
+			unload ();
+			return -1;
+		}
+	}
+
+	_header = hdr;
+	_levels = levels;
+
+	return 0;
+}
+
+void
+PeakPyramid::unload ()
+{
+	if (_data) {
+#ifdef PLATFORM_WINDOWS
+		free (_data);
+#else
+		munmap (_data, _size);
+#endif
+	}
+	_data   = 0;
+	_size   = 0;
+	_header = 0;
+	_levels = 0;
+}
+
+PeakPyramid::Level const*
+PeakPyramid::level (double samples_per_visual_peak) const
+{
+	if (!_header) {
+		return 0;
+	}
+
+	Level const* rv = 0;
+
+	for (uint32_t l = 0; l < _header->n_levels; ++l) {
+		if (_levels[l].fpp > samples_per_visual_peak) {
+			break;
+		}
+		rv = &_levels[l];
+	}
+
+	return rv;
+}
+
+samplecnt_t
+PeakPyramid::level_fpp (double samples_per_visual_peak) const
+{
+	Level const* l = level (samples_per_visual_peak);
+	return l ? l->fpp : 0;
+}
+
+bool
+PeakPyramid::read (PeakData* peaks, samplecnt_t npeaks, samplepos_t start, samplecnt_t cnt, double samples_per_visual_peak) const
+{
+	Level const* l = level (samples_per_visual_peak);
+
+	if (!l) {
+		return false;
+	}
+
+	PeakData const* data = reinterpret_cast<PeakData const*> (_data + l->offset);
+	double const    fpp  = l->fpp;
+	double const    end  = std::min<samplepos_t> (start + cnt, _header->length);
+
+	for (samplecnt_t i = 0; i < npeaks; ++i) {
+		double const s = start + i * samples_per_visual_peak;
+		double const e = std::min (s + samples_per_visual_peak, end);
+
+		int64_t const first = floor (s / fpp);
+
+		if (s >= end || first >= l->n_peaks) {
+			peaks[i].min = peaks[i].max = 0;
+			continue;
+		}
+
+		int64_t const last = std::min<int64_t> (l->n_peaks, std::max<int64_t> (first + 1, ceil (e / fpp)));
+
+		PeakData p = data[first];
+		for (int64_t k = first + 1; k < last; ++k) {
+			p.min = std::min (p.min, data[k].min);
+			p.max = std::max (p.max, data[k].max);
+		}
+		peaks[i] = p;
+	}
+
+	return true;
+}
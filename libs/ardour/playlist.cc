@@ -334,6 +334,9 @@ Playlist::init (bool hide)
 	_xml_node_name = X_("Playlist");
 
 	block_notifications.store (0);
+	_region_index_dirty.store (true);
+	_region_index_writer.store (false);
+	_region_generation.store (0);
 	pending_contents_change     = false;
 	pending_layering            = false;
 	first_set_state             = true;
@@ -1679,6 +1682,11 @@ Playlist::region_changed_proxy (const PropertyChange& what_changed, std::weak_pt
 		return;
 	}
 
+	/* region_fx may change the tail */
+	if (what_changed.contains (Properties::start) || what_changed.contains (Properties::length) || what_changed.contains (Properties::region_fx)) {
+		invalidate_region_index ();
+	}
+
 	/* this makes a virtual call to the right kind of playlist ... */
 
 	region_changed (what_changed, region);
@@ -1951,18 +1959,94 @@ Playlist::region_is_audible_at_internal (std::shared_ptr<RegionList> const& rlis
 	return false;
 }
 
+void
+Playlist::invalidate_region_index ()
+{
+	PBD::Mutex::Lock lm (_region_index_lock);
+	/* do not keep removed regions (and their sources) alive */
+	_region_index.clear ();
+	_region_index_dirty.store (true);
+	_region_generation.fetch_add (1);
+}
+
+void
+Playlist::rebuild_region_index ()
+{
+	/* Caller must hold the region lock, and _region_index_lock */
+
+	_region_index.clear ();
+	_region_index.reserve (regions.size ());
+
+	for (auto const & r : regions) {
+		_region_index.push_back (RegionIndexEntry (r, r->position (), r->nt_last () + r->tail ()));
+	}
+
+	/* the region list is usually sorted by position already, but there
+	 * are no guarantees while regions are being moved.
+	 */
+	std::stable_sort (_region_index.begin (), _region_index.end (),
+	                  [] (RegionIndexEntry const & a, RegionIndexEntry const & b) { return a.start < b.start; });
+
+	for (size_t n = 1; n < _region_index.size (); ++n) {
+		_region_index[n].max_end = std::max (_region_index[n - 1].max_end, _region_index[n].end);
+	}
+}
+
+/** Find regions that may touch the range @p start .. @p end (both inclusive),
+ *  and for which @p pred is true. Caller must hold the region lock.
+ */
+template<typename Predicate> void
+Playlist::find_regions (timepos_t const & start, timepos_t const & end, Predicate pred, RegionVector& rv)
+{
+	rv.clear ();
+
+	if (_region_index_writer.load ()) {
+		/* A RegionWriteLock is held. Since the caller holds the region
+		 * lock, that can only be this thread: the region list, and
+		 * positions of regions may be in flux.
+		 */
+		for (auto const & r : regions) {
+			if (pred (*r)) {
+				rv.push_back (r);
+			}
+		}
+		return;
+	}
+
+	PBD::Mutex::Lock lm (_region_index_lock);
+
+	if (_region_index_dirty.exchange (false)) {
+		rebuild_region_index ();
+	}
+
+	/* regions that start after the range cannot touch it */
+	auto last = std::upper_bound (_region_index.begin (), _region_index.end (), end,
+	                              [] (timepos_t const & e, RegionIndexEntry const & r) { return e < r.start; });
+
+	/* max_end is monotonic: all regions before the first one with
+	 * max_end at or after the range start end before the range.
+	 */
+	auto first = std::lower_bound (_region_index.begin (), last, start,
+	                               [] (RegionIndexEntry const & r, timepos_t const & s) { return r.max_end < s; });
+
+	for (auto i = first; i != last; ++i) {
+		if (i->end >= start && pred (*i->region)) {
+			rv.push_back (i->region);
+		}
+	}
+}
+
 std::shared_ptr<RegionList>
 Playlist::find_regions_at (timepos_t const & pos)
 {
 	/* Caller must hold lock */
 
-	std::shared_ptr<RegionList> rlist (new RegionList);
+	thread_local RegionVector rv;
 
-	for (auto & r : regions) {
-		if (r->covers (pos)) {
-			rlist->push_back (r);
-		}
-	}
+	find_regions (pos, pos, [&pos] (Region const & r) { return r.covers (pos); }, rv);
+
+	std::shared_ptr<RegionList> rlist (new RegionList (rv.begin (), rv.end ()));
+	rv.clear ();
 
 	return rlist;
 }
@@ -2007,17 +2091,24 @@ Playlist::regions_touched (timepos_t const & start, timepos_t const & end)
 std::shared_ptr<RegionList>
 Playlist::regions_touched_locked (timepos_t const & start, timepos_t const & end, bool with_tail)
 {
-	std::shared_ptr<RegionList> rlist (new RegionList);
+	thread_local RegionVector rv;
 
-	for (auto & r : regions) {
-		if (r->coverage (start, end, with_tail) != Temporal::OverlapNone) {
-			rlist->push_back (r);
-		}
-	}
+	regions_touched_locked (start, end, with_tail, rv);
+
+	std::shared_ptr<RegionList> rlist (new RegionList (rv.begin (), rv.end ()));
+	rv.clear ();
 
 	return rlist;
 }
 
+void
+Playlist::regions_touched_locked (timepos_t const & start, timepos_t const & end, bool with_tail, RegionVector& rv)
+{
+	find_regions (start, end,
+	              [&start, &end, with_tail] (Region const & r) { return r.coverage (start, end, with_tail) != Temporal::OverlapNone; },
+	              rv);
+}
+
 samplepos_t
 Playlist::find_next_transient (timepos_t const & from, int dir)
 {
@@ -395,6 +395,23 @@ PlugInsertBase::PluginPropertyControl::actually_set_value (double user_val, Cont
 	AutomationControl::actually_set_value (user_val, gcd);
 }
 
+void
+PlugInsertBase::PluginPropertyControl::set_value_at (double user_val, sampleoffset_t when)
+{
+	const Variant value (_desc.datatype, user_val);
+	if (value.type () == Variant::NOTHING) {
+		return;
+	}
+
+	for (uint32_t i = 0; i < _pib->get_count (); ++i) {
+		_pib->plugin (i)->set_property_at (parameter ().id (), value, when);
+	}
+
+	_value = value;
+
+	AutomationControl::actually_set_value (user_val, Controllable::NoGroup);
+}
+
 void
 PlugInsertBase::PluginPropertyControl::catch_up_with_external_value (double user_val)
 {
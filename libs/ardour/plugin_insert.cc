@@ -44,6 +44,7 @@
 #include "ardour/plugin.h"
 #include "ardour/plugin_insert.h"
 #include "ardour/port.h"
+#include "ardour/rt_subtasks.h"
 #include "ardour/session.h"
 #include "ardour/types.h"
 
@@ -70,9 +71,14 @@ PluginInsert::PluginInsert (Session& s, Temporal::TimeDomainProvider const & tdp
 	, _latency_changed (false)
 	, _bypass_port (UINT32_MAX)
 	, _inverted_bypass_enable (false)
+	, _parallel_ok (false)
+	, _run_parallel (false)
+	, _instance_cost (0)
 {
 	_stat_reset.store (0);
 	_flush.store (0);
+	_instance_time.store (0);
+	_instance_failed.store (0);
 
 	/* the first is the master */
 	if (plug) {
@@ -169,6 +175,7 @@ PluginInsert::set_count (uint32_t num)
 				p->activate ();
 			}
 		}
+		setup_subtasks ();
 		PluginConfigChanged (); /* EMIT SIGNAL */
 
 	} else if (num < _plugins.size()) {
@@ -177,6 +184,7 @@ PluginInsert::set_count (uint32_t num)
 			_plugins.back()->drop_references ();
 			_plugins.pop_back();
 		}
+		setup_subtasks ();
 		PluginConfigChanged (); /* EMIT SIGNAL */
 	}
 
@@ -946,20 +954,27 @@ PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t e
 			std::shared_ptr<const Evoral::ControlList> clist (c.list());
 			/* we still need to check for Touch and Latch */
 			if (clist && (static_cast<AutomationList const&> (*clist)).automation_playback ()) {
+				const bool timed    = timestamped_automation (c.parameter ());
+				const bool property = c.parameter ().type () == PluginPropertyAutomation;
+
 				/* 1. Set value at [sub]cycle start */
 				bool valid;
 				float val = c.list()->rt_safe_eval (timepos_t (start), valid);
 
 				if (valid) {
-					c.set_value_unchecked(val);
+					if (timed && property) {
+						/* order it before the events below */
+						dynamic_cast<PluginPropertyControl&> (c).set_value_at (val, 0);
+					} else {
+						c.set_value_unchecked(val);
+					}
 				}
 
-				if (_plugins.front()->get_info ()->type != ARDOUR::VST3) {
+				if (!timed) {
 					continue;
 				}
 
-#if 1
-				/* 2. VST3: events between now and end. */
+				/* 2. timestamped events between now and end. */
 				timepos_t start_time (start);
 				timepos_t now (start_time);
 				while (true) {
@@ -971,22 +986,30 @@ PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t e
 					}
 					now = next_event.when;
 					const float val = c.list()->rt_safe_eval (now, valid);
-					if (valid) {
-						for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i) {
+					if (!valid) {
+						continue;
+					}
+					for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i) {
+						if (property) {
+							(*i)->set_property_at (clist->parameter().id(), Variant (c.desc ().datatype, val), now.samples() - start);
+						} else {
 							(*i)->set_parameter (clist->parameter().id(), val, now.samples() - start);
 						}
 					}
 				}
-#endif
-#if 1
-				/* 3. VST3: set value at cycle-end */
+
+				if (property) {
+					/* the next cycle starts with the value at its start */
+					continue;
+				}
+
+				/* 3. set value at cycle-end */
 				val = c.list()->rt_safe_eval (timepos_t (end), valid);
 				if (valid) {
 					for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i) {
 						(*i)->set_parameter (clist->parameter().id(), val, end - start);
 					}
 				}
-#endif
 			}
 		}
 	}
@@ -1125,12 +1148,53 @@ PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t e
 		}
 	} else {
 		/* in-place processing */
-		uint32_t pc = 0;
-		for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i, ++pc) {
-			if ((*i)->connect_and_run(bufs, start, end, speed, in_map.p(pc), out_map.p(pc), nframes, offset)) {
+		uint32_t const n_instances = _plugins.size ();
+		uint32_t const threshold   = _parallel_ok ? Config->get_parallel_plugin_instance_threshold () : 0;
+		float          cost        = 0;
+
+		if (threshold > 0 && _run_parallel && _subtasks) {
+			_instance_run.bufs    = &bufs;
+			_instance_run.start   = start;
+			_instance_run.end     = end;
+			_instance_run.speed   = speed;
+			_instance_run.nframes = nframes;
+			_instance_run.offset  = offset;
+			_instance_run.in_map  = &in_map;
+			_instance_run.out_map = &out_map;
+			_instance_time.store (0);
+			_instance_failed.store (0);
+
+			_subtasks->process (n_instances);
+
+			if (_instance_failed.load ()) {
 				deactivate ();
 			}
+			cost = _instance_time.load () / (float) n_instances;
+		} else {
+			int64_t const t0 = threshold > 0 ? PBD::get_microseconds () : 0;
+			uint32_t pc = 0;
+			for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i, ++pc) {
+				if ((*i)->connect_and_run(bufs, start, end, speed, in_map.p(pc), out_map.p(pc), nframes, offset)) {
+					deactivate ();
+				}
+			}
+			if (threshold > 0) {
+				cost = (PBD::get_microseconds () - t0) / (float) n_instances;
+			}
+		}
+
+		if (threshold > 0) {
+			/* smooth, and only go back to serial processing well
+			 * below the threshold, to not toggle every other cycle.
+			 */
+			_instance_cost += 0.1f * (cost - _instance_cost);
+			if (_run_parallel) {
+				_run_parallel = _instance_cost > 0.5f * threshold;
+			} else {
+				_run_parallel = _instance_cost > threshold && _subtasks;
+			}
 		}
+
 		// now silence unconnected outputs
 		inplace_silence_unconnected (bufs, _out_map, nframes, offset);
 	}
@@ -1168,6 +1232,33 @@ PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t e
 	}
 }
 
+void
+PluginInsert::run_instance (uint32_t pc)
+{
+	InstanceRun const& r (_instance_run);
+	int64_t const      t0 = PBD::get_microseconds ();
+
+	if (_plugins[pc]->connect_and_run (*r.bufs, r.start, r.end, r.speed, r.in_map->p (pc), r.out_map->p (pc), r.nframes, r.offset)) {
+		_instance_failed.store (1);
+	}
+
+	_instance_time.fetch_add (PBD::get_microseconds () - t0);
+}
+
+void
+PluginInsert::setup_subtasks ()
+{
+	/* called when the number of instances changes, the process-thread
+	 * is not using the insert, same as for _plugins.
+	 */
+	if (get_count () > 1 && _session.process_graph ()) {
+		_subtasks.reset (new RTSubtasks (_session.process_graph (), std::bind (&PluginInsert::run_instance, this, _1), get_count () - 1));
+	} else {
+		_subtasks.reset ();
+	}
+	_run_parallel = false;
+}
+
 void
 PluginInsert::bypass (BufferSet& bufs, pframes_t nframes)
 {
@@ -1378,11 +1469,50 @@ PluginInsert::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_sa
 		_delaybuffers.flush ();
 	}
 
+	/* property automation is only valid for the cycle it was queued for */
+	for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i) {
+		(*i)->drop_timed_properties ();
+	}
+
 	/* we have no idea whether the plugin generated silence or not, so mark
 	 * all buffers appropriately.
 	 */
 }
 
+bool
+PluginInsert::timestamped_automation (Evoral::Parameter const& param) const
+{
+	std::shared_ptr<Plugin> p (_plugins.front ());
+
+	switch (param.type ()) {
+	case PluginAutomation:
+		return p->timestamped_parameters ();
+	case PluginPropertyAutomation:
+		return p->timestamped_properties ();
+	default:
+		return false;
+	}
+}
+
+/** @return false if all automation that is played back can be passed
+ * to the plugin as timestamped events, and the cycle is run at once.
+ */
+bool
+PluginInsert::automation_splits_cycle () const
+{
+	if (_plugins.front ()->requires_fixed_sized_buffers ()) {
+		return false;
+	}
+
+	std::shared_ptr<AutomationControlList const> cl = _automated_controls.reader ();
+	for (AutomationControlList::const_iterator ci = cl->begin(); ci != cl->end(); ++ci) {
+		if ((*ci)->automation_playback () && !timestamped_automation ((*ci)->parameter ())) {
+			return true;
+		}
+	}
+	return false;
+}
+
 void
 PluginInsert::automate_and_run (BufferSet& bufs, samplepos_t start, samplepos_t end, double speed, pframes_t nframes)
 {
@@ -1399,9 +1529,7 @@ PluginInsert::automate_and_run (BufferSet& bufs, samplepos_t start, samplepos_t
 	/* map start back into loop-range, adjust end */
 	map_loop_range (start, end);
 
-	const bool no_split_cycle =_plugins.front()->requires_fixed_sized_buffers () || _plugins.front()->get_info ()->type == ARDOUR::VST3;
-
-	if (no_split_cycle || !find_next_event (timepos_t (start), timepos_t (end), next_event)) {
+	if (!automation_splits_cycle () || !find_next_event (timepos_t (start), timepos_t (end), next_event)) {
 
 		/* no events have a time within the relevant range */
 
@@ -1685,6 +1813,7 @@ PluginInsert::mapping_changed ()
 {
 	PluginMapChanged (); /* EMIT SIGNAL */
 	_no_inplace = check_inplace ();
+	_parallel_ok = check_parallel ();
 	_session.set_dirty();
 }
 
@@ -1775,6 +1904,45 @@ PluginInsert::check_inplace ()
 	return !inplace_ok; // no-inplace
 }
 
+/** Replicated instances can run concurrently if no two instances
+ * read or write the same buffer.
+ */
+bool
+PluginInsert::check_parallel () const
+{
+	if (_no_inplace || _match.method != Replicate || get_count () < 2) {
+		return false;
+	}
+
+	for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
+		std::set<uint32_t> used;
+		for (uint32_t pc = 0; pc < get_count(); ++pc) {
+			std::set<uint32_t> own;
+			const ChanMapping::Mappings in_m (_in_map.p(pc).mappings ());
+			const ChanMapping::Mappings out_m (_out_map.p(pc).mappings ());
+			ChanMapping::Mappings::const_iterator m;
+			if ((m = in_m.find (*t)) != in_m.end ()) {
+				for (ChanMapping::TypeMapping::const_iterator c = m->second.begin (); c != m->second.end (); ++c) {
+					own.insert (c->second);
+				}
+			}
+			if ((m = out_m.find (*t)) != out_m.end ()) {
+				for (ChanMapping::TypeMapping::const_iterator c = m->second.begin (); c != m->second.end (); ++c) {
+					own.insert (c->second);
+				}
+			}
+			for (std::set<uint32_t>::const_iterator i = own.begin (); i != own.end (); ++i) {
+				if (!used.insert (*i).second) {
+					return false;
+				}
+			}
+		}
+	}
+
+	DEBUG_TRACE (DEBUG::ChanMapping, string_compose ("%1: instances can run in parallel\n", name()));
+	return true;
+}
+
 bool
 PluginInsert::sanitize_maps ()
 {
@@ -2207,6 +2375,7 @@ PluginInsert::configure_io (ChanCount in, ChanCount out)
 	}
 
 	_no_inplace = check_inplace ();
+	_parallel_ok = check_parallel ();
 
 	/* only the "noinplace_buffers" thread buffers need to be this large,
 	 * this can be optimized. other buffers are fine with
@@ -35,6 +35,7 @@ BackendPort::BackendPort (PortEngineSharedImpl &b, const std::string& name, Port
 	: _backend (b)
 	, _name  (name)
 	, _flags (flags)
+	, _rt_connections (new PortList)
 {
 	_capture_latency_range.min = 0;
 	_capture_latency_range.max = 0;
@@ -98,13 +99,13 @@ BackendPort::connect (BackendPortHandle port, BackendPortHandle self)
 void
 BackendPort::store_connection (BackendPortHandle port)
 {
-	/* XXX TODO: _connections MUST NOT CHANGE WHILE PROCESSING.
-	 * Most callers already hold the process-lock, so TRY-LOCK is the sucks-least stopgap
-	 * solution. Eventually connection changes SHOULD be done in sync with processing.
-	 * delegate via _port_connection_queue (and perhaps maintain a separate list for is_connected())
+	/* Backends use rt_connections() in the process callback. _connections is
+	 * still queried by is_connected() etc. Most callers already hold the
+	 * process-lock, TRY-LOCK is a stopgap for the remaining ones.
 	 */
 	PBD::Mutex::Lock lm (AudioEngine::instance()->process_lock (), PBD::Mutex::TryLock);
 	_connections.insert (port);
+	update_rt_connections ();
 }
 
 int
@@ -131,26 +132,19 @@ BackendPort::disconnect (BackendPortHandle port, BackendPortHandle self)
 
 void BackendPort::remove_connection (BackendPortHandle port)
 {
-	/* XXX TODO: _connections MUST NOT CHANGE WHILE PROCESSING.
-	 * Most callers already hold the process-lock, so TRY-LOCK is the sucks-least stopgap
-	 * solution. Eventually connection changes SHOULD be done in sync with processing.
-	 * delegate via _port_connection_queue (and perhaps maintain a separate list for is_connected())
-	 */
+	/* see store_connection () */
 	PBD::Mutex::Lock lm (AudioEngine::instance()->process_lock (), PBD::Mutex::TryLock);
 
 	std::set<BackendPortPtr>::iterator it = _connections.find (port);
 	assert (it != _connections.end ());
 	_connections.erase (it);
+	update_rt_connections ();
 }
 
 
 void BackendPort::disconnect_all (BackendPortHandle self)
 {
-	/* XXX TODO: _connections MUST NOT CHANGE WHILE PROCESSING.
-	 * Most callers already hold the process-lock, so TRY-LOCK is the sucks-least stopgap
-	 * solution. Eventually connection changes SHOULD be done in sync with processing.
-	 * delegate via _port_connection_queue (and perhaps maintain a separate list for is_connected())
-	 */
+	/* see store_connection () */
 	PBD::Mutex::Lock lm (AudioEngine::instance()->process_lock (), PBD::Mutex::TryLock);
 	while (!_connections.empty ()) {
 		std::set<BackendPortPtr>::iterator it = _connections.begin ();
@@ -158,6 +152,22 @@ void BackendPort::disconnect_all (BackendPortHandle self)
 		_backend.port_connect_callback (name(), (*it)->name(), false);
 		_connections.erase (it);
 	}
+	update_rt_connections ();
+}
+
+void
+BackendPort::update_rt_connections ()
+{
+	RCUWriter<PortList>       writer (_rt_connections);
+	std::shared_ptr<PortList> pl = writer.get_copy ();
+
+	/* plain pointers: ports are unregistered (and destroyed) while holding
+	 * the process-lock, not while the process callback uses the list.
+	 */
+	pl->clear ();
+	for (std::set<BackendPortPtr>::const_iterator it = _connections.begin (); it != _connections.end (); ++it) {
+		pl->push_back (it->get ());
+	}
 }
 
 bool
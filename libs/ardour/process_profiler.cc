@@ -0,0 +1,266 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include <glibmm/timer.h>
+
+#include "ardour/process_profiler.h"
+
+using namespace ARDOUR;
+using namespace PBD;
+
+ProcessProfiler::ThreadBuffer*        ProcessProfiler::_buffers = 0;
+std::atomic<bool>                     ProcessProfiler::_enabled (false);
+std::atomic<uint64_t>                 ProcessProfiler::_dropped (0);
+PBD::Thread*                          ProcessProfiler::_thread = 0;
+std::atomic<bool>                     ProcessProfiler::_run_thread (false);
+PBD::Mutex                            ProcessProfiler::_lock;
+std::map<PBD::ID, ProcessProfiler::Histogram> ProcessProfiler::_histograms;
+
+namespace ARDOUR {
+
+/** Per thread reference to a ProcessProfiler::ThreadBuffer,
+ * the buffer is returned to the pool when the thread terminates.
+ */
+struct ProcessProfilerThreadClaim {
+	ProcessProfilerThreadClaim () : tb (0) {}
+	~ProcessProfilerThreadClaim ()
+	{
+		if (tb) {
+			tb->in_use.store (0, std::memory_order_release);
+		}
+	}
+	ProcessProfiler::ThreadBuffer* tb;
+};
+
+}
+
+static thread_local ProcessProfilerThreadClaim thread_claim;
+
+/* ****************************************************************************/
+
+ProcessProfiler::Histogram::Histogram ()
+	: _cnt (0)
+	, _min (std::numeric_limits<microseconds_t>::max ())
+	, _max (0)
+	, _sum (0)
+{
+	memset (_bins, 0, sizeof (_bins));
+}
+
+/* Log-linear bins: 1 usec resolution below 64 usec, then 8 bins per octave */
+size_t
+ProcessProfiler::Histogram::bin (microseconds_t v)
+{
+	if (v < 64) {
+		return v < 0 ? 0 : v;
+	}
+	int e = 6;
+	while ((v >> (e + 1)) > 0) {
+		++e;
+	}
+	size_t b = 64 + (e - 6) * 8 + ((v >> (e - 3)) & 7);
+	return std::min (b, n_bins - 1);
+}
+
+microseconds_t
+ProcessProfiler::Histogram::bin_upper (size_t b)
+{
+	if (b < 63) {
+		return b;
+	}
+	if (b + 1 >= n_bins) {
+		return std::numeric_limits<microseconds_t>::max ();
+	}
+	/* lower bound of the next bin, minus one */
+	size_t        n   = b + 1 - 64;
+	int           e   = 6 + n / 8;
+	microseconds_t lo = (microseconds_t)(8 + (n % 8)) << (e - 3);
+	return lo - 1;
+}
+
+void
+ProcessProfiler::Histogram::add (microseconds_t v)
+{
+	++_cnt;
+	_sum += v;
+	_min = std::min (_min, v);
+	_max = std::max (_max, v);
+	++_bins[bin (v)];
+}
+
+bool
+ProcessProfiler::Histogram::get_stats (microseconds_t& min, microseconds_t& max, double& avg, microseconds_t& p99) const
+{
+	if (_cnt == 0) {
+		return false;
+	}
+	min = _min;
+	max = _max;
+	avg = _sum / (double)_cnt;
+
+	uint64_t target = ceil (.99 * _cnt);
+	uint64_t acc    = 0;
+	p99             = _max;
+	for (size_t b = 0; b < n_bins; ++b) {
+		acc += _bins[b];
+		if (acc >= target) {
+			p99 = std::min (bin_upper (b), _max);
+			break;
+		}
+	}
+	return true;
+}
+
+/* ****************************************************************************/
+
+/** May be called concurrently (OSC, Lua), _lock serializes starting
+ * and stopping the collector thread. The thread only try-locks, so it
+ * can be joined while _lock is held.
+ */
+void
+ProcessProfiler::set_enabled (bool yn)
+{
+	PBD::Mutex::Lock lm (_lock);
+
+	if (yn == enabled ()) {
+		return;
+	}
+
+	if (yn) {
+		if (!_buffers) {
+			/* allocated once, never freed: process threads may hold a reference */
+			_buffers = new ThreadBuffer[n_thread_buffers];
+		}
+		_run_thread.store (true);
+		_thread = PBD::Thread::create (&ProcessProfiler::thread, "ProcessProfiler");
+		if (!_thread) {
+			_run_thread.store (false);
+			return;
+		}
+		_enabled.store (true, std::memory_order_release);
+	} else {
+		_enabled.store (false, std::memory_order_release);
+		_run_thread.store (false);
+		_thread->join ();
+		_thread = 0;
+		collect ();
+	}
+}
+
+ProcessProfiler::ThreadBuffer*
+ProcessProfiler::thread_buffer ()
+{
+	if (thread_claim.tb) {
+		return thread_claim.tb;
+	}
+	for (size_t i = 0; i < n_thread_buffers; ++i) {
+		int expected = 0;
+		if (_buffers[i].in_use.compare_exchange_strong (expected, 1, std::memory_order_acquire)) {
+			thread_claim.tb = &_buffers[i];
+			return thread_claim.tb;
+		}
+	}
+	return 0;
+}
+
+void
+ProcessProfiler::record (PBD::ID const& id, microseconds_t start, microseconds_t end)
+{
+	if (!enabled ()) {
+		return;
+	}
+
+	ThreadBuffer* tb = thread_buffer ();
+	Sample        s (id, start, end);
+
+	if (!tb || tb->rb.write (&s, 1) != 1) {
+		_dropped.fetch_add (1, std::memory_order_relaxed);
+	}
+}
+
+/** Move samples from the ringbuffers into histograms.
+ * Must be called with _lock held.
+ */
+void
+ProcessProfiler::collect ()
+{
+	if (!_buffers) {
+		return;
+	}
+
+	Sample s;
+	for (size_t i = 0; i < n_thread_buffers; ++i) {
+		PBD::RingBuffer<Sample>& rb (_buffers[i].rb);
+		while (rb.read (&s, 1) == 1) {
+			/* timers may not be synchronized across CPU cores */
+			if (s.end >= s.start && s.start > 0) {
+				_histograms[s.id].add (s.end - s.start);
+			}
+		}
+	}
+}
+
+void
+ProcessProfiler::thread ()
+{
+	while (_run_thread.load ()) {
+		Glib::usleep (10000);
+		PBD::Mutex::Lock lm (_lock, PBD::Mutex::TryLock);
+		if (lm.locked ()) {
+			collect ();
+		}
+	}
+}
+
+bool
+ProcessProfiler::get_stats (PBD::ID const& id, microseconds_t& min, microseconds_t& max, double& avg, microseconds_t& p99)
+{
+	PBD::Mutex::Lock lm (_lock);
+	collect ();
+
+	auto h = _histograms.find (id);
+	if (h == _histograms.end ()) {
+		return false;
+	}
+	return h->second.get_stats (min, max, avg, p99);
+}
+
+void
+ProcessProfiler::reset ()
+{
+	PBD::Mutex::Lock lm (_lock);
+	collect ();
+	_histograms.clear ();
+	_dropped.store (0);
+}
+
+void
+ProcessProfiler::forget (PBD::ID const& id)
+{
+	if (!_buffers) {
+		/* never enabled */
+		return;
+	}
+	PBD::Mutex::Lock lm (_lock);
+	collect ();
+	_histograms.erase (id);
+}
@@ -32,6 +32,7 @@
 #include "ardour/automatable.h"
 #include "ardour/chan_count.h"
 #include "ardour/debug.h"
+#include "ardour/process_profiler.h"
 #include "ardour/processor.h"
 #include "ardour/types.h"
 
@@ -107,6 +108,7 @@ Processor::Processor (const Processor& other)
 Processor::~Processor ()
 {
 	DEBUG_TRACE (DEBUG::Destruction, string_compose ("processor %1 destructor\n", _name));
+	ProcessProfiler::forget (id ());
 }
 
 XMLNode&
@@ -86,11 +86,13 @@
 #include "ardour/polarity_processor.h"
 #include "ardour/port.h"
 #include "ardour/port_insert.h"
+#include "ardour/process_profiler.h"
 #include "ardour/processor.h"
 #include "ardour/profile.h"
 #include "ardour/revision.h"
 #include "ardour/route.h"
 #include "ardour/route_group.h"
+#include "ardour/rt_subtasks.h"
 #include "ardour/scale.h"
 #include "ardour/send.h"
 #include "ardour/session.h"
@@ -144,6 +146,8 @@ Route::Route (Session& sess, string name, PresentationInfo::Flag flag, DataType
 	, _custom_meter_position_noted (false)
 	, _pinmgr_proxy (0)
 	, _patch_selector_dialog (0)
+	, _concurrent_bufs (0)
+	, _concurrent_nframes (0)
 {
 	processor_max_streams.reset();
 
@@ -339,6 +343,7 @@ Route::init ()
 Route::~Route ()
 {
 	DEBUG_TRACE (DEBUG::Destruction, string_compose ("route %1 destructor\n", _name));
+	ProcessProfiler::forget (id ());
 
 	/* do this early so that we don't get incoming signals as we are going through destruction
 	 */
@@ -355,6 +360,8 @@ Route::~Route ()
 	}
 
 	_processors.clear ();
+	_concurrent_procs.clear ();
+	_concurrent_groups.clear ();
 }
 
 string
@@ -529,9 +536,24 @@ Route::process_output_buffers (BufferSet& bufs,
 	   and go ....
 	   ----------------------------------------------------------------------------------------- */
 
-	samplecnt_t latency = 0;
+	samplecnt_t latency    = 0;
+	size_t      group      = 0;
+	bool const  concurrent = _concurrent_tasks && Config->get_concurrent_route_processors ();
 
-	for (auto const & proc : _processors) {
+	for (ProcessorList::const_iterator pi = _processors.begin (); pi != _processors.end (); ++pi) {
+
+		std::shared_ptr<Processor> const& proc (*pi);
+
+		if (concurrent && group < _concurrent_groups.size () && proc.get () == _concurrent_procs[_concurrent_groups[group].first]) {
+			size_t const n = prepare_concurrent_run (_concurrent_groups[group++], pi, start_sample, end_sample, speed, latency);
+			if (n > 0) {
+				_concurrent_bufs    = &bufs;
+				_concurrent_nframes = nframes;
+				_concurrent_tasks->process (n);
+				std::advance (pi, n - 1);
+				continue;
+			}
+		}
 
 		bool re_inject_oob_data = false;
 
@@ -585,10 +607,13 @@ Route::process_output_buffers (BufferSet& bufs,
 			}
 		}
 
-		if (speed < 0) {
-			proc->run (bufs, start_sample + latency, end_sample + latency, pspeed, nframes, proc != _processors.back());
-		} else {
-			proc->run (bufs, start_sample - latency, end_sample - latency, pspeed, nframes, proc != _processors.back());
+		{
+			ProcessProfiler::Scope ps (proc->id ());
+			if (speed < 0) {
+				proc->run (bufs, start_sample + latency, end_sample + latency, pspeed, nframes, proc != _processors.back());
+			} else {
+				proc->run (bufs, start_sample - latency, end_sample - latency, pspeed, nframes, proc != _processors.back());
+			}
 		}
 
 		bufs.set_count (proc->output_streams());
@@ -605,6 +630,112 @@ Route::process_output_buffers (BufferSet& bufs,
 	}
 }
 
+/** Fill _concurrent_run for the group starting at @a pi, unless a
+ * processor of the group has changed or currently modifies its input.
+ * @return the number of processors to run, or 0 to process serially
+ */
+size_t
+Route::prepare_concurrent_run (std::pair<size_t, size_t> const& group, ProcessorList::const_iterator pi, samplepos_t start_sample, samplepos_t end_sample, int speed, samplecnt_t& latency)
+{
+	samplecnt_t l = latency;
+
+	for (size_t n = 0; n < group.second; ++n, ++pi) {
+		if (pi == _processors.end () || pi->get () != _concurrent_procs[group.first + n]) {
+			return 0;
+		}
+
+		Processor* proc = pi->get ();
+		Send*      send = dynamic_cast<Send*> (proc);
+
+		if (send ? send->modifies_input () : !dynamic_cast<PeakMeter*> (proc)) {
+			return 0;
+		}
+
+		/* same as the serial case in process_output_buffers */
+		if (proc->active ()) {
+			if (speed < 0) {
+				l -= proc->effective_latency ();
+			} else {
+				l += proc->effective_latency ();
+			}
+		}
+
+		ConcurrentRun& r (_concurrent_run[n]);
+		r.proc            = proc;
+		r.start           = speed < 0 ? start_sample + l : start_sample - l;
+		r.end             = speed < 0 ? end_sample + l : end_sample - l;
+		r.speed           = speed;
+		r.result_required = *pi != _processors.back ();
+	}
+
+	latency = l;
+	return group.second;
+}
+
+void
+Route::run_concurrent_processor (uint32_t n)
+{
+	ConcurrentRun const& r (_concurrent_run[n]);
+
+	ProcessProfiler::Scope ps (r.proc->id ());
+	r.proc->run (*_concurrent_bufs, r.start, r.end, r.speed, _concurrent_nframes, r.result_required);
+}
+
+bool
+Route::can_run_concurrently (std::shared_ptr<Processor> const& proc)
+{
+	/* sends copy the signal (see Send::modifies_input for the exception),
+	 * meters only read it.
+	 */
+	return std::dynamic_pointer_cast<Send> (proc) || std::dynamic_pointer_cast<PeakMeter> (proc);
+}
+
+/** Called with the process lock held, after processors were configured */
+void
+Route::setup_concurrent_processors ()
+{
+	_concurrent_procs.clear ();
+	_concurrent_groups.clear ();
+
+	size_t                        max_len = 0;
+	ProcessorList::const_iterator i       = _processors.begin ();
+
+	while (i != _processors.end ()) {
+		if (!can_run_concurrently (*i)) {
+			++i;
+			continue;
+		}
+
+		size_t const offset = _concurrent_procs.size ();
+		while (i != _processors.end () && can_run_concurrently (*i)) {
+			_concurrent_procs.push_back (i->get ());
+			++i;
+		}
+
+		size_t const len = _concurrent_procs.size () - offset;
+		if (len < 2) {
+			_concurrent_procs.resize (offset);
+			continue;
+		}
+
+		_concurrent_groups.push_back (std::make_pair (offset, len));
+		max_len = std::max (max_len, len);
+	}
+
+	_concurrent_run.resize (max_len);
+
+	if (max_len > 1 && _session.process_graph ()) {
+		/* keep the helpers when the longest group did not change */
+		if (!_concurrent_tasks || _concurrent_tasks->max_helpers () != max_len - 1) {
+			_concurrent_tasks.reset (new RTSubtasks (_session.process_graph (), std::bind (&Route::run_concurrent_processor, this, _1), max_len - 1));
+		}
+	} else {
+		_concurrent_tasks.reset ();
+	}
+
+	DEBUG_TRACE (DEBUG::Processors, string_compose ("%1: %2 groups of concurrent processors\n", _name, _concurrent_groups.size ()));
+}
+
 void
 Route::bounce_process (BufferSet& buffers, samplepos_t start, samplecnt_t nframes,
 		std::shared_ptr<Processor> endpoint,
@@ -2096,6 +2227,8 @@ Route::configure_processors_unlocked (ProcessorStreams* err, PBD::RWLock::Writer
 	*/
 	_session.ensure_buffers (n_process_buffers ());
 
+	setup_concurrent_processors ();
+
 	DEBUG_TRACE (DEBUG::Processors, string_compose ("%1: configuration complete\n", _name));
 
 	_in_configure_processors = false;
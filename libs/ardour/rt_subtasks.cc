@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cassert>
+
+#include "pbd/pthread_utils.h"
+
+#include "ardour/graph.h"
+#include "ardour/rt_subtasks.h"
+
+using namespace ARDOUR;
+
+RTSubtasks::RTSubtasks (std::shared_ptr<Graph> graph, std::function<void (uint32_t)> const& fn, uint32_t max_helpers)
+	: _f (fn)
+	, _graph (graph)
+	, _next (0)
+	, _n_tasks (0)
+{
+	for (uint32_t i = 0; i < max_helpers; ++i) {
+		_helpers.push_back (new Helper (*this));
+	}
+}
+
+RTSubtasks::~RTSubtasks ()
+{
+	/* Cancelled helpers are removed from the graph's queue and are
+	 * back to Idle before the cycle in which they were queued
+	 * completes, see Graph::reached_terminal_node. A helper may only
+	 * remain Cancelled if the graph's queue was cleared when the
+	 * process threads were dropped.
+	 */
+	for (auto const& h : _helpers) {
+		while (h->_state.load () == Helper::Running) {
+			sched_yield ();
+		}
+		delete h;
+	}
+}
+
+void
+RTSubtasks::process (uint32_t n)
+{
+	if (n == 0) {
+		return;
+	}
+
+	_n_tasks = n;
+	_next.store (0);
+
+	if (n < 2 || _helpers.empty () || !_graph) {
+		run_tasks ();
+		return;
+	}
+
+	_graph->process_subtasks (*this);
+}
+
+void
+RTSubtasks::run_tasks ()
+{
+	uint32_t i;
+	while ((i = _next.fetch_add (1)) < _n_tasks) {
+		_f (i);
+	}
+}
+
+void
+RTSubtasks::Helper::run (GraphChain const*)
+{
+	int queued = Queued;
+	if (!_state.compare_exchange_strong (queued, Running)) {
+		assert (queued == Cancelled);
+		_state.store (Idle);
+		return;
+	}
+
+	_owner.run_tasks ();
+	_state.store (Idle);
+}
@@ -260,6 +260,10 @@ Session::Session (AudioEngine &eng,
 	, _save_queued (false)
 	, _save_queued_pending (false)
 	, _no_save_signal (false)
+	, _save_generation (0)
+	, _async_save_thread (0)
+	, _async_save_running (0)
+	, _async_save_result (0)
 	, _misc_port_state (nullptr)
 	, _last_roll_location (0)
 	, _last_roll_or_reversal_location (0)
@@ -673,6 +677,9 @@ Session::immediately_post_engine ()
 void
 Session::destroy ()
 {
+	/* let a background save finish before removing its file */
+	join_async_save ();
+
 	/* if we got to here, leaving pending state around
 	 * is a mistake.
 	 */
@@ -850,6 +857,8 @@ Session::destroy ()
 	DEBUG_TRACE (DEBUG::Destruction, "delete route groups\n");
 	_route_groups.clear ();
 
+	SourceFactory::cancel_peak_building ();
+
 	{
 		DEBUG_TRACE (DEBUG::Destruction, "delete sources\n");
 		PBD::Mutex::Lock lm (source_lock);
@@ -5087,6 +5096,11 @@ Session::remove_source (std::weak_ptr<Source> src, bool drop_references)
 		}
 	}
 
+	std::shared_ptr<AudioSource> as = std::dynamic_pointer_cast<AudioSource> (source);
+	if (as) {
+		SourceFactory::cancel_peakfile (as);
+	}
+
 	SourceRemoved (src); /* EMIT SIGNAL */
 	if (drop_references) {
 		source->drop_references ();
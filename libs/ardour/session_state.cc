@@ -47,6 +47,12 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 
+#ifdef PLATFORM_WINDOWS
+#include <io.h> /* _commit */
+#else
+#include <unistd.h> /* fsync */
+#endif
+
 #ifdef HAVE_SYS_VFS_H
 #include <sys/vfs.h>
 #endif
@@ -77,6 +83,7 @@
 #include "evoral/SMF.h"
 
 #include "pbd/basename.h"
+#include "pbd/cpus.h"
 #include "pbd/debug.h"
 #include "pbd/enumwriter.h"
 #include "pbd/error.h"
@@ -85,6 +92,8 @@
 #include "pbd/pthread_utils.h"
 #include "pbd/progress.h"
 #include "pbd/scoped_file_descriptor.h"
+#include "pbd/thread_pool.h"
+#include "pbd/timing.h"
 #include "pbd/types_convert.h"
 #include "pbd/localtime_r.h"
 #include "pbd/unwind.h"
@@ -104,6 +113,7 @@
 #include "ardour/debug.h"
 #include "ardour/directory_names.h"
 #include "ardour/disk_reader.h"
+#include "ardour/file_source.h"
 #include "ardour/filename_extensions.h"
 #include "ardour/filesystem_paths.h"
 #include "ardour/graph.h"
@@ -197,6 +207,8 @@ Session::pre_engine_init (string fullpath)
 	last_rr_session_dir = session_dirs.begin();
 
 	set_history_depth (Config->get_history_depth());
+	_history.set_spill_directory (_session_dir->root_path ());
+	_history.set_memory_budget ((size_t) Config->get_history_memory_budget() * 1048576);
 
 	/* default: assume simple stereo speaker configuration */
 
@@ -679,7 +691,7 @@ void
 Session::maybe_write_autosave()
 {
 	if (dirty() && record_status() != Recording) {
-		save_state("", true);
+		save_pending_state_async ();
 	}
 }
 
@@ -836,6 +848,9 @@ Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot
 		_save_queued = false;
 	}
 
+	/* supersedes any asynchronous save that has not been written yet */
+	++_save_generation;
+
 	snapshot_t fork_state = NormalSave;
 	if (!snapshot_name.empty() && snapshot_name != _current_snapshot_name && !template_only && !pending && !for_archive) {
 		/* snapshot, close midi */
@@ -904,54 +919,12 @@ Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot
 	std::string tmp_path(_session_dir->root_path());
 	tmp_path = Glib::build_filename (tmp_path, legalize_for_path (snapshot_name + temp_suffix));
 
-	DEBUG_TRACE (DEBUG::SaveState, string_compose ("writing state to '%1'\n", tmp_path));
-
-	if (!tree.write (tmp_path)) {
-		error << string_compose (_("state could not be saved to %1"), tmp_path) << endmsg;
-		if (g_remove (tmp_path.c_str()) != 0) {
-			error << string_compose(_("Could not remove temporary session file at path \"%1\" (%2)"),
-					tmp_path, g_strerror (errno)) << endmsg;
-		}
+	if (write_state_file (tree, tmp_path, xml_path, false)) {
 		return -1;
-
-	} else {
-
-		DEBUG_TRACE (DEBUG::SaveState, string_compose ("renaming state to '%1'\n", xml_path));
-
-		if (::g_rename (tmp_path.c_str(), xml_path.c_str()) != 0) {
-			error << string_compose (_("could not rename temporary session file %1 to %2 (%3)"),
-					tmp_path, xml_path, g_strerror(errno)) << endmsg;
-			if (g_remove (tmp_path.c_str()) != 0) {
-				error << string_compose(_("Could not remove temporary session file at path \"%1\" (%2)"),
-						tmp_path, g_strerror (errno)) << endmsg;
-			}
-			return -1;
-		}
 	}
 
-	//Mixbus auto-backup mechanism
-	if(Profile->get_mixbus()) {
-		if (pending) {  //"pending" save means it's a backup, or some other non-user-initiated save;  a good time to make a backup
-			// make a serialized safety backup
-			// (will make one periodically but only one per hour is left on disk)
-			// these backup files go into a separated folder
-			char timebuf[128];
-			time_t n;
-			struct tm local_time;
-			time (&n);
-			localtime_r (&n, &local_time);
-			strftime (timebuf, sizeof(timebuf), "%y-%m-%d.%H", &local_time);
-			std::string save_path(session_directory().backup_path());
-			save_path += G_DIR_SEPARATOR;
-			save_path += legalize_for_path(_current_snapshot_name);
-			save_path += "-";
-			save_path += timebuf;
-			save_path += statefile_suffix;
-			if (!copy_file (xml_path, save_path)) {
-					error << string_compose(_("Could not save backup file at path \"%1\" (%2)"),
-							save_path, g_strerror (errno)) << endmsg;
-			}
-		}
+	if (pending) {
+		make_safety_backup (xml_path);
 	}
 
 	if (!pending && !for_archive) {
@@ -990,6 +963,203 @@ Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot
 	return 0;
 }
 
+int
+Session::write_state_file (XMLTree& tree, std::string const& tmp_path, std::string const& xml_path, bool sync)
+{
+	DEBUG_TRACE (DEBUG::SaveState, string_compose ("writing state to '%1'\n", tmp_path));
+
+	bool ok = tree.write (tmp_path);
+
+	if (ok && sync) {
+		/* make sure the data is on disk before the rename replaces the old file */
+		PBD::ScopedFileDescriptor fd (g_open (tmp_path.c_str (), O_RDWR, 0));
+#ifdef PLATFORM_WINDOWS
+		ok = fd >= 0 && _commit (fd) == 0;
+#else
+		ok = fd >= 0 && fsync (fd) == 0;
+#endif
+	}
+
+	if (!ok) {
+		error << string_compose (_("state could not be saved to %1"), tmp_path) << endmsg;
+		if (g_remove (tmp_path.c_str()) != 0) {
+			error << string_compose(_("Could not remove temporary session file at path \"%1\" (%2)"),
+					tmp_path, g_strerror (errno)) << endmsg;
+		}
+		return -1;
+	}
+
+	DEBUG_TRACE (DEBUG::SaveState, string_compose ("renaming state to '%1'\n", xml_path));
+
+	if (::g_rename (tmp_path.c_str(), xml_path.c_str()) != 0) {
+		error << string_compose (_("could not rename temporary session file %1 to %2 (%3)"),
+				tmp_path, xml_path, g_strerror(errno)) << endmsg;
+		if (g_remove (tmp_path.c_str()) != 0) {
+			error << string_compose(_("Could not remove temporary session file at path \"%1\" (%2)"),
+					tmp_path, g_strerror (errno)) << endmsg;
+		}
+		return -1;
+	}
+
+	return 0;
+}
+
+void
+Session::make_safety_backup (std::string const& xml_path)
+{
+	//Mixbus auto-backup mechanism
+	if (!Profile->get_mixbus()) {
+		return;
+	}
+
+	/* "pending" save means it's a backup, or some other non-user-initiated save;  a good time to make a backup
+	 * make a serialized safety backup
+	 * (will make one periodically but only one per hour is left on disk)
+	 * these backup files go into a separated folder
+	 */
+	char timebuf[128];
+	time_t n;
+	struct tm local_time;
+	time (&n);
+	localtime_r (&n, &local_time);
+	strftime (timebuf, sizeof(timebuf), "%y-%m-%d.%H", &local_time);
+	std::string save_path(session_directory().backup_path());
+	save_path += G_DIR_SEPARATOR;
+	save_path += legalize_for_path(_current_snapshot_name);
+	save_path += "-";
+	save_path += timebuf;
+	save_path += statefile_suffix;
+	if (!copy_file (xml_path, save_path)) {
+		error << string_compose(_("Could not save backup file at path \"%1\" (%2)"),
+				save_path, g_strerror (errno)) << endmsg;
+	}
+}
+
+struct Session::AsyncSave {
+	XMLTree     tree;
+	uint32_t    generation;
+	std::string xml_path;
+	std::string tmp_path;
+	std::string reclog;
+	int64_t     reclog_size;
+};
+
+static int64_t
+file_size (std::string const& path)
+{
+	GStatBuf sb;
+	if (g_stat (path.c_str (), &sb) != 0) {
+		return -1;
+	}
+	return sb.st_size;
+}
+
+int
+Session::save_pending_state_async ()
+{
+	if (_async_save_running.load ()) {
+		/* the previous save is still being written,
+		 * the next autosave will catch up.
+		 */
+		return 1;
+	}
+
+	join_async_save ();
+
+	PBD::Mutex::Lock lm (save_state_lock);
+	PBD::Mutex::Lock lx (save_source_lock);
+
+	if (!_writable || cannot_save()) {
+		return 1;
+	}
+
+	if (_suspend_save.load ()) {
+		_save_queued_pending = true;
+		return 1;
+	}
+	_save_queued_pending = false;
+
+	++_save_generation;
+
+	for (SourceMap::const_iterator i = sources.begin(); i != sources.end(); ++i) {
+		try {
+			i->second->session_saved();
+		} catch (Evoral::SMF::FileError& e) {
+			error << string_compose ("Could not write to MIDI file %1; MIDI data not saved.", e.file_name ()) << endmsg;
+		}
+	}
+
+	SessionSaveUnderway (); /* EMIT SIGNAL */
+
+	/* The XMLNode tree is a complete copy of the session state, so it can be
+	 * written out while the session continues to be edited.
+	 */
+	AsyncSave* as = new AsyncSave;
+	as->tree.set_root (&state (false, NormalSave));
+	as->generation = _save_generation;
+	as->xml_path   = Glib::build_filename (_session_dir->root_path(), legalize_for_path (_current_snapshot_name + pending_suffix));
+	as->tmp_path   = Glib::build_filename (_session_dir->root_path(), legalize_for_path (_current_snapshot_name + temp_suffix));
+	as->reclog     = Glib::build_filename (_session_dir->root_path(), legalize_for_path (_current_snapshot_name + recordlog_suffix));
+	/* only a record log that already existed is covered by this state */
+	as->reclog_size = file_size (as->reclog);
+
+	_async_save_running = 1;
+	_async_save_thread  = PBD::Thread::create (std::bind (&Session::async_save_thread, this, as), "SaveState");
+
+	if (!_async_save_thread) {
+		/* write it here instead */
+		lx.release ();
+		lm.release ();
+		async_save_thread (as);
+		return _async_save_result;
+	}
+
+	return 0;
+}
+
+void
+Session::async_save_thread (AsyncSave* as)
+{
+	int rv = 1;
+
+	{
+		PBD::Mutex::Lock lm (save_state_lock);
+
+		/* a later save (or session close) has been started since the state
+		 * was captured, writing this one would replace newer state.
+		 */
+		if (as->generation == _save_generation && !cannot_save ()) {
+			rv = write_state_file (as->tree, as->tmp_path, as->xml_path, true);
+		}
+
+		if (rv == 0) {
+			make_safety_backup (as->xml_path);
+			/* new pending state includes recorded regions. */
+			if (as->reclog_size >= 0 && as->reclog_size == file_size (as->reclog)) {
+				::g_unlink (as->reclog.c_str ());
+			}
+		}
+	}
+
+	delete as;
+
+	_async_save_result = rv;
+	_async_save_running = 0;
+
+	PendingStateSaved (rv); /* EMIT SIGNAL */
+}
+
+void
+Session::join_async_save ()
+{
+	if (!_async_save_thread) {
+		return;
+	}
+	_async_save_thread->join ();
+	delete _async_save_thread;
+	_async_save_thread = 0;
+}
+
 int
 Session::recover_recordings (string const& recinfo)
 {
@@ -2329,8 +2499,10 @@ Session::set_state (const XMLNode& node, int version)
 	XMLNodeList nlist;
 	XMLNode* child;
 	int ret = -1;
+	PBD::Timing load_timer;
 
 	_state_of_the_state = StateOfTheState (_state_of_the_state | CannotSave);
+	_load_timings.clear ();
 
 	if (node.name() != X_("Session")) {
 		fatal << _("programming error: Session: incorrect XML node sent to set_state()") << endmsg;
@@ -2510,6 +2682,8 @@ Session::set_state (const XMLNode& node, int version)
 		_speakers->set_state (*child, version);
 	}
 
+	_load_timings.push_back (std::make_pair (X_("setup"), load_timer.get_interval ()));
+
 	if ((child = find_named_node (node, "Sources")) == 0) {
 		error << _("Session: XML state has no 'Sources' section") << endmsg;
 		goto out;
@@ -2518,6 +2692,8 @@ Session::set_state (const XMLNode& node, int version)
 		goto out;
 	}
 
+	_load_timings.push_back (std::make_pair (X_("sources"), load_timer.get_interval ()));
+
 	if ((child = find_named_node (node, "Locations")) == 0) {
 		error << _("Session: XML state has no 'Locations' section") << endmsg;
 		goto out;
@@ -2540,6 +2716,8 @@ Session::set_state (const XMLNode& node, int version)
 		goto out;
 	}
 
+	_load_timings.push_back (std::make_pair (X_("regions"), load_timer.get_interval ()));
+
 	if ((child = find_named_node (node, "Playlists")) == 0) {
 		error << _("Session: XML state has no 'Playlists' section") << endmsg;
 		goto out;
@@ -2562,6 +2740,8 @@ Session::set_state (const XMLNode& node, int version)
 		}
 	}
 
+	_load_timings.push_back (std::make_pair (X_("playlists"), load_timer.get_interval ()));
+
 	if (version >= 3000) {
 		if ((child = find_named_node (node, "Bundles")) == 0) {
 			warning << _("Session: XML state has no 'Bundles' section") << endmsg;
@@ -2649,6 +2829,8 @@ Session::set_state (const XMLNode& node, int version)
 		goto out;
 	}
 
+	_load_timings.push_back (std::make_pair (X_("routes"), load_timer.get_interval ()));
+
 	/* Now that we Tracks have been loaded and playlists are assigned */
 	_playlists->update_tracking ();
 
@@ -2768,6 +2950,18 @@ Session::set_state (const XMLNode& node, int version)
 	update_route_record_state ();
 	sync_cues ();
 
+	_load_timings.push_back (std::make_pair (X_("misc"), load_timer.get_interval ()));
+
+	{
+		std::stringstream ss;
+		PBD::microseconds_t total = 0;
+		for (auto const& t : _load_timings) {
+			ss << " " << t.first << ": " << t.second / 1000 << " ms";
+			total += t.second;
+		}
+		info << string_compose (_("Session: state loaded in %1 ms (%2 )"), total / 1000, ss.str ()) << endmsg;
+	}
+
 	/* here beginneth the second phase ... */
 	set_snapshot_name (_current_snapshot_name);
 
@@ -3382,11 +3576,22 @@ Session::load_sources (const XMLNode& node)
 	set_dirty();
 	std::map<std::string, std::string> relocation;
 
-	for (niter = nlist.begin(); niter != nlist.end(); ++niter) {
+	std::vector<std::shared_ptr<Source> > preloaded (nlist.size ());
+	preload_sources (nlist, preloaded);
+
+	std::vector<std::shared_ptr<Source> >::const_iterator pi = preloaded.begin ();
+
+	for (niter = nlist.begin(); niter != nlist.end(); ++niter, ++pi) {
 #ifdef PLATFORM_WINDOWS
 		int old_mode = 0;
 #endif
 
+		if (*pi) {
+			/* announce in session order */
+			SourceFactory::SourceCreated (*pi);
+			continue;
+		}
+
 		XMLNode srcnode (**niter);
 		bool try_replace_abspath = true;
 
@@ -3506,6 +3711,65 @@ retry:
 	return 0;
 }
 
+/** Construct sources concurrently, without announcing them.
+ *
+ * Opening sources is dominated by file I/O: header parsing, loading MIDI
+ * files and checking peak-files. Sources that cannot be created here
+ * without asking the user, because the file is missing or its name is
+ * ambiguous, are left empty and handled by load_sources() in the
+ * calling thread.
+ */
+void
+Session::preload_sources (const XMLNodeList& nlist, std::vector<std::shared_ptr<Source> >& sources)
+{
+	size_t const n_threads = std::min<size_t> (nlist.size (), std::min<uint32_t> (8, PBD::hardware_concurrency ()));
+
+	if (n_threads < 2) {
+		return;
+	}
+
+	std::atomic<size_t> next (0);
+
+#ifdef PLATFORM_WINDOWS
+	int old_mode = SetErrorMode (SEM_FAILCRITICALERRORS);
+#endif
+
+	{
+		PBD::ThreadPool pool (n_threads);
+
+		for (size_t n = 0; n < n_threads; ++n) {
+			pool.push ([this, &nlist, &sources, &next] () {
+				/* positions may need to be converted */
+				Temporal::TempoMap::update_thread_tempo_map ();
+
+				/* never emit AmbiguousFileName from a pool thread */
+				FileSource::set_non_interactive_find (true);
+
+				for (size_t i = next++; i < nlist.size (); i = next++) {
+					XMLNode const& node (*nlist[i]);
+					if (node.name () != X_("Source") || node.property (X_("playlist"))) {
+						/* nested sources create playlists and regions */
+						continue;
+					}
+					try {
+						sources[i] = SourceFactory::create (*this, node, true, false);
+					} catch (...) {
+						/* retried by load_sources () */
+					}
+				}
+
+				FileSource::set_non_interactive_find (false);
+			});
+		}
+
+		/* the pool's d'tor waits for all tasks to complete */
+	}
+
+#ifdef PLATFORM_WINDOWS
+	SetErrorMode (old_mode);
+#endif
+}
+
 std::shared_ptr<Source>
 Session::XMLSourceFactory (const XMLNode& node)
 {
@@ -4248,8 +4512,11 @@ Session::cleanup_peakfiles ()
 
 	_state_of_the_state = StateOfTheState (_state_of_the_state | PeakCleanup);
 
+	/* all peakfiles are queued again below */
+	SourceFactory::cancel_peak_building ();
+
 	int timeout = 5000; // 5 seconds
-	while (!SourceFactory::files_with_peaks.empty()) {
+	while (SourceFactory::peak_work_queue_length () > 0) {
 		Glib::usleep (1000);
 		if (--timeout < 0) {
 			warning << _("Timeout waiting for peak-file creation to terminate before cleanup, please try again later.") << endmsg;
@@ -5109,6 +5376,8 @@ Session::config_changed (std::string p, bool ours)
 		setup_fpu ();
 	} else if (p == "history-depth") {
 		set_history_depth (Config->get_history_depth());
+	} else if (p == "history-memory-budget") {
+		_history.set_memory_budget ((size_t) Config->get_history_memory_budget() * 1048576);
 	} else if (p == "remote-model") {
 		/* XXX DO SOMETHING HERE TO TELL THE GUI THAT WE NEED
 		   TO SET REMOTE ID'S
@@ -5411,6 +5680,7 @@ Session::rename (const std::string& new_name)
 			(*_session_dir) = newstr;
 			new_path = newstr;
 			first = false;
+			_history.set_spill_directory (newstr);
 		}
 
 		/* now rename directory below session_dir/interchange */
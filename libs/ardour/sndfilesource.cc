@@ -33,6 +33,10 @@
 #include <fcntl.h>
 
 #include <sys/stat.h>
+#ifndef PLATFORM_WINDOWS
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 #include <glib.h>
 #include "pbd/gstdio_compat.h"
@@ -48,6 +52,7 @@
 #include <glibmm/fileutils.h>
 #include <glibmm/miscutils.h>
 
+#include "ardour/rc_configuration.h"
 #include "ardour/runtime_functions.h"
 #include "ardour/sndfilesource.h"
 #include "ardour/sndfile_helpers.h"
@@ -67,6 +72,77 @@ const Source::Flag SndFileSource::default_writable_flags = Source::Flag (
 		Source::RemovableIfEmpty |
 		Source::CanRename );
 
+#ifndef PLATFORM_WINDOWS
+/** @return bytes per sample of uncompressed WAV/CAF/RF64/AIFF data, or 0 */
+static int
+pcm_sample_bytes (int format)
+{
+	switch (format & SF_FORMAT_TYPEMASK) {
+		case SF_FORMAT_WAV:
+		case SF_FORMAT_WAVEX:
+		case SF_FORMAT_RF64:
+		case SF_FORMAT_CAF:
+		case SF_FORMAT_AIFF:
+			break;
+		default:
+			return 0;
+	}
+
+	switch (format & SF_FORMAT_SUBMASK) {
+		case SF_FORMAT_PCM_S8:
+		case SF_FORMAT_PCM_U8:
+			return 1;
+		case SF_FORMAT_PCM_16:
+			return 2;
+		case SF_FORMAT_PCM_24:
+			return 3;
+		case SF_FORMAT_PCM_32:
+		case SF_FORMAT_FLOAT:
+			return 4;
+		case SF_FORMAT_DOUBLE:
+			return 8;
+		default:
+			return 0;
+	}
+}
+
+/** @return true if the sample data of the file can be used as-is by read_mapped() */
+static bool
+pcm_is_mappable (int format)
+{
+#if G_BYTE_ORDER == G_LITTLE_ENDIAN
+	switch (format & SF_FORMAT_TYPEMASK) {
+		case SF_FORMAT_WAV:
+		case SF_FORMAT_WAVEX:
+		case SF_FORMAT_RF64:
+			break;
+		default:
+			return false;
+	}
+
+	switch (format & SF_FORMAT_ENDMASK) {
+		case SF_ENDIAN_FILE:
+		case SF_ENDIAN_LITTLE:
+			break;
+		default:
+			return false;
+	}
+
+	switch (format & SF_FORMAT_SUBMASK) {
+		case SF_FORMAT_PCM_16:
+		case SF_FORMAT_PCM_24:
+		case SF_FORMAT_PCM_32:
+		case SF_FORMAT_FLOAT:
+			return true;
+		default:
+			return false;
+	}
+#else
+	return false;
+#endif
+}
+#endif
+
 SndFileSource::SndFileSource (Session& s, const XMLNode& node)
 	: Source(s, node)
 	, AudioFileSource (s, node)
@@ -342,15 +418,33 @@ SndFileSource::init_sndfile ()
 
 	memset (&_info, 0, sizeof(_info));
 
+	_fd = -1;
+	_data_offset = -1;
+	_bytes_per_sample = 0;
+	_map_base = 0;
+	_map_size = 0;
+	_map_data = 0;
+	_map_last_read = -1;
+
 	AudioFileSource::HeaderPositionOffsetChanged.connect_same_thread (header_position_connection, std::bind (&SndFileSource::handle_header_position_change, this));
 }
 
 void
 SndFileSource::close ()
 {
+#ifndef PLATFORM_WINDOWS
+	if (_map_base) {
+		munmap (_map_base, _map_size);
+		_map_base = 0;
+		_map_size = 0;
+		_map_data = 0;
+	}
+#endif
 	if (_sndfile) {
 		sf_close (_sndfile);
 		_sndfile = 0;
+		_fd = -1;
+		_data_offset = -1;
 		file_closed ();
 	}
 }
@@ -465,6 +559,25 @@ SndFileSource::open ()
 		_flags = Flag (_flags | Broadcast);
 	}
 
+#ifndef PLATFORM_WINDOWS
+	if (!writable ()) {
+		/* for uncompressed files, remember where the sample data
+		 * starts, so that prefetch_unlocked() and read_mapped() can map
+		 * sample positions to byte offsets. libsndfile does not buffer
+		 * PCM data, so after seeking to the first sample, the
+		 * file-position is the start of the data chunk.
+		 */
+		_bytes_per_sample = pcm_sample_bytes (_info.format);
+		if (_bytes_per_sample > 0 && sf_seek (_sndfile, 0, SEEK_SET) == 0) {
+			_fd = fd;
+			_data_offset = lseek (fd, 0, SEEK_CUR);
+		}
+		if (_data_offset >= 0 && Config->get_mmap_audio_sources () && pcm_is_mappable (_info.format)) {
+			map_data ();
+		}
+	}
+#endif
+
 	if (writable()) {
 		sf_command (_sndfile, SFC_SET_UPDATE_HEADER_AUTO, 0, SF_FALSE);
 
@@ -550,6 +663,10 @@ SndFileSource::read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) c
 		memset (dst+file_cnt, 0, sizeof (Sample) * delta);
 	}
 
+	if (file_cnt && _map_data) {
+		return read_mapped (dst, start, file_cnt);
+	}
+
 	if (file_cnt) {
 
 		if (sf_seek (_sndfile, (sf_count_t) start, SEEK_SET|SFM_READ) != (sf_count_t) start) {
@@ -602,6 +719,158 @@ SndFileSource::read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) c
 	return nread;
 }
 
+void
+SndFileSource::prefetch_unlocked (samplepos_t start, samplecnt_t cnt) const
+{
+	if (_map_data) {
+		advise_mapped (start, cnt);
+		return;
+	}
+
+#ifdef POSIX_FADV_WILLNEED
+	if (_fd < 0 || _data_offset < 0 || start >= _length.samples ()) {
+		return;
+	}
+
+	cnt = min (cnt, _length.samples () - start);
+
+	off_t const bytes_per_frame = (off_t) _bytes_per_sample * _info.channels;
+
+	/* this only queues read-ahead in the kernel, and returns
+	 * without waiting for the data.
+	 */
+	posix_fadvise (_fd, _data_offset + start * bytes_per_frame, cnt * bytes_per_frame, POSIX_FADV_WILLNEED);
+#endif
+}
+
+/** Map the sample data of an uncompressed, read-only file into memory */
+void
+SndFileSource::map_data ()
+{
+#ifndef PLATFORM_WINDOWS
+	GStatBuf statbuf;
+	if (g_stat (_path.c_str (), &statbuf) != 0) {
+		return;
+	}
+
+	off_t const data_end = _data_offset + (off_t) _info.frames * _info.channels * _bytes_per_sample;
+
+	if (_info.frames == 0 || data_end > statbuf.st_size) {
+		/* truncated file, let libsndfile deal with it */
+		return;
+	}
+
+	void* addr = mmap (0, data_end, PROT_READ, MAP_SHARED, _fd, 0);
+
+	if (addr == MAP_FAILED) {
+		warning << string_compose (_("SndFileSource: cannot map file \"%1\" (%2)"), _path, strerror (errno)) << endmsg;
+		return;
+	}
+
+	_map_base = addr;
+	_map_size = data_end;
+	_map_data = static_cast<uint8_t const*> (addr) + _data_offset;
+	_map_last_read = -1;
+#endif
+}
+
+/** Ask the kernel to read ahead the pages of the given range of the mapped file */
+void
+SndFileSource::advise_mapped (samplepos_t start, samplecnt_t cnt) const
+{
+#ifndef PLATFORM_WINDOWS
+	samplepos_t const len = _length.samples ();
+
+	start = max<samplepos_t> (0, start);
+
+	if (start >= len || cnt <= 0) {
+		return;
+	}
+
+	cnt = min (cnt, len - start);
+
+	static const uintptr_t page_mask = sysconf (_SC_PAGESIZE) - 1;
+
+	size_t const    bytes_per_frame = (size_t) _bytes_per_sample * _info.channels;
+	uint8_t const*  s = _map_data + start * bytes_per_frame;
+	uint8_t const*  e = s + cnt * bytes_per_frame;
+	uint8_t*        p = reinterpret_cast<uint8_t*> (reinterpret_cast<uintptr_t> (s) & ~page_mask);
+
+	madvise (p, e - p, MADV_WILLNEED);
+#endif
+}
+
+/** Read and convert samples directly from the mapped file. All samples in
+ *  the given range must be inside the file.
+ */
+samplecnt_t
+SndFileSource::read_mapped (Sample* dst, samplepos_t start, samplecnt_t cnt) const
+{
+	/* follow the direction of playback, and hint the range that the
+	 * next read will most likely need. Its size follows the size of the
+	 * current read, which the disk-reader scales with transport speed.
+	 * A wrong guess (several readers of this source) only costs some
+	 * read-ahead.
+	 */
+	samplepos_t const last     = _map_last_read.exchange (start, std::memory_order_relaxed);
+	bool const        reversed = last >= 0 && start < last;
+
+	if (reversed) {
+		advise_mapped (start - cnt, cnt);
+	} else {
+		advise_mapped (start + cnt, cnt);
+	}
+
+	int const      nchn   = _info.channels;
+	size_t const   stride = (size_t) _bytes_per_sample * nchn;
+	uint8_t const* src    = _map_data + start * stride + _channel * _bytes_per_sample;
+
+	/* normalization is identical to libsndfile's sf_read_float() */
+
+	switch (_info.format & SF_FORMAT_SUBMASK) {
+		case SF_FORMAT_FLOAT:
+			if (nchn == 1) {
+				memcpy (dst, src, cnt * sizeof (Sample));
+			} else {
+				for (samplecnt_t n = 0; n < cnt; ++n, src += stride) {
+					memcpy (&dst[n], src, sizeof (Sample));
+				}
+			}
+			break;
+		case SF_FORMAT_PCM_16:
+			for (samplecnt_t n = 0; n < cnt; ++n, src += stride) {
+				int16_t v;
+				memcpy (&v, src, sizeof (int16_t));
+				dst[n] = v * (1.f / 0x8000);
+			}
+			break;
+		case SF_FORMAT_PCM_24:
+			for (samplecnt_t n = 0; n < cnt; ++n, src += stride) {
+				int32_t const v = (int32_t) (((uint32_t) src[0] << 8) | ((uint32_t) src[1] << 16) | ((uint32_t) src[2] << 24));
+				dst[n] = v * (1.f / 0x80000000);
+			}
+			break;
+		case SF_FORMAT_PCM_32:
+			for (samplecnt_t n = 0; n < cnt; ++n, src += stride) {
+				int32_t v;
+				memcpy (&v, src, sizeof (int32_t));
+				dst[n] = v * (1.f / 0x80000000);
+			}
+			break;
+		default:
+			assert (0);
+			return 0;
+	}
+
+	if (_gain != 1.f) {
+		for (samplecnt_t n = 0; n < cnt; ++n) {
+			dst[n] *= _gain;
+		}
+	}
+
+	return cnt;
+}
+
 samplecnt_t
 SndFileSource::write_unlocked (Sample const * data, samplecnt_t cnt)
 {
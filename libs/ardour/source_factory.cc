@@ -24,8 +24,11 @@
 #include "libardour-config.h"
 #endif
 
+#include <algorithm>
+
 #include "pbd/basename.h"
 #include "pbd/convert.h"
+#include "pbd/cpus.h"
 #include "pbd/error.h"
 
 #include "temporal/tempo.h"
@@ -62,6 +65,9 @@ bool                                       SourceFactory::peak_thread_run = fals
 
 static int active_threads = 0;
 
+/* sources whose peakfiles are currently being built, protected by peak_building_lock */
+static std::list<std::weak_ptr<AudioSource>> peaks_in_progress;
+
 static void
 peak_thread_work ()
 {
@@ -88,6 +94,7 @@ peak_thread_work ()
 		SourceFactory::files_with_peaks.pop_front ();
 		if (as) {
 			++active_threads;
+			peaks_in_progress.push_back (as);
 		}
 		SourceFactory::peak_building_lock.unlock ();
 
@@ -96,8 +103,17 @@ peak_thread_work ()
 		}
 
 		as->setup_peakfile ();
+
 		SourceFactory::peak_building_lock.lock ();
 		--active_threads;
+		for (auto i = peaks_in_progress.begin (); i != peaks_in_progress.end (); ++i) {
+			if (i->lock () == as) {
+				peaks_in_progress.erase (i);
+				break;
+			}
+		}
+		/* in case the request came too late, or no peaks had to be built */
+		as->cancel_peak_build (false);
 		SourceFactory::peak_building_lock.unlock ();
 	}
 }
@@ -117,7 +133,14 @@ SourceFactory::init ()
 		return;
 	}
 	peak_thread_run = true;
-	for (int n = 0; n < 2; ++n) {
+
+	/* Building peaks is mostly CPU bound (reading, decoding,
+	 * finding peaks), scale with the number of cores, but leave
+	 * some for the GUI and butler.
+	 */
+	int const n_threads = std::max<int> (2, std::min<int> (16, (int) PBD::hardware_concurrency () - 1));
+
+	for (int n = 0; n < n_threads; ++n) {
 		peak_thread_pool.push_back (PBD::Thread::create (&peak_thread_work, string_compose ("PeakFileBuilder-%1", n)));
 	}
 }
@@ -158,6 +181,49 @@ SourceFactory::setup_peakfile (std::shared_ptr<Source> s, bool async)
 	return 0;
 }
 
+void
+SourceFactory::prioritize_peakfile (std::shared_ptr<AudioSource> as)
+{
+	PBD::Mutex::Lock lm (peak_building_lock);
+	for (auto i = files_with_peaks.begin (); i != files_with_peaks.end (); ++i) {
+		if (i->lock () == as) {
+			files_with_peaks.splice (files_with_peaks.begin (), files_with_peaks, i);
+			break;
+		}
+	}
+}
+
+void
+SourceFactory::cancel_peakfile (std::shared_ptr<AudioSource> as)
+{
+	PBD::Mutex::Lock lm (peak_building_lock);
+	for (auto i = files_with_peaks.begin (); i != files_with_peaks.end (); ++i) {
+		if (i->lock () == as) {
+			files_with_peaks.erase (i);
+			return;
+		}
+	}
+	for (auto const& i : peaks_in_progress) {
+		if (i.lock () == as) {
+			as->cancel_peak_build ();
+			return;
+		}
+	}
+}
+
+void
+SourceFactory::cancel_peak_building ()
+{
+	PBD::Mutex::Lock lm (peak_building_lock);
+	files_with_peaks.clear ();
+	for (auto const& i : peaks_in_progress) {
+		std::shared_ptr<AudioSource> as (i.lock ());
+		if (as) {
+			as->cancel_peak_build ();
+		}
+	}
+}
+
 std::shared_ptr<Source>
 SourceFactory::createSilent (Session& s, const XMLNode& node, samplecnt_t nframes, float sr)
 {
@@ -170,7 +236,7 @@ SourceFactory::createSilent (Session& s, const XMLNode& node, samplecnt_t nframe
 }
 
 std::shared_ptr<Source>
-SourceFactory::create (Session& s, const XMLNode& node, bool defer_peaks)
+SourceFactory::create (Session& s, const XMLNode& node, bool defer_peaks, bool announce)
 {
 	DataType           type = DataType::AUDIO;
 	XMLProperty const* prop = node.property ("type");
@@ -192,7 +258,9 @@ SourceFactory::create (Session& s, const XMLNode& node, bool defer_peaks)
 
 				ap->check_for_analysis_data_on_disk ();
 
-				SourceCreated (ap);
+				if (announce) {
+					SourceCreated (ap);
+				}
 				return ap;
 
 			} catch (failed_constructor&) {
@@ -208,7 +276,9 @@ SourceFactory::create (Session& s, const XMLNode& node, bool defer_peaks)
 					throw failed_constructor ();
 				}
 				ret->check_for_analysis_data_on_disk ();
-				SourceCreated (ret);
+				if (announce) {
+					SourceCreated (ret);
+				}
 				return ret;
 			} catch (failed_constructor& err) {
 			}
@@ -224,7 +294,9 @@ SourceFactory::create (Session& s, const XMLNode& node, bool defer_peaks)
 				}
 
 				ret->check_for_analysis_data_on_disk ();
-				SourceCreated (ret);
+				if (announce) {
+					SourceCreated (ret);
+				}
 				return ret;
 			} catch (...) {
 			}
@@ -238,7 +310,9 @@ SourceFactory::create (Session& s, const XMLNode& node, bool defer_peaks)
 			std::shared_ptr<SMFSource> src (new SMFSource (s, node));
 			BOOST_MARK_SOURCE (src);
 			src->check_for_analysis_data_on_disk ();
-			SourceCreated (src);
+			if (announce) {
+				SourceCreated (src);
+			}
 			return src;
 		} catch (...) {
 		}
@@ -0,0 +1,269 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <stdlib.h>
+
+#include "pbd/compose.h"
+#include "pbd/fpu.h"
+#include "pbd/microseconds.h"
+
+#include "ardour/mix.h"
+
+#include "curve_kernels_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (CurveKernelsTest);
+
+using namespace Evoral;
+using namespace Temporal;
+
+/* relative error of the SIMD kernels vs. the portable double precision
+ * ones, see the doc-comments in x86_functions_avx.cc
+ */
+static const double max_kernel_error = 2e-7;
+
+static double
+urand (double lo, double hi)
+{
+	return lo + (hi - lo) * (rand () / (double) RAND_MAX);
+}
+
+/* compare against Curve::default_*, relative to `range', or to each
+ * sample if range is 0
+ */
+void
+CurveKernelsTest::compare (std::string const& msg, float const* test, float const* comp, uint32_t n, double range)
+{
+	for (uint32_t i = 0; i < n; ++i) {
+		const double ref = range > 0 ? range : fabs (comp[i]);
+		if (fabs (test[i] - comp[i]) > max_kernel_error * ref) {
+			CPPUNIT_FAIL (string_compose ("%1 at %2: %3 != %4", msg, i, test[i], comp[i]));
+		}
+	}
+}
+
+void
+CurveKernelsTest::run (std::string const& name)
+{
+	const uint32_t size = 2048;
+
+	float test[size + 16];
+	float comp[size + 16];
+
+	srand (17);
+
+	for (int t = 0; t < 500; ++t) {
+		/* every length up to 64 (remainder handling), then random lengths;
+		 * unaligned destination
+		 */
+		const uint32_t n  = t < 64 ? t + 1 : 1 + rand () % size;
+		float*         dt = test + (t % 16);
+		float*         dc = comp + (t % 16);
+
+		/* Linear */
+		const double v0 = urand (-1000, 1000);
+		const double v1 = (t & 1) ? urand (-1000, 1000) : urand (0, 2);
+
+		linear_ramp (dt, n, v0, (v1 - v0) / n);
+		Curve::default_linear_ramp (dc, n, v0, (v1 - v0) / n);
+		compare (string_compose ("%1 linear ramp %2 .. %3, n: %4", name, v0, v1, n), dt, dc, n, std::max (fabs (v0), fabs (v1)));
+
+		/* Logarithmic, from * (to / from) ^ fraction, 20Hz .. 20kHz */
+		const double l0 = log2 (urand (20, 20000));
+		const double l1 = log2 (urand (20, 20000));
+
+		exp2_ramp (dt, n, l0, (l1 - l0) / n);
+		Curve::default_exp2_ramp (dc, n, l0, (l1 - l0) / n);
+		compare (string_compose ("%1 exp2 ramp %2 .. %3, n: %4", name, l0, l1, n), dt, dc, n, 0);
+
+		/* Exponential, fader position 0 .. 1, including position_to_gain (0) */
+		const double p0    = (t % 4) ? urand (0, 1) : 0;
+		const double p1    = urand (0, 1);
+		const double scale = (t & 1) ? 1.0 : 2.0;
+
+		gain_ramp (dt, n, p0, (p1 - p0) / n, scale);
+		Curve::default_gain_ramp (dc, n, p0, (p1 - p0) / n, scale);
+		compare (string_compose ("%1 gain ramp %2 .. %3, n: %4", name, p0, p1, n), dt, dc, n, 0);
+	}
+}
+
+#if defined(ARCH_X86) && defined(BUILD_SSE_OPTIMIZATIONS)
+
+void
+CurveKernelsTest::avxTest ()
+{
+	PBD::FPU* fpu = PBD::FPU::instance ();
+	if (!fpu->has_avx ()) {
+		printf ("AVX is not available at run-time\n");
+		return;
+	}
+
+	linear_ramp = x86_avx_linear_ramp;
+	exp2_ramp   = x86_avx_exp2_ramp;
+	gain_ramp   = x86_avx_gain_ramp;
+
+	run ("AVX");
+}
+
+void
+CurveKernelsTest::avxFmaTest ()
+{
+	PBD::FPU* fpu = PBD::FPU::instance ();
+	if (!(fpu->has_avx () && fpu->has_fma ())) {
+		printf ("AVX and FMA is not available at run-time\n");
+		return;
+	}
+
+	linear_ramp = x86_fma_linear_ramp;
+	exp2_ramp   = x86_fma_exp2_ramp;
+	gain_ramp   = x86_fma_gain_ramp;
+
+	run ("AVX/FMA");
+}
+
+void
+CurveKernelsTest::avx512fTest ()
+{
+	PBD::FPU* fpu = PBD::FPU::instance ();
+	if (!fpu->has_avx512f ()) {
+		printf ("AVX512F is not available at run-time\n");
+		return;
+	}
+
+	linear_ramp = x86_avx512f_linear_ramp;
+	exp2_ramp   = x86_avx512f_exp2_ramp;
+	gain_ramp   = x86_avx512f_gain_ramp;
+
+	run ("AVX512F");
+}
+
+#elif defined(ARM_NEON_SUPPORT) && defined(__aarch64__)
+
+void
+CurveKernelsTest::neonTest ()
+{
+	PBD::FPU* fpu = PBD::FPU::instance ();
+	if (!fpu->has_neon ()) {
+		printf ("NEON is not available at run-time\n");
+		return;
+	}
+
+	linear_ramp = arm_neon_linear_ramp;
+	exp2_ramp   = arm_neon_exp2_ramp;
+	gain_ramp   = arm_neon_gain_ramp;
+
+	run ("NEON");
+}
+
+#endif
+
+/* automation with points every `spacing' samples, flat runs included */
+std::shared_ptr<ControlList>
+CurveKernelsTest::automation (ControlList::InterpolationStyle style, int n_points, int spacing)
+{
+	Evoral::Parameter           param (Evoral::Parameter (0));
+	Evoral::ParameterDescriptor desc;
+
+	switch (style) {
+		case ControlList::Logarithmic:
+			desc.lower = 20;
+			desc.upper = 20000;
+			break;
+		case ControlList::Exponential:
+			desc.lower = 0;
+			desc.upper = 2;
+			break;
+		default:
+			desc.lower = -1;
+			desc.upper = 1;
+			break;
+	}
+
+	std::shared_ptr<ControlList> cl (new ControlList (param, desc, TimeDomainProvider (AudioTime)));
+	cl->create_curve ();
+	cl->set_interpolation (style);
+
+	srand (17);
+	double v = 0;
+	for (int i = 0; i < n_points; ++i) {
+		if (i % 7 != 3) {
+			/* every 7th segment is flat */
+			v = desc.lower + (desc.upper - desc.lower) * (rand () / (double) RAND_MAX);
+		}
+		cl->fast_simple_add (timepos_t (i * spacing), v);
+	}
+
+	return cl;
+}
+
+/* Curve::get_vector () with the kernels that ARDOUR::init () installed
+ * for this CPU, vs. ControlList::eval ()
+ */
+void
+CurveKernelsTest::installedTest ()
+{
+	const ControlList::InterpolationStyle styles[] = { ControlList::Discrete, ControlList::Linear, ControlList::Logarithmic, ControlList::Exponential };
+	const int n_points = 100;
+	const int spacing  = 333;
+
+	float vec[1000];
+
+	for (size_t s = 0; s < sizeof (styles) / sizeof (styles[0]); ++s) {
+		std::shared_ptr<ControlList> cl = automation (styles[s], n_points, spacing);
+
+		samplepos_t pos = -500;
+		int         len = 1;
+		while (pos < n_points * spacing + 500) {
+			cl->curve ().get_vector (timepos_t (pos), timepos_t (pos + len - 1), vec, len);
+			for (int i = 0; i < len; ++i) {
+				const double expect = cl->eval (timepos_t (pos + i));
+				/* kernel error plus rounding the expected value to float */
+				CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE (string_compose ("interpolation %1 at %2 (block of %3 @ %4)", (int) styles[s], pos + i, len, pos),
+				                                      expect, vec[i], 3e-7 * std::max (1.0, fabs (expect)));
+			}
+			pos += len;
+			len = 1 + (len * 7 + 13) % 997;
+		}
+	}
+}
+
+void
+CurveKernelsTest::installedBenchmark ()
+{
+	const ControlList::InterpolationStyle styles[] = { ControlList::Discrete, ControlList::Linear, ControlList::Logarithmic, ControlList::Exponential };
+	const char* names[] = { "discrete", "linear", "logarithmic", "exponential" };
+
+	const int n_points  = 10000;
+	const int spacing   = 480;
+	const int blocksize = 1024;
+
+	float vec[blocksize];
+
+	std::cerr << "\nCurve::get_vector, " << n_points << " points, " << blocksize << " sample blocks (ns/sample: block with installed kernels, per-sample eval)\n";
+
+	for (size_t s = 0; s < sizeof (styles) / sizeof (styles[0]); ++s) {
+		std::shared_ptr<ControlList> cl = automation (styles[s], n_points, spacing);
+
+		const samplepos_t end = (samplepos_t) n_points * spacing;
+		double            sum = 0;
+
+		PBD::microseconds_t t0 = PBD::get_microseconds ();
+		for (samplepos_t pos = 0; pos < end; pos += blocksize) {
+			cl->curve ().get_vector (timepos_t (pos), timepos_t (pos + blocksize - 1), vec, blocksize);
+			sum += vec[blocksize - 1];
+		}
+		const PBD::microseconds_t t_block = PBD::get_microseconds () - t0;
+
+		t0 = PBD::get_microseconds ();
+		for (samplepos_t pos = 0; pos < end; pos += blocksize) {
+			for (int i = 0; i < blocksize; ++i) {
+				vec[i] = cl->eval (timepos_t (pos + i));
+			}
+			sum += vec[blocksize - 1];
+		}
+		const PBD::microseconds_t t_eval = PBD::get_microseconds () - t0;
+
+		CPPUNIT_ASSERT (sum != 0);
+
+		std::cerr << "  " << names[s] << ": " << t_block * 1000.0 / end << ", " << t_eval * 1000.0 / end << "\n";
+	}
+}
@@ -0,0 +1,43 @@
+#include <memory>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "evoral/ControlList.h"
+#include "evoral/Curve.h"
+
+class CurveKernelsTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (CurveKernelsTest);
+#if defined(ARCH_X86) && defined(BUILD_SSE_OPTIMIZATIONS)
+	CPPUNIT_TEST (avxTest);
+	CPPUNIT_TEST (avxFmaTest);
+	CPPUNIT_TEST (avx512fTest);
+#elif defined(ARM_NEON_SUPPORT) && defined(__aarch64__)
+	CPPUNIT_TEST (neonTest);
+#endif
+	CPPUNIT_TEST (installedTest);
+	CPPUNIT_TEST (installedBenchmark);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+#if defined(ARCH_X86) && defined(BUILD_SSE_OPTIMIZATIONS)
+	void avxTest ();
+	void avxFmaTest ();
+	void avx512fTest ();
+#elif defined(ARM_NEON_SUPPORT) && defined(__aarch64__)
+	void neonTest ();
+#endif
+	void installedTest ();
+	void installedBenchmark ();
+
+private:
+	void run (std::string const&);
+	void compare (std::string const&, float const* test, float const* comp, uint32_t n, double range);
+
+	std::shared_ptr<Evoral::ControlList> automation (Evoral::ControlList::InterpolationStyle, int n_points, int spacing);
+
+	Evoral::Curve::ramp_t      linear_ramp;
+	Evoral::Curve::ramp_t      exp2_ramp;
+	Evoral::Curve::gain_ramp_t gain_ramp;
+};
@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <vector>
+
+#include <glib.h>
+#include <glibmm/miscutils.h>
+
+#include "pbd/gstdio_compat.h"
+
+#include "ardour/peak_pyramid.h"
+
+#include "peak_pyramid_test.h"
+#include "test_util.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (PeakPyramidTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+static const samplecnt_t fpp    = 256;
+static const samplecnt_t length = 48000 * 60 * 10 + 123; // ten minutes and a bit
+
+static PeakData
+base_peak (int64_t i)
+{
+	PeakData p;
+	p.max = 0.5f + 0.5f * sinf (i * 0.001f);
+	p.min = -0.5f * p.max - (i % 7) * 0.01f;
+	return p;
+}
+
+void
+PeakPyramidTest::setUp ()
+{
+	std::string const dir = new_test_output_dir ("peak_pyramid");
+
+	_peakfile = Glib::build_filename (dir, "test.peak");
+	_pyramid  = _peakfile + ".pyr";
+
+	int64_t const n = (length + fpp - 1) / fpp;
+
+	std::ofstream f (_peakfile.c_str (), std::ios::binary | std::ios::trunc);
+	for (int64_t i = 0; i < n; ++i) {
+		PeakData p = base_peak (i);
+		f.write ((char const*)&p, sizeof (PeakData));
+	}
+}
+
+void
+PeakPyramidTest::tearDown ()
+{
+	::g_unlink (_pyramid.c_str ());
+	::g_unlink (_peakfile.c_str ());
+}
+
+void
+PeakPyramidTest::buildAndReadTest ()
+{
+	CPPUNIT_ASSERT_EQUAL (0, PeakPyramid::build (_peakfile, _pyramid, fpp, length));
+
+	PeakPyramid pp;
+	CPPUNIT_ASSERT_EQUAL (0, pp.load (_pyramid, _peakfile, fpp, length));
+	CPPUNIT_ASSERT (pp.valid ());
+
+	/* no level for resolutions finer than the first level */
+	PeakData dummy;
+	CPPUNIT_ASSERT (!pp.read (&dummy, 1, 0, fpp, fpp));
+	CPPUNIT_ASSERT_EQUAL ((samplecnt_t) 0, pp.level_fpp (fpp * PeakPyramid::factor - 1));
+
+	/* closest level at or below the requested samples per peak */
+	CPPUNIT_ASSERT_EQUAL ((samplecnt_t) fpp * 4, pp.level_fpp (fpp * 4));
+	CPPUNIT_ASSERT_EQUAL ((samplecnt_t) fpp * 16, pp.level_fpp (fpp * 60));
+	CPPUNIT_ASSERT_EQUAL ((samplecnt_t) fpp * 64, pp.level_fpp (fpp * 64));
+
+	/* visual peaks aligned to the level must match the peakfile exactly */
+	int64_t const n_base = (length + fpp - 1) / fpp;
+
+	for (int spp_level = 1; spp_level <= 4; ++spp_level) {
+		samplecnt_t const spp    = fpp * (1 << (2 * spp_level));
+		samplepos_t const start  = spp * 3;
+		samplecnt_t const npeaks = 100;
+
+		std::vector<PeakData> peaks (npeaks);
+		CPPUNIT_ASSERT (pp.read (&peaks[0], npeaks, start, npeaks * spp, spp));
+
+		for (samplecnt_t i = 0; i < npeaks; ++i) {
+			int64_t const first = (start + i * spp) / fpp;
+			int64_t const last  = std::min<int64_t> (n_base, first + spp / fpp);
+			PeakData      ref   = base_peak (first);
+			for (int64_t k = first + 1; k < last; ++k) {
+				ref.min = std::min (ref.min, base_peak (k).min);
+				ref.max = std::max (ref.max, base_peak (k).max);
+			}
+			CPPUNIT_ASSERT_EQUAL (ref.min, peaks[i].min);
+			CPPUNIT_ASSERT_EQUAL (ref.max, peaks[i].max);
+		}
+	}
+
+	/* reading past the end zero-fills */
+	std::vector<PeakData> tail (10);
+	CPPUNIT_ASSERT (pp.read (&tail[0], 10, length - 1024, 10 * 1024, 1024));
+	CPPUNIT_ASSERT (tail[0].max != 0 || tail[0].min != 0);
+	for (size_t i = 1; i < tail.size (); ++i) {
+		CPPUNIT_ASSERT_EQUAL (0.f, tail[i].max);
+		CPPUNIT_ASSERT_EQUAL (0.f, tail[i].min);
+	}
+}
+
+void
+PeakPyramidTest::staleTest ()
+{
+	PeakPyramid pp;
+
+	/* missing */
+	CPPUNIT_ASSERT (pp.load (_pyramid, _peakfile, fpp, length) != 0);
+
+	CPPUNIT_ASSERT_EQUAL (0, PeakPyramid::build (_peakfile, _pyramid, fpp, length));
+
+	/* built for different parameters */
+	CPPUNIT_ASSERT (pp.load (_pyramid, _peakfile, fpp, length + fpp) != 0);
+	CPPUNIT_ASSERT (!pp.valid ());
+	CPPUNIT_ASSERT (pp.load (_pyramid, _peakfile, fpp * 2, length) != 0);
+
+	/* the peakfile changed */
+	{
+		std::ofstream f (_peakfile.c_str (), std::ios::binary | std::ios::app);
+		PeakData p = base_peak (0);
+		f.write ((char const*)&p, sizeof (PeakData));
+	}
+	CPPUNIT_ASSERT (pp.load (_pyramid, _peakfile, fpp, length) != 0);
+	CPPUNIT_ASSERT (!pp.valid ());
+}
@@ -0,0 +1,21 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class PeakPyramidTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (PeakPyramidTest);
+	CPPUNIT_TEST (buildAndReadTest);
+	CPPUNIT_TEST (staleTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp ();
+	void tearDown ();
+
+	void buildAndReadTest ();
+	void staleTest ();
+
+private:
+	std::string _peakfile;
+	std::string _pyramid;
+};
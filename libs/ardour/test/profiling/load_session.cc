@@ -1,21 +1,38 @@
 #include "test_ui.h"
 #include "test_util.h"
 #include "pbd/failed_constructor.h"
+#include "pbd/timing.h"
 #include "ardour/ardour.h"
 #include "ardour/audioengine.h"
 #include "ardour/session.h"
 #include <iostream>
 #include <cstdlib>
+#include <vector>
+#ifndef PLATFORM_WINDOWS
+#include <sys/resource.h>
+#endif
 
 using namespace std;
 using namespace ARDOUR;
 
 static const char* localedir = LOCALEDIR;
 
+static long
+peak_rss_kb ()
+{
+#ifndef PLATFORM_WINDOWS
+	struct rusage ru;
+	if (getrusage (RUSAGE_SELF, &ru) == 0) {
+		return ru.ru_maxrss;
+	}
+#endif
+	return -1;
+}
+
 int main (int argc, char* argv[])
 {
-	if (argc != 3) {
-		cerr << "Syntax: " << argv[0] << " <dir> <snapshot-name>\n";
+	if (argc != 3 && argc != 4) {
+		cerr << "Syntax: " << argv[0] << " <dir> <snapshot-name> [save-count]\n";
 		exit (EXIT_FAILURE);
 	}
 
@@ -41,6 +58,23 @@ int main (int argc, char* argv[])
 		exit (EXIT_FAILURE);
 	}
 
+	if (argc == 4) {
+		/* time repeated saves of the loaded snapshot */
+		int const n = atoi (argv[3]);
+		long const rss = peak_rss_kb ();
+		std::vector<PBD::microseconds_t> times;
+
+		for (int i = 0; i < n; ++i) {
+			PBD::Timing timing;
+			s->save_state ("");
+			timing.update ();
+			times.push_back (timing.elapsed ());
+		}
+
+		cout << "save: " << PBD::timing_summary (times);
+		cout << "peak RSS: " << rss << " kB after load, " << peak_rss_kb () << " kB after save\n";
+	}
+
 	AudioEngine::instance()->remove_session ();
 	delete s;
 	AudioEngine::instance()->stop ();
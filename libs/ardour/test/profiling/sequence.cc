@@ -0,0 +1,100 @@
+#include <cstdlib>
+#include <iostream>
+
+#include "pbd/microseconds.h"
+
+#include "temporal/beats.h"
+
+#include "evoral/Control.h"
+#include "evoral/ControlList.h"
+#include "evoral/Event.h"
+#include "evoral/Sequence.h"
+#include "evoral/midi_events.h"
+
+#include "ardour/event_type_map.h"
+
+using namespace std;
+using namespace ARDOUR;
+
+typedef Temporal::Beats        Time;
+typedef Evoral::Sequence<Time> Sequence;
+
+class BenchSequence : public Sequence
+{
+public:
+	BenchSequence () : Sequence (EventTypeMap::instance ()) {}
+	BenchSequence (BenchSequence const & other) : Evoral::ControlSet (other), Sequence (other) {}
+
+	std::shared_ptr<Evoral::Control> control_factory (Evoral::Parameter const & param) {
+		Evoral::ParameterDescriptor desc;
+		std::shared_ptr<Evoral::ControlList> list (new Evoral::ControlList (param, desc, Temporal::TimeDomainProvider (Temporal::BeatTime)));
+		return std::shared_ptr<Evoral::Control> (new Evoral::Control (param, desc, list));
+	}
+};
+
+/* Load, iterate, seek in and copy a sequence of many notes */
+int
+main (int argc, char* argv[])
+{
+	int const n_notes = argc > 1 ? atoi (argv[1]) : 100000;
+	int const n_seeks = 10000;
+
+	if (n_notes < 4) {
+		cerr << "Syntax: " << argv[0] << " [note-count]\n";
+		exit (EXIT_FAILURE);
+	}
+
+	BenchSequence s;
+	Evoral::event_id_t id = 0;
+
+	/* write events the way a file is loaded */
+	PBD::microseconds_t t0 = PBD::get_microseconds ();
+	s.start_write ();
+	for (int n = 0; n < n_notes; ++n) {
+		uint8_t const pitch = 24 + (n * 7) % 80;
+		uint8_t buf[3] = { (uint8_t) (MIDI_CMD_NOTE_ON | (n % 16)), pitch, 100 };
+		s.append (Evoral::Event<Time> (Evoral::MIDI_EVENT, Time (n / 4, (n % 4) * (Temporal::ticks_per_beat / 4)), 3, buf), ++id);
+		buf[0] = MIDI_CMD_NOTE_OFF | (n % 16);
+		s.append (Evoral::Event<Time> (Evoral::MIDI_EVENT, Time (n / 4 + 1, 0), 3, buf), ++id);
+	}
+	s.end_write (Sequence::Relax);
+	PBD::microseconds_t const t_load = PBD::get_microseconds () - t0;
+
+	t0 = PBD::get_microseconds ();
+	size_t n_events = 0;
+	for (Sequence::const_iterator i = s.begin (); i != s.end (); ++i) {
+		++n_events;
+	}
+	PBD::microseconds_t const t_iter = PBD::get_microseconds () - t0;
+
+	srand (42);
+	t0 = PBD::get_microseconds ();
+	size_t n_found = 0;
+	for (int n = 0; n < n_seeks; ++n) {
+		Time const t (rand () % (n_notes / 4), 0);
+		Sequence::Notes::const_iterator i = s.note_lower_bound (t);
+		if (i != s.notes ().end () && s.contains (*i)) {
+			++n_found;
+		}
+	}
+	PBD::microseconds_t const t_seek = PBD::get_microseconds () - t0;
+
+	t0 = PBD::get_microseconds ();
+	BenchSequence copy (s);
+	PBD::microseconds_t const t_copy = PBD::get_microseconds () - t0;
+
+	t0 = PBD::get_microseconds ();
+	s.clear ();
+	copy.clear ();
+	PBD::microseconds_t const t_clear = PBD::get_microseconds () - t0;
+
+	cout << "Sequence with " << n_notes << " notes, " << n_events << " events:"
+	     << "\n  load:    " << t_load / 1000.0 << " ms"
+	     << "\n  iterate: " << t_iter / 1000.0 << " ms"
+	     << "\n  " << n_seeks << " x seek+lookup (" << n_found << " found): " << t_seek / 1000.0 << " ms"
+	     << "\n  copy:    " << t_copy / 1000.0 << " ms"
+	     << "\n  clear:   " << t_clear / 1000.0 << " ms"
+	     << "\n";
+
+	return 0;
+}
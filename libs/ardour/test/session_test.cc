@@ -1,13 +1,17 @@
 
 #include <glibmm/fileutils.h>
 #include <glibmm/miscutils.h>
+#include <glibmm/timer.h>
 
+#include <atomic>
 #include <stdexcept>
 
 #include "pbd/textreceiver.h"
 #include "pbd/file_utils.h"
+#include "pbd/xml++.h"
 #include "ardour/session.h"
 #include "ardour/audioengine.h"
+#include "ardour/filename_extensions.h"
 #include "ardour/smf_source.h"
 #include "ardour/midi_model.h"
 
@@ -150,3 +154,44 @@ SessionTest::open_session_utf8_path ()
 	}
 
 }
+
+void
+SessionTest::async_pending_save ()
+{
+	const string session_name("async_save");
+	std::string new_session_dir = Glib::build_filename (new_test_output_dir(), session_name);
+
+	create_and_start_dummy_backend ();
+
+	ARDOUR::Session* session = load_session (new_session_dir, session_name);
+	CPPUNIT_ASSERT (session);
+
+	std::atomic<int> done (0);
+	std::atomic<int> result (-1);
+	PBD::ScopedConnection c;
+	session->PendingStateSaved.connect_same_thread (c, [&] (int rv) { result = rv; done = 1; });
+
+	const std::string pending_path = Glib::build_filename (new_session_dir, session_name + pending_suffix);
+	CPPUNIT_ASSERT (!Glib::file_test (pending_path, Glib::FILE_TEST_EXISTS));
+
+	CPPUNIT_ASSERT_EQUAL (0, session->save_pending_state_async ());
+
+	for (int i = 0; i < 1000 && !done.load (); ++i) {
+		Glib::usleep (10000);
+	}
+
+	CPPUNIT_ASSERT (done.load ());
+	CPPUNIT_ASSERT_EQUAL (0, result.load ());
+
+	/* the file is complete and valid once the signal was emitted */
+	XMLTree tree;
+	CPPUNIT_ASSERT (tree.read (pending_path));
+	CPPUNIT_ASSERT_EQUAL (std::string ("Session"), tree.root ()->name ());
+
+	/* a regular save removes the pending state */
+	CPPUNIT_ASSERT_EQUAL (0, session->save_state (""));
+	CPPUNIT_ASSERT (!Glib::file_test (pending_path, Glib::FILE_TEST_EXISTS));
+
+	delete session;
+	stop_and_destroy_backend ();
+}
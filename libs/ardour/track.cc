@@ -620,12 +620,48 @@ Track::capture_buffer_load () const
 	return _disk_writer->buffer_load ();
 }
 
+samplecnt_t
+Track::playback_underrun_margin () const
+{
+	return _disk_reader->underrun_margin ();
+}
+
+samplecnt_t
+Track::playback_refill_space () const
+{
+	return _disk_reader->refill_space ();
+}
+
+void
+Track::record_playback_underrun_margin (samplecnt_t margin)
+{
+	_disk_reader->record_underrun_margin (margin);
+}
+
+bool
+Track::get_playback_margin_stats (samplecnt_t& min, double& avg, uint32_t& n_underruns) const
+{
+	return _disk_reader->get_underrun_margin_stats (min, avg, n_underruns);
+}
+
+void
+Track::reset_playback_margin_stats ()
+{
+	_disk_reader->reset_underrun_margin_stats ();
+}
+
 int
 Track::do_refill ()
 {
 	return _disk_reader->do_refill ();
 }
 
+void
+Track::do_prefetch ()
+{
+	_disk_reader->do_prefetch ();
+}
+
 int
 Track::do_flush (RunContext c, bool force)
 {
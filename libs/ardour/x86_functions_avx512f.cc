@@ -18,6 +18,8 @@
  */
 #ifdef FPU_AVX512F_SUPPORT
 
+#include "pbd/control_math.h"
+
 #include "ardour/mix.h"
 
 #include <immintrin.h>
@@ -1146,4 +1148,173 @@ x86_avx512f_copy_vector(float *dst, const float *src, uint32_t nframes)
 	_mm256_zeroupper(); // zeros the upper portion of YMM register
 }
 
+
+/* pack 2 x 8 doubles into 16 floats */
+static inline __m512
+avx512f_cvtpd_ps (__m512d x0, __m512d x1)
+{
+	return _mm512_castpd_ps (_mm512_insertf64x4 (_mm512_castps_pd (_mm512_castps256_ps512 (_mm512_cvtpd_ps (x0))), _mm256_castps_pd (_mm512_cvtpd_ps (x1)), 1));
+}
+
+/**
+ * @brief 2^x for 2 x 8 doubles, as 16 floats
+ *
+ * 2^x = 2^n * 2^f with n = round (x) and |f| <= 0.5. The split is done in
+ * double precision, only 2^f is evaluated in single precision, by its
+ * Taylor series to degree 7. Relative error < 1e-7, x is clamped to
+ * [-126, 126].
+ */
+static inline __m512
+avx512f_exp2 (__m512d x0, __m512d x1)
+{
+	const __m512d lo = _mm512_set1_pd (-126.);
+	const __m512d hi = _mm512_set1_pd (126.);
+
+	x0 = _mm512_min_pd (_mm512_max_pd (x0, lo), hi);
+	x1 = _mm512_min_pd (_mm512_max_pd (x1, lo), hi);
+
+	const __m512d n0 = _mm512_roundscale_pd (x0, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+	const __m512d n1 = _mm512_roundscale_pd (x1, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+	const __m512  f  = avx512f_cvtpd_ps (_mm512_sub_pd (x0, n0), _mm512_sub_pd (x1, n1));
+
+	__m512 p = _mm512_set1_ps (1.5252734e-5f);
+	p = _mm512_fmadd_ps (p, f, _mm512_set1_ps (1.5403530e-4f));
+	p = _mm512_fmadd_ps (p, f, _mm512_set1_ps (1.3333558e-3f));
+	p = _mm512_fmadd_ps (p, f, _mm512_set1_ps (9.6181291e-3f));
+	p = _mm512_fmadd_ps (p, f, _mm512_set1_ps (5.5504109e-2f));
+	p = _mm512_fmadd_ps (p, f, _mm512_set1_ps (2.4022651e-1f));
+	p = _mm512_fmadd_ps (p, f, _mm512_set1_ps (6.9314718e-1f));
+	p = _mm512_fmadd_ps (p, f, _mm512_set1_ps (1.f));
+
+	const __m512i n = _mm512_inserti64x4 (_mm512_castsi256_si512 (_mm512_cvtpd_epi32 (n0)), _mm512_cvtpd_epi32 (n1), 1);
+	const __m512i e = _mm512_slli_epi32 (_mm512_add_epi32 (n, _mm512_set1_epi32 (127)), 23);
+
+	return _mm512_mul_ps (p, _mm512_castsi512_ps (e));
+}
+
+/**
+ * @brief x86-64 AVX-512F optimized linear ramp, dst[i] = start + i * step
+ *
+ * The ramp is computed in double precision, the result is rounded
+ * once to float. The remainder is handled with a masked store.
+ *
+ * @param[out] dst Pointer to destination buffer
+ * @param nframes Number of samples to process
+ * @param start Value of the first sample
+ * @param step Increment per sample
+ */
+void
+x86_avx512f_linear_ramp (float* dst, uint32_t nframes, double start, double step)
+{
+	const __m512d s0  = _mm512_set1_pd (start);
+	const __m512d d0  = _mm512_set1_pd (step);
+	const __m512d d16 = _mm512_set1_pd (16.);
+
+	__m512d  i0 = _mm512_setr_pd (0., 1., 2., 3., 4., 5., 6., 7.);
+	__m512d  i1 = _mm512_setr_pd (8., 9., 10., 11., 12., 13., 14., 15.);
+	uint32_t i  = 0;
+
+	for (; i + 16 <= nframes; i += 16) {
+		_mm512_storeu_ps (dst + i, avx512f_cvtpd_ps (_mm512_fmadd_pd (i0, d0, s0), _mm512_fmadd_pd (i1, d0, s0)));
+
+		i0 = _mm512_add_pd (i0, d16);
+		i1 = _mm512_add_pd (i1, d16);
+	}
+
+	if (i < nframes) {
+		const __mmask16 m = (__mmask16) ((1u << (nframes - i)) - 1);
+		_mm512_mask_storeu_ps (dst + i, m, avx512f_cvtpd_ps (_mm512_fmadd_pd (i0, d0, s0), _mm512_fmadd_pd (i1, d0, s0)));
+	}
+
+	_mm256_zeroupper ();
+}
+
+/**
+ * @brief x86-64 AVX-512F optimized exponential ramp, dst[i] = 2^(start + i * step)
+ *
+ * Relative error < 2e-7.
+ */
+void
+x86_avx512f_exp2_ramp (float* dst, uint32_t nframes, double start, double step)
+{
+	const __m512d s0  = _mm512_set1_pd (start);
+	const __m512d d0  = _mm512_set1_pd (step);
+	const __m512d d16 = _mm512_set1_pd (16.);
+
+	__m512d  i0 = _mm512_setr_pd (0., 1., 2., 3., 4., 5., 6., 7.);
+	__m512d  i1 = _mm512_setr_pd (8., 9., 10., 11., 12., 13., 14., 15.);
+	uint32_t i  = 0;
+
+	for (; i + 16 <= nframes; i += 16) {
+		_mm512_storeu_ps (dst + i, avx512f_exp2 (_mm512_fmadd_pd (i0, d0, s0), _mm512_fmadd_pd (i1, d0, s0)));
+
+		i0 = _mm512_add_pd (i0, d16);
+		i1 = _mm512_add_pd (i1, d16);
+	}
+
+	if (i < nframes) {
+		const __mmask16 m = (__mmask16) ((1u << (nframes - i)) - 1);
+		_mm512_mask_storeu_ps (dst + i, m, avx512f_exp2 (_mm512_fmadd_pd (i0, d0, s0), _mm512_fmadd_pd (i1, d0, s0)));
+	}
+
+	_mm256_zeroupper ();
+}
+
+/* 33 * p^(1/8) - 32, the exponent of position_to_gain (p) */
+static inline __m512d
+avx512f_gain_exponent (__m512d p)
+{
+	p = _mm512_max_pd (p, _mm512_setzero_pd ());
+
+	const __m512d q = _mm512_sqrt_pd (_mm512_sqrt_pd (_mm512_sqrt_pd (p)));
+
+	return _mm512_fmsub_pd (q, _mm512_set1_pd (33.), _mm512_set1_pd (32.));
+}
+
+/* position_to_gain (p) * scale for 2 x 8 positions */
+static inline __m512
+avx512f_position_to_gain (__m512d p0, __m512d p1, __m512d scale)
+{
+	const __m512d zero = _mm512_setzero_pd ();
+
+	/* position_to_gain (0) == 0, scale is 0 there */
+	const __m512 g = avx512f_cvtpd_ps (_mm512_maskz_mov_pd (_mm512_cmp_pd_mask (p0, zero, _CMP_GT_OQ), scale),
+	                                   _mm512_maskz_mov_pd (_mm512_cmp_pd_mask (p1, zero, _CMP_GT_OQ), scale));
+
+	return _mm512_mul_ps (avx512f_exp2 (avx512f_gain_exponent (p0), avx512f_gain_exponent (p1)), g);
+}
+
+/**
+ * @brief x86-64 AVX-512F optimized gain ramp,
+ * dst[i] = position_to_gain (start + i * step) * scale
+ *
+ * The exponent is computed in double precision. Relative error < 2e-7.
+ */
+void
+x86_avx512f_gain_ramp (float* dst, uint32_t nframes, double start, double step, double scale)
+{
+	const __m512d s0  = _mm512_set1_pd (start);
+	const __m512d d0  = _mm512_set1_pd (step);
+	const __m512d d16 = _mm512_set1_pd (16.);
+	const __m512d g0  = _mm512_set1_pd (scale);
+
+	__m512d  i0 = _mm512_setr_pd (0., 1., 2., 3., 4., 5., 6., 7.);
+	__m512d  i1 = _mm512_setr_pd (8., 9., 10., 11., 12., 13., 14., 15.);
+	uint32_t i  = 0;
+
+	for (; i + 16 <= nframes; i += 16) {
+		_mm512_storeu_ps (dst + i, avx512f_position_to_gain (_mm512_fmadd_pd (i0, d0, s0), _mm512_fmadd_pd (i1, d0, s0), g0));
+
+		i0 = _mm512_add_pd (i0, d16);
+		i1 = _mm512_add_pd (i1, d16);
+	}
+
+	if (i < nframes) {
+		const __mmask16 m = (__mmask16) ((1u << (nframes - i)) - 1);
+		_mm512_mask_storeu_ps (dst + i, m, avx512f_position_to_gain (_mm512_fmadd_pd (i0, d0, s0), _mm512_fmadd_pd (i1, d0, s0), g0));
+	}
+
+	_mm256_zeroupper ();
+}
+
 #endif // FPU_AVX512F_SUPPORT
@@ -19,6 +19,8 @@
 
 #ifdef FPU_AVX_FMA_SUPPORT
 
+#include "pbd/control_math.h"
+
 #include "ardour/mix.h"
 
 #include <immintrin.h>
@@ -138,4 +140,165 @@ x86_fma_mix_buffers_with_gain(
 	} while (0);
 }
 
+
+/* pack 2 x 4 doubles into 8 floats */
+static inline __m256
+fma_cvtpd_ps (__m256d x0, __m256d x1)
+{
+	return _mm256_insertf128_ps (_mm256_castps128_ps256 (_mm256_cvtpd_ps (x0)), _mm256_cvtpd_ps (x1), 1);
+}
+
+/**
+ * @brief 2^x for 2 x 4 doubles, as 8 floats
+ *
+ * Same as avx_exp2 (), 2^f for |f| <= 0.5 is evaluated with FMA.
+ * Relative error < 1e-7, x is clamped to [-126, 126].
+ */
+static inline __m256
+fma_exp2 (__m256d x0, __m256d x1)
+{
+	const __m256d lo = _mm256_set1_pd (-126.);
+	const __m256d hi = _mm256_set1_pd (126.);
+
+	x0 = _mm256_min_pd (_mm256_max_pd (x0, lo), hi);
+	x1 = _mm256_min_pd (_mm256_max_pd (x1, lo), hi);
+
+	const __m256d n0 = _mm256_round_pd (x0, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+	const __m256d n1 = _mm256_round_pd (x1, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+	const __m256  f  = fma_cvtpd_ps (_mm256_sub_pd (x0, n0), _mm256_sub_pd (x1, n1));
+
+	__m256 p = _mm256_set1_ps (1.5252734e-5f);
+	p = _mm256_fmadd_ps (p, f, _mm256_set1_ps (1.5403530e-4f));
+	p = _mm256_fmadd_ps (p, f, _mm256_set1_ps (1.3333558e-3f));
+	p = _mm256_fmadd_ps (p, f, _mm256_set1_ps (9.6181291e-3f));
+	p = _mm256_fmadd_ps (p, f, _mm256_set1_ps (5.5504109e-2f));
+	p = _mm256_fmadd_ps (p, f, _mm256_set1_ps (2.4022651e-1f));
+	p = _mm256_fmadd_ps (p, f, _mm256_set1_ps (6.9314718e-1f));
+	p = _mm256_fmadd_ps (p, f, _mm256_set1_ps (1.f));
+
+	/* no AVX2 here, assemble 2^n from two 128 bit halves */
+	const __m128i e0 = _mm_slli_epi32 (_mm_add_epi32 (_mm256_cvtpd_epi32 (n0), _mm_set1_epi32 (127)), 23);
+	const __m128i e1 = _mm_slli_epi32 (_mm_add_epi32 (_mm256_cvtpd_epi32 (n1), _mm_set1_epi32 (127)), 23);
+
+	return _mm256_mul_ps (p, _mm256_castsi256_ps (_mm256_insertf128_si256 (_mm256_castsi128_si256 (e0), e1, 1)));
+}
+
+/* 33 * p^(1/8) - 32, the exponent of position_to_gain (p) */
+static inline __m256d
+fma_gain_exponent (__m256d p)
+{
+	p = _mm256_max_pd (p, _mm256_setzero_pd ());
+
+	const __m256d q = _mm256_sqrt_pd (_mm256_sqrt_pd (_mm256_sqrt_pd (p)));
+
+	return _mm256_fmsub_pd (q, _mm256_set1_pd (33.), _mm256_set1_pd (32.));
+}
+
+/**
+ * @brief x86-64 AVX/FMA optimized linear ramp, dst[i] = start + i * step
+ *
+ * The ramp is computed in double precision, the result is rounded
+ * once to float.
+ *
+ * @param[out] dst Pointer to destination buffer
+ * @param nframes Number of samples to process
+ * @param start Value of the first sample
+ * @param step Increment per sample
+ */
+void
+x86_fma_linear_ramp (float* dst, uint32_t nframes, double start, double step)
+{
+	const __m256d s0 = _mm256_set1_pd (start);
+	const __m256d d0 = _mm256_set1_pd (step);
+	const __m256d d8 = _mm256_set1_pd (8.);
+
+	__m256d  i0 = _mm256_setr_pd (0., 1., 2., 3.);
+	__m256d  i1 = _mm256_setr_pd (4., 5., 6., 7.);
+	uint32_t i  = 0;
+
+	for (; i + 8 <= nframes; i += 8) {
+		_mm256_storeu_ps (dst + i, fma_cvtpd_ps (_mm256_fmadd_pd (i0, d0, s0), _mm256_fmadd_pd (i1, d0, s0)));
+
+		i0 = _mm256_add_pd (i0, d8);
+		i1 = _mm256_add_pd (i1, d8);
+	}
+
+	for (; i < nframes; ++i) {
+		dst[i] = start + i * step;
+	}
+
+	_mm256_zeroupper ();
+}
+
+/**
+ * @brief x86-64 AVX/FMA optimized exponential ramp, dst[i] = 2^(start + i * step)
+ *
+ * Used for logarithmic interpolation. Relative error < 2e-7.
+ */
+void
+x86_fma_exp2_ramp (float* dst, uint32_t nframes, double start, double step)
+{
+	const __m256d s0 = _mm256_set1_pd (start);
+	const __m256d d0 = _mm256_set1_pd (step);
+	const __m256d d8 = _mm256_set1_pd (8.);
+
+	__m256d  i0 = _mm256_setr_pd (0., 1., 2., 3.);
+	__m256d  i1 = _mm256_setr_pd (4., 5., 6., 7.);
+	uint32_t i  = 0;
+
+	for (; i + 8 <= nframes; i += 8) {
+		_mm256_storeu_ps (dst + i, fma_exp2 (_mm256_fmadd_pd (i0, d0, s0), _mm256_fmadd_pd (i1, d0, s0)));
+
+		i0 = _mm256_add_pd (i0, d8);
+		i1 = _mm256_add_pd (i1, d8);
+	}
+
+	for (; i < nframes; ++i) {
+		dst[i] = exp2 (start + i * step);
+	}
+
+	_mm256_zeroupper ();
+}
+
+/**
+ * @brief x86-64 AVX/FMA optimized gain ramp,
+ * dst[i] = position_to_gain (start + i * step) * scale
+ *
+ * position_to_gain (p) = 2^(33 * p^(1/8) - 32), the exponent is computed
+ * in double precision. Relative error < 2e-7.
+ */
+void
+x86_fma_gain_ramp (float* dst, uint32_t nframes, double start, double step, double scale)
+{
+	const __m256d s0   = _mm256_set1_pd (start);
+	const __m256d d0   = _mm256_set1_pd (step);
+	const __m256d d8   = _mm256_set1_pd (8.);
+	const __m256d g0   = _mm256_set1_pd (scale);
+	const __m256d zero = _mm256_setzero_pd ();
+
+	__m256d  i0 = _mm256_setr_pd (0., 1., 2., 3.);
+	__m256d  i1 = _mm256_setr_pd (4., 5., 6., 7.);
+	uint32_t i  = 0;
+
+	for (; i + 8 <= nframes; i += 8) {
+		const __m256d p0 = _mm256_fmadd_pd (i0, d0, s0);
+		const __m256d p1 = _mm256_fmadd_pd (i1, d0, s0);
+
+		/* position_to_gain (0) == 0, scale is 0 there */
+		const __m256 g = fma_cvtpd_ps (_mm256_and_pd (g0, _mm256_cmp_pd (p0, zero, _CMP_GT_OQ)),
+		                               _mm256_and_pd (g0, _mm256_cmp_pd (p1, zero, _CMP_GT_OQ)));
+
+		_mm256_storeu_ps (dst + i, _mm256_mul_ps (fma_exp2 (fma_gain_exponent (p0), fma_gain_exponent (p1)), g));
+
+		i0 = _mm256_add_pd (i0, d8);
+		i1 = _mm256_add_pd (i1, d8);
+	}
+
+	for (; i < nframes; ++i) {
+		dst[i] = position_to_gain (start + i * step) * scale;
+	}
+
+	_mm256_zeroupper ();
+}
+
 #endif // FPU_AVX_FMA_SUPPORT
@@ -36,6 +36,7 @@
 #include "ardour/debug.h"
 #include "ardour/filesystem_paths.h"
 #include "ardour/port_manager.h"
+#include "ardour/runtime_functions.h"
 #include "ardouralsautil/devicelist.h"
 #include "pbd/i18n.h"
 
@@ -2258,23 +2259,23 @@ void*
 AlsaAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		std::set<BackendPortPtr>::const_iterator it = connections.begin ();
-		if (it == connections.end ()) {
+		std::shared_ptr<PortList const> connections = rt_connections ();
+		PortList::const_iterator         it          = connections->begin ();
+		if (it == connections->end ()) {
 			memset (_buffer, 0, n_samples * sizeof (Sample));
-		} else {
-			std::shared_ptr<const AlsaAudioPort> source = std::dynamic_pointer_cast<const AlsaAudioPort> (*it);
-			assert (source && source->is_output ());
-			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != connections.end ()) {
-				source = std::dynamic_pointer_cast<const AlsaAudioPort> (*it);
-				assert (source && source->is_output ());
-				Sample*       dst = buffer ();
-				const Sample* src = source->const_buffer ();
-				for (uint32_t s = 0; s < n_samples; ++s, ++dst, ++src) {
-					*dst += *src;
-				}
-			}
+			return _buffer;
+		}
+		AlsaAudioPort const* source = static_cast<AlsaAudioPort const*> (*it);
+		assert (source->is_output ());
+		if (connections->size () == 1 && !is_physical ()) {
+			/* read-only, use the source's buffer directly */
+			return const_cast<Sample*> (source->const_buffer ());
+		}
+		memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
+		while (++it != connections->end ()) {
+			source = static_cast<AlsaAudioPort const*> (*it);
+			assert (source->is_output ());
+			mix_buffers_no_gain (_buffer, source->const_buffer (), n_samples);
 		}
 	}
 	return _buffer;
@@ -2309,11 +2310,11 @@ void* AlsaMidiPort::get_buffer (pframes_t /* nframes */)
 {
 	if (is_input ()) {
 		(_buffer[_bufperiod]).clear ();
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		for (std::set<BackendPortPtr>::const_iterator i = connections.begin ();
-		     i != connections.end ();
+		std::shared_ptr<PortList const> connections = rt_connections ();
+		for (PortList::const_iterator i = connections->begin ();
+		     i != connections->end ();
 		     ++i) {
-			const AlsaMidiBuffer* src = std::dynamic_pointer_cast<const AlsaMidiPort> (*i)->const_buffer ();
+			const AlsaMidiBuffer* src = static_cast<AlsaMidiPort const*> (*i)->const_buffer ();
 			for (AlsaMidiBuffer::const_iterator it = src->begin (); it != src->end (); ++it) {
 				(_buffer[_bufperiod]).push_back (*it);
 			}
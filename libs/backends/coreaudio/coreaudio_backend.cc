@@ -34,6 +34,7 @@
 #include "ardour/debug.h"
 #include "ardour/filesystem_paths.h"
 #include "ardour/port_manager.h"
+#include "ardour/runtime_functions.h"
 #include "pbd/i18n.h"
 
 using namespace ARDOUR;
@@ -1606,23 +1607,23 @@ void*
 CoreAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		std::set<BackendPortPtr>::const_iterator it = connections.begin ();
-		if (it == connections.end ()) {
+		std::shared_ptr<PortList const> connections = rt_connections ();
+		PortList::const_iterator it = connections->begin ();
+		if (it == connections->end ()) {
 			memset (_buffer, 0, n_samples * sizeof (Sample));
-		} else {
-			std::shared_ptr<const CoreAudioPort> source = std::dynamic_pointer_cast<const CoreAudioPort>(*it);
-			assert (source && source->is_output ());
-			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != connections.end ()) {
-				source = std::dynamic_pointer_cast<const CoreAudioPort>(*it);
-				assert (source && source->is_output ());
-				Sample* dst = buffer ();
-				const Sample* src = source->const_buffer ();
-				for (uint32_t s = 0; s < n_samples; ++s, ++dst, ++src) {
-					*dst += *src;
-				}
-			}
+			return _buffer;
+		}
+		CoreAudioPort const* source = static_cast<CoreAudioPort const*>(*it);
+		assert (source->is_output ());
+		if (connections->size () == 1 && !is_physical ()) {
+			/* read-only, use the source's buffer directly */
+			return const_cast<Sample*> (source->const_buffer ());
+		}
+		memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
+		while (++it != connections->end ()) {
+			source = static_cast<CoreAudioPort const*>(*it);
+			assert (source->is_output ());
+			mix_buffers_no_gain (_buffer, source->const_buffer (), n_samples);
 		}
 	}
 	return _buffer;
@@ -1660,11 +1661,11 @@ void* CoreMidiPort::get_buffer (pframes_t /* nframes */)
 {
 	if (is_input ()) {
 		(_buffer[_bufperiod]).clear ();
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		for (std::set<BackendPortPtr>::const_iterator i = connections.begin ();
-		     i != connections.end ();
+		std::shared_ptr<PortList const> connections = rt_connections ();
+		for (PortList::const_iterator i = connections->begin ();
+		     i != connections->end ();
 		     ++i) {
-			const CoreMidiBuffer * src = std::dynamic_pointer_cast<const CoreMidiPort>(*i)->const_buffer ();
+			const CoreMidiBuffer * src = static_cast<CoreMidiPort const*>(*i)->const_buffer ();
 			for (CoreMidiBuffer::const_iterator it = src->begin (); it != src->end (); ++it) {
 				(_buffer[_bufperiod]).push_back (*it);
 			}
@@ -19,8 +19,12 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <cinttypes>
 #include <cmath>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <ctime>
 
 #include <glibmm.h>
 
@@ -38,10 +42,12 @@
 
 #include "pbd/error.h"
 #include "pbd/compose.h"
+#include "pbd/gstdio_compat.h"
 #include "pbd/pthread_utils.h"
 
 #include "ardour/debug.h"
 #include "ardour/port_manager.h"
+#include "ardour/runtime_functions.h"
 
 #include "pbd/i18n.h"
 
@@ -81,9 +87,13 @@ DummyAudioBackend::DummyAudioBackend (AudioEngine& e, AudioBackendInfo& info)
 	, _systemic_input_latency (0)
 	, _systemic_output_latency (0)
 	, _processed_samples (0)
+	, _bench (false)
+	, _bench_start (0)
+	, _bench_dropped (0)
 {
 	_instance_name = s_instance_name;
 	_device = _("Silence");
+	pthread_mutex_init (&_threads_lock, 0);
 
 	if (_driver_speed.empty()) {
 		_driver_speed.push_back (DriverSpeed (_("Half Speed"),   2.0f));
@@ -95,6 +105,8 @@ DummyAudioBackend::DummyAudioBackend (AudioEngine& e, AudioBackendInfo& info)
 		_driver_speed.push_back (DriverSpeed (_("15x Speed"),    0.06666f));
 		_driver_speed.push_back (DriverSpeed (_("20x Speed"),    0.05f));
 		_driver_speed.push_back (DriverSpeed (_("50x Speed"),    0.02f));
+		/* untranslated, hardour --bench selects it by name */
+		_driver_speed.push_back (DriverSpeed (X_("Benchmark"),   0.0f));
 	}
 
 }
@@ -102,6 +114,7 @@ DummyAudioBackend::DummyAudioBackend (AudioEngine& e, AudioBackendInfo& info)
 DummyAudioBackend::~DummyAudioBackend ()
 {
 	clear_ports ();
+	pthread_mutex_destroy (&_threads_lock);
 }
 
 /* AUDIOBACKEND API */
@@ -220,6 +233,9 @@ DummyAudioBackend::set_driver (const std::string& d)
 {
 	for (std::vector<DriverSpeed>::const_iterator it = _driver_speed.begin () ; it != _driver_speed.end (); ++it) {
 		if (d == it->name) {
+			if (it->speedup == 0) {
+				bench_reserve ();
+			}
 			_speedup = it->speedup;
 			_realtime = it->realtime;
 			return 0;
@@ -537,7 +553,9 @@ DummyAudioBackend::create_process_thread (std::function<void()> func)
 		return -1;
 	}
 
+	pthread_mutex_lock (&_threads_lock);
 	_threads.push_back (thread_id);
+	pthread_mutex_unlock (&_threads_lock);
 	return 0;
 }
 
@@ -546,6 +564,7 @@ DummyAudioBackend::join_process_threads ()
 {
 	int rv = 0;
 
+	pthread_mutex_lock (&_threads_lock);
 	for (std::vector<pthread_t>::const_iterator i = _threads.begin (); i != _threads.end (); ++i)
 	{
 		void *status;
@@ -555,6 +574,7 @@ DummyAudioBackend::join_process_threads ()
 		}
 	}
 	_threads.clear ();
+	pthread_mutex_unlock (&_threads_lock);
 	return rv;
 }
 
@@ -917,6 +937,14 @@ DummyAudioBackend::main_process_thread ()
 	while (_running) {
 		const size_t samples_per_period = _samples_per_period;
 
+		if (_bench != (_speedup == 0)) {
+			if (_bench) {
+				bench_finish ();
+			} else {
+				bench_start ();
+			}
+		}
+
 		if (_freewheeling != _freewheel) {
 			_freewheel = _freewheeling;
 			engine.freewheel_callback (_freewheel);
@@ -964,14 +992,17 @@ DummyAudioBackend::main_process_thread ()
 		}
 
 		if (!_freewheel) {
+			const int64_t clock2 = _x_get_monotonic_usec();
 			_dsp_load_calc.set_max_time (_samplerate, samples_per_period);
 			_dsp_load_calc.set_start_timestamp_us (clock1);
-			_dsp_load_calc.set_stop_timestamp_us (_x_get_monotonic_usec());
+			_dsp_load_calc.set_stop_timestamp_us (clock2);
 			_dsp_load = _dsp_load_calc.get_dsp_load_unbound ();
 
 			const int64_t elapsed_time = _dsp_load_calc.elapsed_time_us ();
 			const int64_t nominal_time = _dsp_load_calc.get_max_time_us ();
-			if (elapsed_time < nominal_time) {
+			if (_bench) {
+				bench_record (clock1, clock2, nominal_time);
+			} else if (elapsed_time < nominal_time) {
 				const int64_t sleepy = _speedup * (nominal_time - elapsed_time);
 				Glib::usleep (std::max ((int64_t) 10, sleepy));
 			} else {
@@ -1014,10 +1045,216 @@ DummyAudioBackend::main_process_thread ()
 #ifdef PLATFORM_WINDOWS
 	PBD::MMTIMERS::reset_resolution();
 #endif
+	if (_bench) {
+		bench_finish ();
+	}
 	_running = false;
 	return 0;
 }
 
+/* Benchmark */
+
+static int64_t
+thread_cpu_time_us (pthread_t thread)
+{
+#ifdef __linux__
+	clockid_t cid;
+	struct timespec ts;
+	if (pthread_getcpuclockid (thread, &cid) || clock_gettime (cid, &ts)) {
+		return -1;
+	}
+	return (int64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#else
+	return -1;
+#endif
+}
+
+void
+DummyAudioBackend::bench_start ()
+{
+	_bench = true;
+	_bench_start = _x_get_monotonic_usec ();
+
+	_bench_dropped = 0;
+
+	/* keeps the capacity reserved by bench_reserve () */
+	_bench_cycles.clear ();
+	_bench_thread_time.clear ();
+	_bench_threads.clear ();
+	_bench_thread_cpu.clear ();
+}
+
+/** Allocate storage for the benchmark before the driver is selected,
+ * so that the process thread does not allocate while recording.
+ * This is enough for 2^18 cycles (about 6 minutes of engine time at
+ * 48kHz / 64 samples per period) with up to 16 process threads,
+ * further cycles are counted but not recorded.
+ */
+void
+DummyAudioBackend::bench_reserve ()
+{
+	if (_bench || _speedup == 0 || _bench_cycles.capacity () > 0) {
+		/* already allocated, or in use by the process thread */
+		return;
+	}
+	_bench_cycles.reserve (bench_max_cycles);
+	_bench_thread_time.reserve (bench_max_cycles * bench_max_threads);
+	_bench_threads.reserve (bench_max_threads);
+	_bench_thread_cpu.reserve (bench_max_threads);
+}
+
+void
+DummyAudioBackend::bench_record (int64_t clock1, int64_t clock2, int64_t nominal_time)
+{
+	if (clock1 < _bench_start || nominal_time <= 0) {
+		return;
+	}
+
+	if (_bench_cycles.size () == _bench_cycles.capacity ()) {
+		++_bench_dropped;
+		return;
+	}
+
+	/* per thread busy time is the CPU time each thread consumed since
+	 * the previous cycle. Graph process threads block while idle, so
+	 * this is the time they spent processing this cycle.
+	 * The main thread (first entry) is this one.
+	 */
+	size_t   offset    = _bench_thread_time.size ();
+	uint32_t n_threads = 0;
+
+	if (0 == pthread_mutex_trylock (&_threads_lock)) {
+		/* without the storage for all threads, only the cycle is recorded */
+		bool const fits = _threads.size () < _bench_threads.capacity ()
+		                  && _bench_thread_time.size () + _threads.size () < _bench_thread_time.capacity ();
+
+		bool changed = !fits || _bench_threads.size () != _threads.size () + 1;
+		for (size_t i = 0; !changed && i < _threads.size (); ++i) {
+			changed = pthread_equal (_bench_threads[i + 1], _threads[i]) == 0;
+		}
+		if (!fits) {
+			_bench_threads.clear ();
+			_bench_thread_cpu.clear ();
+		} else if (changed) {
+			_bench_threads.clear ();
+			_bench_threads.push_back (pthread_self ());
+			_bench_threads.insert (_bench_threads.end (), _threads.begin (), _threads.end ());
+			_bench_thread_cpu.assign (_bench_threads.size (), -1);
+		}
+
+		for (size_t i = 0; i < _bench_threads.size (); ++i) {
+			int64_t const now = thread_cpu_time_us (_bench_threads[i]);
+			if (!changed) {
+				_bench_thread_time.push_back (now < 0 || _bench_thread_cpu[i] < 0 ? -1 : now - _bench_thread_cpu[i]);
+			}
+			_bench_thread_cpu[i] = now;
+		}
+		pthread_mutex_unlock (&_threads_lock);
+
+		if (!changed) {
+			n_threads = _bench_threads.size ();
+		}
+	}
+
+	_bench_cycles.push_back (BenchCycle (clock1 - _bench_start, clock2 - clock1, (clock2 - clock1) / (float) nominal_time, offset, n_threads));
+}
+
+void
+DummyAudioBackend::bench_finish ()
+{
+	_bench = false;
+
+	if (_bench_cycles.empty ()) {
+		return;
+	}
+
+	int64_t min_elapsed = _bench_cycles.front ().elapsed;
+	int64_t max_elapsed = 0;
+	double  sum         = 0;
+
+	for (std::vector<BenchCycle>::const_iterator i = _bench_cycles.begin (); i != _bench_cycles.end (); ++i) {
+		min_elapsed = std::min (min_elapsed, i->elapsed);
+		max_elapsed = std::max (max_elapsed, i->elapsed);
+		sum += i->elapsed;
+	}
+
+	const double nominal = 1e6 * _samples_per_period / _samplerate;
+	const double wall    = _bench_cycles.back ().start + _bench_cycles.back ().elapsed;
+
+	PBD::info << string_compose (_("DummyAudioBackend: benchmark %1 cycles, %2x realtime, cycle time min %3 avg %4 max %5 [usec]"),
+	                             _bench_cycles.size (),
+	                             wall > 0 ? nominal * _bench_cycles.size () / wall : 0,
+	                             min_elapsed, sum / _bench_cycles.size (), max_elapsed)
+	          << endmsg;
+
+	if (_bench_dropped > 0) {
+		PBD::warning << string_compose (_("DummyAudioBackend: benchmark storage exhausted, the last %1 cycles were not recorded"), _bench_dropped) << endmsg;
+	}
+
+	const char* path = g_getenv ("ARDOUR_DUMMY_BENCH_REPORT");
+	if (path && strlen (path) > 0 && !write_bench_report (path)) {
+		PBD::error << string_compose (_("DummyAudioBackend: cannot write benchmark report to '%1'"), path) << endmsg;
+	}
+}
+
+/** Write the recorded cycles to @a path, as JSON if the file-name ends
+ * in ".json", as CSV otherwise. Busy times that cannot be measured
+ * on this platform are reported as -1.
+ */
+bool
+DummyAudioBackend::write_bench_report (std::string const& path) const
+{
+	FILE* f = g_fopen (path.c_str (), "w");
+	if (!f) {
+		return false;
+	}
+
+	const bool json = path.size () > 5 && path.compare (path.size () - 5, 5, ".json") == 0;
+
+	uint32_t max_threads = 0;
+	for (std::vector<BenchCycle>::const_iterator i = _bench_cycles.begin (); i != _bench_cycles.end (); ++i) {
+		max_threads = std::max (max_threads, i->n_threads);
+	}
+
+	if (json) {
+		fprintf (f, "{\n \"backend\": \"%s\",\n \"samplerate\": %.0f,\n \"period\": %" PRIu64 ",\n \"nominal_us\": %.1f,\n \"cycles\": [\n",
+		         name ().c_str (), _samplerate, (uint64_t) _samples_per_period, 1e6 * _samples_per_period / _samplerate);
+	} else {
+		fprintf (f, "cycle,start_us,elapsed_us,dsp_load");
+		for (uint32_t t = 0; t < max_threads; ++t) {
+			fprintf (f, ",thread%u_us", t);
+		}
+		fprintf (f, "\n");
+	}
+
+	size_t n = 0;
+	for (std::vector<BenchCycle>::const_iterator i = _bench_cycles.begin (); i != _bench_cycles.end (); ++i, ++n) {
+		if (json) {
+			fprintf (f, "  {\"start\": %" PRIi64 ", \"elapsed\": %" PRIi64 ", \"dsp_load\": %.4f, \"threads\": [", i->start, i->elapsed, i->dsp_load);
+			for (uint32_t t = 0; t < i->n_threads; ++t) {
+				fprintf (f, "%s%" PRIi64, t > 0 ? ", " : "", _bench_thread_time[i->thread_offset + t]);
+			}
+			fprintf (f, "]}%s\n", n + 1 < _bench_cycles.size () ? "," : "");
+		} else {
+			fprintf (f, "%" PRIu64 ",%" PRIi64 ",%" PRIi64 ",%.4f", (uint64_t) n, i->start, i->elapsed, i->dsp_load);
+			for (uint32_t t = 0; t < max_threads; ++t) {
+				if (t < i->n_threads) {
+					fprintf (f, ",%" PRIi64, _bench_thread_time[i->thread_offset + t]);
+				} else {
+					fprintf (f, ",");
+				}
+			}
+			fprintf (f, "\n");
+		}
+	}
+
+	if (json) {
+		fprintf (f, " ]\n}\n");
+	}
+
+	return 0 == fclose (f);
+}
+
 
 /******************************************************************************/
 
@@ -1593,29 +1830,29 @@ void*
 DummyAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		std::set<BackendPortPtr>::const_iterator it = connections.begin ();
-		if (it == connections.end ()) {
+		std::shared_ptr<PortList const> connections = rt_connections ();
+		PortList::const_iterator it = connections->begin ();
+		if (it == connections->end ()) {
 			memset (_buffer, 0, n_samples * sizeof (Sample));
-		} else {
-			std::shared_ptr<DummyAudioPort> source = std::dynamic_pointer_cast<DummyAudioPort>(*it);
-			assert (source && source->is_output ());
+			return _buffer;
+		}
+		DummyAudioPort* source = static_cast<DummyAudioPort*>(*it);
+		assert (source->is_output ());
+		if (source->is_physical() && source->is_terminal()) {
+			source->get_buffer(n_samples); // generate signal.
+		}
+		if (connections->size () == 1 && !is_physical ()) {
+			/* read-only, use the source's buffer directly */
+			return const_cast<Sample*> (source->const_buffer ());
+		}
+		memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
+		while (++it != connections->end ()) {
+			source = static_cast<DummyAudioPort*>(*it);
+			assert (source->is_output ());
 			if (source->is_physical() && source->is_terminal()) {
 				source->get_buffer(n_samples); // generate signal.
 			}
-			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != connections.end ()) {
-				source = std::dynamic_pointer_cast<DummyAudioPort>(*it);
-				assert (source && source->is_output ());
-				Sample* dst = buffer ();
-				if (source->is_physical() && source->is_terminal()) {
-					source->get_buffer(n_samples); // generate signal.
-				}
-				const Sample* src = source->const_buffer ();
-				for (uint32_t s = 0; s < n_samples; ++s, ++dst, ++src) {
-					*dst += *src;
-				}
-			}
+			mix_buffers_no_gain (_buffer, source->const_buffer (), n_samples);
 		}
 	} else if (is_output () && is_physical () && is_terminal()) {
 		if (!_gen_cycle) {
@@ -1871,11 +2108,11 @@ void* DummyMidiPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
 		_buffer.clear ();
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		for (std::set<BackendPortPtr>::const_iterator i = connections.begin ();
-				i != connections.end ();
+		std::shared_ptr<PortList const> connections = rt_connections ();
+		for (PortList::const_iterator i = connections->begin ();
+				i != connections->end ();
 				++i) {
-			std::shared_ptr<DummyMidiPort> source = std::dynamic_pointer_cast<DummyMidiPort>(*i);
+			DummyMidiPort* source = static_cast<DummyMidiPort*>(*i);
 			if (source->is_physical() && source->is_terminal()) {
 				source->get_buffer(n_samples); // generate signal.
 			}
@@ -346,6 +346,10 @@ class DummyAudioBackend : public AudioBackend, public PortEngineSharedImpl
 			MidiToAudio,
 		};
 
+		/* speedup is the factor applied to the nominal cycle time
+		 * to compute the sleep between cycles. 0 runs cycles back to
+		 * back and records per cycle timing (benchmark).
+		 */
 		struct DriverSpeed {
 			std::string name;
 			float speedup;
@@ -353,6 +357,17 @@ class DummyAudioBackend : public AudioBackend, public PortEngineSharedImpl
 			DriverSpeed (const std::string& n, float s, bool r = false) : name (n), speedup (s), realtime (r) {}
 		};
 
+		struct BenchCycle {
+			int64_t  start;     // usec, relative to the start of the benchmark
+			int64_t  elapsed;   // usec
+			float    dsp_load;
+			size_t   thread_offset; // first entry in _bench_thread_time
+			uint32_t n_threads;
+
+			BenchCycle (int64_t s, int64_t e, float l, size_t o, uint32_t n)
+				: start (s), elapsed (e), dsp_load (l), thread_offset (o), n_threads (n) {}
+		};
+
 		std::string _instance_name;
 		static std::vector<std::string> _midi_options;
 		static std::vector<AudioBackend::DeviceStatus> _device_status;
@@ -389,6 +404,25 @@ class DummyAudioBackend : public AudioBackend, public PortEngineSharedImpl
 		/* process threads */
 		static void* dummy_process_thread (void *);
 		std::vector<pthread_t> _threads;
+		pthread_mutex_t        _threads_lock;
+
+		/* benchmark, only used by the main process thread */
+		static const size_t bench_max_cycles  = 1 << 18;
+		static const size_t bench_max_threads = 16;
+
+		bool                    _bench;
+		int64_t                 _bench_start;
+		uint64_t                _bench_dropped;
+		std::vector<BenchCycle> _bench_cycles;
+		std::vector<int64_t>    _bench_thread_time;
+		std::vector<pthread_t>  _bench_threads;
+		std::vector<int64_t>    _bench_thread_cpu;
+
+		void bench_start ();
+		void bench_reserve ();
+		void bench_record (int64_t clock1, int64_t clock2, int64_t nominal_time);
+		void bench_finish ();
+		bool write_bench_report (std::string const& path) const;
 
 		struct ThreadData {
 			DummyAudioBackend* engine;
@@ -48,6 +48,7 @@
 
 #include "ardour/filesystem_paths.h"
 #include "ardour/port_manager.h"
+#include "ardour/runtime_functions.h"
 #include "pbd/i18n.h"
 
 #include "audio_utils.h"
@@ -1914,22 +1915,23 @@ PortAudioPort::~PortAudioPort () { }
 void* PortAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		std::set<BackendPortPtr>::const_iterator it = get_connections ().begin ();
-		if (it == get_connections ().end ()) {
+		std::shared_ptr<PortList const> connections = rt_connections ();
+		PortList::const_iterator it = connections->begin ();
+		if (it == connections->end ()) {
 			memset (_buffer, 0, n_samples * sizeof (Sample));
-		} else {
-			std::shared_ptr<const PortAudioPort> source = std::dynamic_pointer_cast<const PortAudioPort>(*it);
-			assert (source && source->is_output ());
-			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != get_connections ().end ()) {
-				source = std::dynamic_pointer_cast<const PortAudioPort>(*it);
-				assert (source && source->is_output ());
-				Sample* dst = buffer ();
-				const Sample* src = source->const_buffer ();
-				for (uint32_t s = 0; s < n_samples; ++s, ++dst, ++src) {
-					*dst += *src;
-				}
-			}
+			return _buffer;
+		}
+		PortAudioPort const* source = static_cast<PortAudioPort const*>(*it);
+		assert (source->is_output ());
+		if (connections->size () == 1 && !is_physical ()) {
+			/* read-only, use the source's buffer directly */
+			return const_cast<Sample*> (source->const_buffer ());
+		}
+		memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
+		while (++it != connections->end ()) {
+			source = static_cast<PortAudioPort const*>(*it);
+			assert (source->is_output ());
+			mix_buffers_no_gain (_buffer, source->const_buffer (), n_samples);
 		}
 	}
 	return _buffer;
@@ -1960,10 +1962,11 @@ void* PortMidiPort::get_buffer (pframes_t /* nframes */)
 {
 	if (is_input ()) {
 		(_buffer[_bufperiod]).clear ();
-		for (std::set<BackendPortPtr>::const_iterator i = get_connections ().begin ();
-				i != get_connections ().end ();
+		std::shared_ptr<PortList const> connections = rt_connections ();
+		for (PortList::const_iterator i = connections->begin ();
+				i != connections->end ();
 				++i) {
-			const PortMidiBuffer * src = std::dynamic_pointer_cast<const PortMidiPort>(*i)->const_buffer ();
+			const PortMidiBuffer * src = static_cast<PortMidiPort const*>(*i)->const_buffer ();
 			for (PortMidiBuffer::const_iterator it = src->begin (); it != src->end (); ++it) {
 				(_buffer[_bufperiod]).push_back (*it);
 			}
@@ -31,6 +31,7 @@
 #include "pbd/pthread_utils.h"
 
 #include "ardour/port_manager.h"
+#include "ardour/runtime_functions.h"
 
 #include "pulseaudio_backend.h"
 
@@ -1162,24 +1163,24 @@ void*
 PulseAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		const std::set<BackendPortPtr>&          connections = get_connections ();
-		std::set<BackendPortPtr>::const_iterator it          = connections.begin ();
+		std::shared_ptr<PortList const> connections = rt_connections ();
+		PortList::const_iterator         it          = connections->begin ();
 
-		if (it == connections.end ()) {
+		if (it == connections->end ()) {
 			memset (_buffer, 0, n_samples * sizeof (Sample));
-		} else {
-			std::shared_ptr<PulseAudioPort> source = std::dynamic_pointer_cast<PulseAudioPort> (*it);
-			assert (source && source->is_output ());
-			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != connections.end ()) {
-				source = std::dynamic_pointer_cast<PulseAudioPort> (*it);
-				assert (source && source->is_output ());
-				Sample*       dst = _buffer;
-				const Sample* src = source->const_buffer ();
-				for (uint32_t s = 0; s < n_samples; ++s, ++dst, ++src) {
-					*dst += *src;
-				}
-			}
+			return _buffer;
+		}
+		PulseAudioPort const* source = static_cast<PulseAudioPort const*> (*it);
+		assert (source->is_output ());
+		if (connections->size () == 1 && !is_physical ()) {
+			/* read-only, use the source's buffer directly */
+			return const_cast<Sample*> (source->const_buffer ());
+		}
+		memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
+		while (++it != connections->end ()) {
+			source = static_cast<PulseAudioPort const*> (*it);
+			assert (source->is_output ());
+			mix_buffers_no_gain (_buffer, source->const_buffer (), n_samples);
 		}
 	}
 	return _buffer;
@@ -1208,11 +1209,11 @@ void* PulseMidiPort::get_buffer (pframes_t /*n_samples*/)
 {
 	if (is_input ()) {
 		_buffer.clear ();
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		for (std::set<BackendPortPtr>::const_iterator i = connections.begin ();
-		     i != connections.end ();
+		std::shared_ptr<PortList const> connections = rt_connections ();
+		for (PortList::const_iterator i = connections->begin ();
+		     i != connections->end ();
 		     ++i) {
-			const PulseMidiBuffer* src = std::dynamic_pointer_cast<PulseMidiPort> (*i)->const_buffer ();
+			const PulseMidiBuffer* src = static_cast<PulseMidiPort const*> (*i)->const_buffer ();
 			for (PulseMidiBuffer::const_iterator it = src->begin (); it != src->end (); ++it) {
 				_buffer.push_back (*it);
 			}
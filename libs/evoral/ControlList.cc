@@ -194,6 +194,7 @@ ControlList::copy_events (const ControlList& other)
 {
 	{
 		PBD::RWLock::WriterLock lm (_lock);
+		invalidate_index ();
 		for (EventList::iterator x = _events.begin (); x != _events.end (); ++x) {
 			delete (*x);
 		}
@@ -238,6 +239,13 @@ ControlList::maybe_signal_changed ()
 	if (_frozen) {
 		_changed_when_thawed = true;
 	} else {
+		{
+			/* may be called with the write lock held */
+			PBD::RWLock::ReaderLock lm (_lock, PBD::RWLock::TryLock);
+			if (lm.locked ()) {
+				unlocked_build_index ();
+			}
+		}
 		Dirty (); /* EMIT SIGNAL */
 	}
 }
@@ -247,6 +255,7 @@ ControlList::clear ()
 {
 	{
 		PBD::RWLock::WriterLock lm (_lock);
+		invalidate_index ();
 		for (EventList::iterator x = _events.begin (); x != _events.end (); ++x) {
 			delete (*x);
 		}
@@ -268,6 +277,7 @@ void
 ControlList::x_scale (ratio_t const& factor)
 {
 	PBD::RWLock::WriterLock lm (_lock);
+	invalidate_index ();
 	_x_scale (factor);
 }
 
@@ -294,6 +304,7 @@ ControlList::extend_to (timepos_t const& end)
 	timepos_t actual_end = ensure_time_domain (end);
 
 	PBD::RWLock::WriterLock lm (_lock);
+	invalidate_index ();
 
 	if (_events.empty () || _events.back ()->when == actual_end) {
 		return false;
@@ -310,6 +321,7 @@ ControlList::y_transform (std::function<double (double)> callback)
 {
 	{
 		PBD::RWLock::WriterLock lm (_lock);
+		invalidate_index ();
 		for (iterator i = _events.begin (); i != _events.end (); ++i) {
 			(*i)->value = callback ((*i)->value);
 		}
@@ -323,6 +335,7 @@ ControlList::list_merge (ControlList const& other, std::function<double (double,
 {
 	{
 		PBD::RWLock::WriterLock lm (_lock);
+		invalidate_index ();
 		/* First scale existing events, copy into a new list.
 		 * The original list is needed later to interpolate
 		 * for new events only present in the master list.
@@ -403,6 +416,7 @@ ControlList::thin (double thinning_factor)
 
 	{
 		PBD::RWLock::WriterLock lm (_lock);
+		invalidate_index ();
 
 		ControlEvent* prevprev = 0;
 		ControlEvent* cur      = 0;
@@ -469,6 +483,7 @@ void
 ControlList::fast_simple_add (timepos_t const& time, double value)
 {
 	PBD::RWLock::WriterLock lm (_lock);
+	invalidate_index ();
 	/* to be used only for loading pre-sorted data from saved state */
 
 	_events.insert (_events.end (), new ControlEvent (ensure_time_domain (time), value));
@@ -514,6 +529,7 @@ void
 ControlList::start_write_pass (timepos_t const& time)
 {
 	PBD::RWLock::WriterLock lm (_lock);
+	invalidate_index ();
 
 	timepos_t when = ensure_time_domain (time);
 
@@ -565,6 +581,7 @@ ControlList::set_in_write_pass (bool yn, bool add_point, timepos_t when)
 
 	if (yn && add_point) {
 		PBD::RWLock::WriterLock lm (_lock);
+		invalidate_index ();
 		add_guard_point (when, timecnt_t (time_domain()));
 	}
 }
@@ -676,6 +693,7 @@ ControlList::editor_add (timepos_t const& time, double value, bool with_guard)
 	/* this is for making changes from a graphical line editor */
 	{
 		PBD::RWLock::WriterLock lm (_lock);
+		invalidate_index ();
 		timepos_t               when = ensure_time_domain (time);
 
 		ControlEvent cp (when, 0.0f);
@@ -737,6 +755,7 @@ ControlList::editor_add_ordered (OrderedPoints const & points, bool with_guard)
 
 	{
 		PBD::RWLock::WriterLock lm (_lock);
+		invalidate_index ();
 
 		Temporal::timepos_t earliest = ensure_time_domain (points.front().when);
 		Temporal::timepos_t latest   = ensure_time_domain (points.back().when);
@@ -895,6 +914,7 @@ ControlList::add (timepos_t const& time, double value, bool with_guards, bool wi
 	                             (most_recent_insert_iterator == _events.end ())));
 	{
 		PBD::RWLock::WriterLock lm (_lock);
+		invalidate_index ();
 
 		ControlEvent cp (when, 0.0f);
 		iterator     insertion_point;
@@ -1039,6 +1059,7 @@ ControlList::erase (iterator i)
 {
 	{
 		PBD::RWLock::WriterLock lm (_lock);
+		invalidate_index ();
 		if (most_recent_insert_iterator == i) {
 			unlocked_invalidate_insert_iterator ();
 		}
@@ -1053,6 +1074,7 @@ ControlList::erase (iterator start, iterator end)
 {
 	{
 		PBD::RWLock::WriterLock lm (_lock);
+		invalidate_index ();
 		_events.erase (start, end);
 		unlocked_invalidate_insert_iterator ();
 		mark_dirty ();
@@ -1066,6 +1088,7 @@ ControlList::erase (timepos_t const& time, double value)
 {
 	{
 		PBD::RWLock::WriterLock lm (_lock);
+		invalidate_index ();
 
 		timepos_t when = ensure_time_domain (time);
 
@@ -1093,6 +1116,7 @@ ControlList::erase_range (timepos_t const& start, timepos_t const& endt)
 
 	{
 		PBD::RWLock::WriterLock lm (_lock);
+		invalidate_index ();
 
 		erased = erase_range_internal (start, endt, _events);
 
@@ -1149,6 +1173,7 @@ ControlList::slide (iterator before, timecnt_t const& distance)
 {
 	{
 		PBD::RWLock::WriterLock lm (_lock);
+		invalidate_index ();
 
 		if (before == _events.end ()) {
 			return;
@@ -1173,6 +1198,7 @@ ControlList::shift (timepos_t const& time, timecnt_t const& distance)
 
 	{
 		PBD::RWLock::WriterLock lm (_lock);
+		invalidate_index ();
 
 		double v0, v1;
 
@@ -1233,6 +1259,7 @@ ControlList::simple_shift (timepos_t const & distance)
 {
 	{
 		PBD::RWLock::WriterLock lm (_lock);
+		invalidate_index ();
 		for (auto & e : _events) {
 			e->when = e->when + distance;
 		}
@@ -1255,6 +1282,7 @@ ControlList::modify (iterator iter, timepos_t const& time, double val)
 
 	{
 		PBD::RWLock::WriterLock lm (_lock);
+		invalidate_index ();
 
 		timepos_t when = ensure_time_domain (time);
 
@@ -1333,6 +1361,7 @@ ControlList::thaw ()
 			_events.sort (event_time_less_than);
 			unlocked_remove_duplicates ();
 			unlocked_invalidate_insert_iterator ();
+			mark_dirty ();
 			_sort_pending = false;
 		}
 	}
@@ -1342,6 +1371,8 @@ ControlList::thaw ()
 void
 ControlList::mark_dirty () const
 {
+	invalidate_index ();
+
 	_lookup_cache.left         = timepos_t::max (time_domain());
 	_lookup_cache.range.first  = _events.end ();
 	_lookup_cache.range.second = _events.end ();
@@ -1353,11 +1384,83 @@ ControlList::mark_dirty () const
 	}
 }
 
+void
+ControlList::unlocked_build_index () const
+{
+	if (index_valid ()) {
+		return;
+	}
+
+	PBD::Mutex::Lock lm (_index_lock);
+
+	if (index_valid ()) {
+		return;
+	}
+
+	_index.when.clear ();
+	_index.value.clear ();
+	_index.iter.clear ();
+
+	_index.when.reserve (_events.size ());
+	_index.value.reserve (_events.size ());
+	_index.iter.reserve (_events.size ());
+
+	for (const_iterator i = _events.begin (); i != _events.end (); ++i) {
+		_index.when.push_back ((*i)->when);
+		_index.value.push_back ((*i)->value);
+		_index.iter.push_back (i);
+	}
+
+	_index.valid.store (true, std::memory_order_release);
+}
+
+ControlList::const_iterator
+ControlList::unlocked_lower_bound (timepos_t const& when) const
+{
+	if (!index_valid ()) {
+		const ControlEvent cp (when, 0);
+		return std::lower_bound (_events.begin (), _events.end (), &cp, time_comparator);
+	}
+
+	size_t n = std::lower_bound (_index.when.begin (), _index.when.end (), when) - _index.when.begin ();
+	return n < _index.iter.size () ? _index.iter[n] : _events.end ();
+}
+
+ControlList::const_iterator
+ControlList::unlocked_upper_bound (timepos_t const& when) const
+{
+	if (!index_valid ()) {
+		const ControlEvent cp (when, 0);
+		return std::upper_bound (_events.begin (), _events.end (), &cp, time_comparator);
+	}
+
+	size_t n = std::upper_bound (_index.when.begin (), _index.when.end (), when) - _index.when.begin ();
+	return n < _index.iter.size () ? _index.iter[n] : _events.end ();
+}
+
+std::pair<ControlList::const_iterator, ControlList::const_iterator>
+ControlList::unlocked_equal_range (timepos_t const& when) const
+{
+	if (!index_valid ()) {
+		const ControlEvent cp (when, 0);
+		return std::equal_range (_events.begin (), _events.end (), &cp, time_comparator);
+	}
+
+	std::pair<std::vector<timepos_t>::const_iterator, std::vector<timepos_t>::const_iterator> r = std::equal_range (_index.when.begin (), _index.when.end (), when);
+
+	size_t const first  = r.first - _index.when.begin ();
+	size_t const second = r.second - _index.when.begin ();
+
+	return std::make_pair (first < _index.iter.size () ? _index.iter[first] : _events.end (),
+	                       second < _index.iter.size () ? _index.iter[second] : _events.end ());
+}
+
 void
 ControlList::truncate_end (timepos_t const& last_time)
 {
 	{
 		PBD::RWLock::WriterLock lm (_lock);
+		invalidate_index ();
 
 		/* last_time is an exclusive length but
 		 * last event must be *within* the region boundaries, hence the decrement()
@@ -1462,6 +1565,7 @@ ControlList::truncate_start (timecnt_t const& overall)
 {
 	{
 		PBD::RWLock::WriterLock lm (_lock);
+		invalidate_index ();
 
 		iterator   i;
 		double     first_legal_value;
@@ -1634,6 +1738,61 @@ ControlList::multipoint_eval (timepos_t const& xtime) const
 	double    uval, lval;
 	double    fraction;
 
+	if (index_valid ()) {
+		/* binary search over the index, no need for the lookup cache */
+		std::vector<timepos_t> const& when  = _index.when;
+		std::vector<double> const&    value = _index.value;
+
+		size_t const i = std::lower_bound (when.begin (), when.end (), xtime) - when.begin ();
+
+		if (_interpolation == Discrete) {
+			// shouldn't have made it to multipoint_eval
+			assert (i < when.size ());
+
+			if (i == 0 || when[i] == xtime) {
+				return value[i];
+			}
+			return value[i - 1];
+		}
+
+		if (i < when.size () && when[i] == xtime) {
+			/* x is a control point in the data */
+			return value[i];
+		}
+
+		if (i == 0) {
+			/* we're before the first point */
+			return value.front ();
+		}
+
+		if (i == when.size ()) {
+			/* we're after the last point */
+			return value.back ();
+		}
+
+		lpos = when[i - 1];
+		lval = value[i - 1];
+		upos = when[i];
+		uval = value[i];
+
+		fraction = (double)lpos.distance (xtime).distance ().val () / (double)lpos.distance (upos).distance ().val ();
+
+		switch (_interpolation) {
+			case Logarithmic:
+				return interpolate_logarithmic (lval, uval, fraction, _desc.lower, _desc.upper);
+			case Exponential:
+				return interpolate_gain (lval, uval, fraction, _desc.upper);
+			case Discrete:
+				/* should not reach here */
+				assert (0);
+			case Curved:
+				/* only used x-fade curves, never direct eval */
+				assert (0);
+			default: // Linear
+				return interpolate_linear (lval, uval, fraction);
+		}
+	}
+
 	/* "Stepped" lookup (no interpolation) */
 	/* FIXME: no cache.  significant? */
 	if (_interpolation == Discrete) {
@@ -1723,9 +1882,7 @@ ControlList::build_search_cache_if_necessary (timepos_t const& start_time) const
 	} else if ((_search_cache.left == timepos_t::max (time_domain())) || (_search_cache.left > start)) {
 		/* Marked dirty (left == max), or we're too far forward, re-search. */
 
-		const ControlEvent start_point (start, 0);
-
-		_search_cache.first = lower_bound (_events.begin (), _events.end (), &start_point, time_comparator);
+		_search_cache.first = unlocked_lower_bound (start);
 		_search_cache.left  = start;
 	}
 
@@ -1977,6 +2134,7 @@ ControlList::cut_copy_clear (timepos_t const& start_time, timepos_t const& end_t
 
 	{
 		PBD::RWLock::WriterLock lm (_lock);
+		invalidate_index ();
 
 		/* first, determine s & e, two iterators that define the range of points
 		 * affected by this operation
@@ -2084,6 +2242,7 @@ ControlList::paste (const ControlList& alist, timepos_t const& time)
 
 	{
 		PBD::RWLock::WriterLock lm (_lock);
+		invalidate_index ();
 
 		iterator     where;
 		iterator     prev;
@@ -2166,6 +2325,7 @@ ControlList::move_ranges (const list<RangeMove>& movements)
 
 	{
 		PBD::RWLock::WriterLock lm (_lock);
+		invalidate_index ();
 
 		/* a copy of the events list before we started moving stuff around */
 		EventList old_events = _events;
@@ -2306,6 +2466,7 @@ ControlList::finish_domain_bounce (Temporal::DomainBounceInfo& dbi)
 
 	{
 		PBD::RWLock::WriterLock lm (_lock);
+		invalidate_index ();
 		for (auto const & e : _events) {
 			Temporal::TimeDomainPosChanges::iterator tdc = dbi.positions.find (&e->when);
 			assert (tdc != dbi.positions.end());
@@ -2314,6 +2475,7 @@ ControlList::finish_domain_bounce (Temporal::DomainBounceInfo& dbi)
 			t.set_time_domain (dbi.from);
 			e->when = t;
 		}
+		mark_dirty ();
 	}
 
 	maybe_signal_changed ();
@@ -2377,8 +2539,8 @@ ControlList::dump (ostream& o)
 bool
 ControlList::has_event_at (Temporal::timepos_t const & pos) const
 {
-	const ControlEvent fake (pos, 0.);
-	EventList::const_iterator i = std::lower_bound (_events.begin(), _events.end(), &fake, time_comparator);
+	PBD::RWLock::ReaderLock lm (_lock);
+	EventList::const_iterator i = unlocked_lower_bound (pos);
 	if ((i == _events.end()) || ((*i)->when != pos)) {
 			return false;
 	}
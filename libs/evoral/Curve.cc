@@ -19,7 +19,9 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <iostream>
+#include <iterator>
 #include <float.h>
 #include <cmath>
 #include <climits>
@@ -37,6 +39,9 @@ using namespace sigc;
 
 namespace Evoral {
 
+Curve::ramp_t      Curve::_linear_ramp = Curve::default_linear_ramp;
+Curve::ramp_t      Curve::_exp2_ramp   = Curve::default_exp2_ramp;
+Curve::gain_ramp_t Curve::_gain_ramp   = Curve::default_gain_ramp;
 
 Curve::Curve (const ControlList& cl)
 	: _dirty (true)
@@ -296,72 +301,14 @@ Curve::_get_vector (Temporal::timepos_t x0, Temporal::timepos_t x1, float *vec,
 	lx = max (min_x, start);
 	hx = min (max_x, end);
 
-	if (npoints == 2) {
-
-		const double lpos = _list.events().front()->when.val();
-		const double lval = _list.events().front()->value;
-		const double upos = _list.events().back()->when.val();
-		const double uval = _list.events().back()->value;
-
-		/* dx that we are using */
-		if (veclen > 1) {
-			const double dx_num = hx - lx;
-			const double dx_den = veclen - 1;
-			const double lower = _list.descriptor().lower;
-			const double upper = _list.descriptor().upper;
-
-			/* gradient of the line */
-			const double m_num = uval - lval;
-			const double m_den = upos - lpos;
-			/* y intercept of the line */
-			const double c = uval - (m_num * upos / m_den);
-
-			switch (_list.interpolation()) {
-				case ControlList::Logarithmic:
-					for (int i = 0; i < veclen; ++i) {
-						const double fraction = (lx - lpos + i * dx_num / dx_den) / m_den;
-						vec[i] = interpolate_logarithmic (lval, uval, fraction, lower, upper);
-					}
-					break;
-				case ControlList::Exponential:
-					for (int i = 0; i < veclen; ++i) {
-						const double fraction = (lx - lpos + i * dx_num / dx_den) / m_den;
-						vec[i] = interpolate_gain (lval, uval, fraction, upper);
-					}
-					break;
-				case ControlList::Discrete:
-					// any discrete vector curves somewhere?
-					assert (0);
-				case ControlList::Curved:
-					/* no 2 point spline */
-					/* fallthrough */
-				default: // Linear:
-					for (int i = 0; i < veclen; ++i) {
-						vec[i] = (lx * (m_num / m_den) + m_num * i * dx_num / (m_den * dx_den)) + c;
-					}
-					break;
-			}
-		} else {
-			double fraction = (lx - lpos) / (upos - lpos);
-			switch (_list.interpolation()) {
-				case ControlList::Logarithmic:
-					vec[0] = interpolate_logarithmic (lval, uval, fraction, _list.descriptor().lower, _list.descriptor().upper);
-					break;
-				case ControlList::Exponential:
-					vec[0] = interpolate_gain (lval, uval, fraction, _list.descriptor().upper);
-					break;
-				case ControlList::Discrete:
-					// any discrete vector curves somewhere?
-					assert (0);
-				case ControlList::Curved:
-					/* no 2 point spline */
-					/* fallthrough */
-				default: // Linear:
-					vec[0] = interpolate_linear (lval, uval, fraction);
-					break;
-			}
-		}
+	double dx = 0.;
+
+	if (veclen > 1) {
+		dx = (hx - lx) / (veclen - 1);
+	}
 
+	if (npoints == 2 || _list.interpolation() != ControlList::Curved) {
+		block_eval (lx, dx, x0.is_beats(), vec, veclen);
 		return;
 	}
 
@@ -371,14 +318,139 @@ Curve::_get_vector (Temporal::timepos_t x0, Temporal::timepos_t x1, float *vec,
 
 	rx = lx;
 
-	double dx = 0.;
+	for (i = 0; i < veclen; ++i, rx += dx) {
+		vec[i] = multipoint_eval (x0.is_beats() ? Temporal::timepos_t::from_ticks (rx) : Temporal::timepos_t::from_superclock (rx));
+	}
+}
 
-	if (veclen > 1) {
-		dx = (hx - lx) / (veclen - 1);
+/** Fill vec[0..veclen) with the value at lx + i * dx, one run of samples
+ * between two control points at a time. Caller must hold the list's lock.
+ */
+void
+Curve::block_eval (double lx, double dx, bool beats, float* vec, int32_t veclen) const
+{
+	ControlList::EventList const& events (_list.events());
+	ControlList::const_iterator after = _list.unlocked_upper_bound (beats ? Temporal::timepos_t::from_ticks (lx) : Temporal::timepos_t::from_superclock (lx));
+
+	int32_t i = 0;
+
+	while (i < veclen) {
+
+		if (after == events.end()) {
+			/* we're at or after the last point */
+			std::fill (vec + i, vec + veclen, (float) events.back()->value);
+			return;
+		}
+
+		/* find the samples [i, n) that are before the next point */
+
+		const double aw = (*after)->when.val();
+		int32_t      n  = veclen;
+
+		if (dx > 0) {
+			n = (int32_t) max ((double) i, min ((double) veclen, ceil ((aw - lx) / dx)));
+			while (n > i && lx + (n - 1) * dx >= aw) {
+				--n;
+			}
+			while (n < veclen && lx + n * dx < aw) {
+				++n;
+			}
+		} else if (lx >= aw) {
+			n = i;
+		}
+
+		if (n == i) {
+			++after;
+			continue;
+		}
+
+		float*         dst = vec + i;
+		const uint32_t cnt = n - i;
+
+		if (after == events.begin()) {
+			/* we're before the first point */
+			std::fill (dst, dst + cnt, (float) events.front()->value);
+			i = n;
+			continue;
+		}
+
+		ControlEvent const* before = *std::prev (after);
+
+		const double bv     = before->value;
+		const double av     = (*after)->value;
+		const double vdelta = av - bv;
+
+		if (vdelta == 0.0 || _list.interpolation() == ControlList::Discrete) {
+			std::fill (dst, dst + cnt, (float) bv);
+			i = n;
+			continue;
+		}
+
+		const double bw     = before->when.val();
+		const double trange = aw - bw;
+		const double f0     = (lx + i * dx - bw) / trange;
+		const double df     = dx / trange;
+
+		switch (_list.interpolation()) {
+			case ControlList::Logarithmic:
+				{
+					/* from * (to / from) ^ fraction */
+					assert (bv > 0 && bv * av > 0);
+					const double l = log2 (av / bv);
+					_exp2_ramp (dst, cnt, log2 (bv) + f0 * l, df * l);
+				}
+				break;
+			case ControlList::Exponential:
+				{
+					/* see interpolate_gain () */
+					const double upper = _list.descriptor().upper;
+					const double from  = bv + TINY_NUMBER;
+					const double to    = av + TINY_NUMBER;
+
+					if (fabs (to - from) < TINY_NUMBER) {
+						std::fill (dst, dst + cnt, (float) to);
+						break;
+					}
+
+					const double g0 = gain_to_position (from * 2. / upper);
+					const double g1 = gain_to_position (to * 2. / upper);
+
+					_gain_ramp (dst, cnt, g0 + f0 * (g1 - g0), df * (g1 - g0), upper / 2.);
+				}
+				break;
+			case ControlList::Curved:
+				/* only reached with 2 points, no 2 point spline */
+				/* fallthrough */
+			default: // Linear
+				_linear_ramp (dst, cnt, bv + f0 * vdelta, df * vdelta);
+				break;
+		}
+
+		i = n;
 	}
+}
 
-	for (i = 0; i < veclen; ++i, rx += dx) {
-		vec[i] = multipoint_eval (x0.is_beats() ? Temporal::timepos_t::from_ticks (rx) : Temporal::timepos_t::from_superclock (rx));
+void
+Curve::default_linear_ramp (float* dst, uint32_t n, double start, double step)
+{
+	for (uint32_t i = 0; i < n; ++i) {
+		dst[i] = start + i * step;
+	}
+}
+
+void
+Curve::default_exp2_ramp (float* dst, uint32_t n, double start, double step)
+{
+	for (uint32_t i = 0; i < n; ++i) {
+		dst[i] = exp2 (start + i * step);
+	}
+}
+
+void
+Curve::default_gain_ramp (float* dst, uint32_t n, double start, double step, double scale)
+{
+	for (uint32_t i = 0; i < n; ++i) {
+		dst[i] = position_to_gain (start + i * step) * scale;
 	}
 }
 
@@ -394,9 +466,7 @@ Curve::multipoint_eval (Temporal::timepos_t const & x) const
 	     (lookup_cache.range.first == _list.events().end()) ||
 	     ((*lookup_cache.range.second)->when < x))) {
 
-		ControlEvent cp (x, 0.0);
-
-		lookup_cache.range = equal_range (_list.events().begin(), _list.events().end(), &cp, ControlList::time_comparator);
+		lookup_cache.range = _list.unlocked_equal_range (x);
 	}
 
 	range = lookup_cache.range;
@@ -510,8 +510,7 @@ Sequence<Time>::Sequence(const Sequence<Time>& other)
 	, _explicit_duration (other._explicit_duration)
 {
 	for (typename Notes::const_iterator i = other._notes.begin(); i != other._notes.end(); ++i) {
-		NotePtr n (new Note<Time> (**i));
-		_notes.insert (n);
+		_notes.insert (_notes.end (), make_note (**i));
 	}
 
 	for (typename SysExes::const_iterator i = other._sysexes.begin(); i != other._sysexes.end(); ++i) {
@@ -732,7 +731,10 @@ Sequence<Time>::add_note_unlocked(const NotePtr note, void* arg)
 
 	_channels_present = _channels_present | (1 << note->channel());
 
-	_notes.insert (note);
+	/* notes usually arrive in time order (file load, capture), in which
+	 * case the end is the right place and insertion is constant time.
+	 */
+	_notes.insert (_notes.end (), note);
 	_pitches[note->channel()].insert (note);
 
 	update_duration_unlocked (note->time());
@@ -869,13 +871,10 @@ Sequence<Time>::remove_note_unlocked(const constNotePtr note)
 		} else {
 
 			/* Now find the same note in the "pitches" list (which indexes
-			 * notes by channel+time. We care only about its note number
-			 * so the search_note has all other properties unset.
+			 * notes by channel+time. We care only about its note number.
 			 */
 
-			NotePtr search_note (new Note<Time>(0, Time(), Time(), note->note(), 0));
-
-			for (j = p.lower_bound (search_note); j != p.end() && (*j)->note() == note->note(); ++j) {
+			for (j = p.lower_bound (note->note()); j != p.end() && (*j)->note() == note->note(); ++j) {
 
 				if ((*j) == note) {
 					DEBUG_TRACE (DEBUG::Sequence, string_compose ("%1\terasing pitch %2 @ %3\n", this, (int)(*j)->note(), (*j)->time()));
@@ -1043,7 +1042,7 @@ Sequence<Time>::append_note_on_unlocked (const Event<Time>& ev, event_id_t evid)
 	/* nascent (incoming notes without a note-off ...yet) have a duration
 	   that extends to Beats::max()
 	*/
-	NotePtr note(new Note<Time>(ev.channel(), ev.time(), std::numeric_limits<Temporal::Beats>::max() - ev.time(), ev.note(), ev.velocity()));
+	NotePtr note (make_note (ev.channel(), ev.time(), std::numeric_limits<Temporal::Beats>::max() - ev.time(), ev.note(), ev.velocity()));
 	assert (note->end_time() == std::numeric_limits<Temporal::Beats>::max());
 	note->set_id (evid);
 
@@ -1114,7 +1113,7 @@ Sequence<Time>::append_note_off_unlocked (const Event<Time>& ev)
 		   this note-off was received.
 		*/
 		/* Can there any better guess at the velocity value ? */
-		NotePtr note (new Note<Time> (ev.channel(), Time(), ev.time(), ev.note(), 64));
+		NotePtr note (make_note (ev.channel(), Time(), ev.time(), ev.note(), 64));
 		note->set_off_velocity (ev.velocity());
 		add_note_unlocked (note);
 	}
@@ -1226,9 +1225,8 @@ bool
 Sequence<Time>::contains_unlocked (const NotePtr& note) const
 {
 	const Pitches& p (pitches (note->channel()));
-	NotePtr search_note(new Note<Time>(0, Time(), Time(), note->note()));
 
-	for (typename Pitches::const_iterator i = p.lower_bound (search_note);
+	for (typename Pitches::const_iterator i = p.lower_bound (note->note());
 	     i != p.end() && (*i)->note() == note->note(); ++i) {
 
 		if (**i == *note) {
@@ -1253,8 +1251,7 @@ template<typename Time>
 typename Sequence<Time>::Notes::const_iterator
 Sequence<Time>::note_lower_bound (Time t) const
 {
-	NotePtr search_note(new Note<Time>(0, t, Time(), 0, 0));
-	typename Sequence<Time>::Notes::const_iterator i = _notes.lower_bound(search_note);
+	typename Sequence<Time>::Notes::const_iterator i = _notes.lower_bound (t);
 	assert(i == _notes.end() || (*i)->time() >= t);
 	return i;
 }
@@ -1288,8 +1285,7 @@ template<typename Time>
 typename Sequence<Time>::Notes::iterator
 Sequence<Time>::note_lower_bound (Time t)
 {
-	NotePtr search_note(new Note<Time>(0, t, Time(), 0, 0));
-	typename Sequence<Time>::Notes::iterator i = _notes.lower_bound(search_note);
+	typename Sequence<Time>::Notes::iterator i = _notes.lower_bound (t);
 	assert(i == _notes.end() || (*i)->time() >= t);
 	return i;
 }
@@ -1350,35 +1346,34 @@ Sequence<Time>::get_notes_by_pitch (Notes& n, NoteOperator op, uint8_t val, int
 		}
 
 		const Pitches& p (pitches (c));
-		NotePtr search_note(new Note<Time>(0, Time(), Time(), val, 0));
 		typename Pitches::const_iterator i;
 		switch (op) {
 		case PitchEqual:
-			i = p.lower_bound (search_note);
+			i = p.lower_bound (val);
 			while (i != p.end() && (*i)->note() == val) {
 				n.insert (*i);
 			}
 			break;
 		case PitchLessThan:
-			i = p.upper_bound (search_note);
+			i = p.upper_bound (val);
 			while (i != p.end() && (*i)->note() < val) {
 				n.insert (*i);
 			}
 			break;
 		case PitchLessThanOrEqual:
-			i = p.upper_bound (search_note);
+			i = p.upper_bound (val);
 			while (i != p.end() && (*i)->note() <= val) {
 				n.insert (*i);
 			}
 			break;
 		case PitchGreater:
-			i = p.lower_bound (search_note);
+			i = p.lower_bound (val);
 			while (i != p.end() && (*i)->note() > val) {
 				n.insert (*i);
 			}
 			break;
 		case PitchGreaterThanOrEqual:
-			i = p.lower_bound (search_note);
+			i = p.lower_bound (val);
 			while (i != p.end() && (*i)->note() >= val) {
 				n.insert (*i);
 			}
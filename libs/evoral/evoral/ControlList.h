@@ -23,13 +23,16 @@
 #ifndef EVORAL_CONTROL_LIST_HPP
 #define EVORAL_CONTROL_LIST_HPP
 
+#include <atomic>
 #include <cassert>
 #include <list>
+#include <vector>
 #include <stdint.h>
 
 #include <boost/pool/pool.hpp>
 #include <boost/pool/pool_alloc.hpp>
 
+#include "pbd/mutex.h"
 #include "pbd/rwlock.h"
 #include "pbd/signals.h"
 
@@ -263,6 +266,7 @@ public:
 	 */
 	double eval (Temporal::timepos_t const & where) const {
 		PBD::RWLock::ReaderLock lm (_lock);
+		unlocked_build_index ();
 		return unlocked_eval (where);
 	}
 
@@ -305,6 +309,14 @@ public:
 	/** @return the list of events */
 	const EventList& events() const { return _events; }
 
+	/** Like std::lower_bound, std::upper_bound and std::equal_range on
+	 * events(), using binary search over the event index when it is up to
+	 * date. Caller must hold the lock.
+	 */
+	const_iterator unlocked_lower_bound (Temporal::timepos_t const &) const;
+	const_iterator unlocked_upper_bound (Temporal::timepos_t const &) const;
+	std::pair<const_iterator,const_iterator> unlocked_equal_range (Temporal::timepos_t const &) const;
+
 	// FIXME: const violations for Curve
 	PBD::RWLock& lock()         const { return _lock; }
 	LookupCache& lookup_cache() const { return _lookup_cache; }
@@ -384,6 +396,29 @@ public:
 
 	void build_search_cache_if_necessary (Temporal::timepos_t const & start) const;
 
+	/** Times and values of all events in contiguous arrays, and iterators
+	 * to the events, so that lookups can use binary search instead of
+	 * walking the list.
+	 *
+	 * Every modification takes the write lock and invalidates the index
+	 * (as does mark_dirty()). It is rebuilt by eval() and
+	 * after changes have been signalled, but never by realtime threads,
+	 * which walk the list while the index is not valid.
+	 */
+	struct EventIndex {
+		EventIndex () : valid (false) {}
+
+		std::vector<Temporal::timepos_t> when;
+		std::vector<double>              value;
+		std::vector<const_iterator>      iter;
+		std::atomic<bool>                valid;
+	};
+
+	/* caller must hold the lock (read or write) */
+	void unlocked_build_index () const;
+	bool index_valid () const { return _index.valid.load (std::memory_order_acquire); }
+	void invalidate_index () const { _index.valid.store (false, std::memory_order_release); }
+
 	std::shared_ptr<ControlList> cut_copy_clear (Temporal::timepos_t const &, Temporal::timepos_t const &, int op);
 	bool erase_range_internal (Temporal::timepos_t const & start, Temporal::timepos_t const & end, EventList &);
 
@@ -397,6 +432,8 @@ public:
 
 	mutable LookupCache   _lookup_cache;
 	mutable SearchCache   _search_cache;
+	mutable EventIndex    _index;
+	mutable PBD::Mutex    _index_lock;
 
 	mutable PBD::RWLock _lock;
 
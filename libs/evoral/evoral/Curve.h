@@ -43,10 +43,38 @@ public:
 
 	void mark_dirty() const { _dirty = true; }
 
+	/* Block interpolation kernels used by get_vector() to fill a run of
+	 * samples between two control points. Each fills n samples of dst
+	 * from a ramp r = start + i * step:
+	 *
+	 *   linear:  dst[i] = r
+	 *   exp2:    dst[i] = 2^r                          (Logarithmic)
+	 *   gain:    dst[i] = position_to_gain (r) * scale (Exponential)
+	 *
+	 * The defaults are portable C++; libardour replaces them with SIMD
+	 * versions for the host CPU, see setup_hardware_optimization().
+	 * Those agree with the defaults to a relative error of 2e-7.
+	 */
+	typedef void (*ramp_t)      (float* dst, uint32_t n, double start, double step);
+	typedef void (*gain_ramp_t) (float* dst, uint32_t n, double start, double step, double scale);
+
+	static void override_linear_ramp (ramp_t func)      { _linear_ramp = func; }
+	static void override_exp2_ramp   (ramp_t func)      { _exp2_ramp = func; }
+	static void override_gain_ramp   (gain_ramp_t func) { _gain_ramp = func; }
+
+	static void default_linear_ramp (float* dst, uint32_t n, double start, double step);
+	static void default_exp2_ramp   (float* dst, uint32_t n, double start, double step);
+	static void default_gain_ramp   (float* dst, uint32_t n, double start, double step, double scale);
+
 private:
 	double multipoint_eval (Temporal::timepos_t const & x) const;
 
 	void _get_vector (Temporal::timepos_t x0, Temporal::timepos_t x1, float *arg, int32_t veclen) const;
+	void block_eval (double lx, double dx, bool beats, float* vec, int32_t veclen) const;
+
+	static ramp_t      _linear_ramp;
+	static ramp_t      _exp2_ramp;
+	static gain_ramp_t _gain_ramp;
 
 	mutable bool       _dirty;
 	const ControlList& _list;
@@ -123,27 +123,51 @@ public:
 		return a->time() < b->time();
 	}
 
+	/* Comparators take their arguments by reference, to avoid atomic
+	 * reference counting for every comparison. The index comparators are
+	 * transparent: the indexes can be searched by time or note number
+	 * without allocating a search note.
+	 */
+
 	/* sorts lowest-to-highest */
 	struct NoteNumberComparator {
-		inline bool operator()(const std::shared_ptr< const Note<Time> > a,
-		                       const std::shared_ptr< const Note<Time> > b) const {
+		typedef void is_transparent;
+		template<typename A, typename B>
+		inline bool operator()(A const & a, B const & b) const {
 			return a->note() < b->note();
 		}
+		template<typename A>
+		inline bool operator()(A const & a, uint8_t n) const {
+			return a->note() < n;
+		}
+		template<typename B>
+		inline bool operator()(uint8_t n, B const & b) const {
+			return n < b->note();
+		}
 	};
 
 	/* sorts highest-to-lowest */
 	struct ReverseNoteNumberComparator {
-		inline bool operator()(const std::shared_ptr< const Note<Time> > a,
-		                       const std::shared_ptr< const Note<Time> > b) const {
+		template<typename A, typename B>
+		inline bool operator()(A const & a, B const & b) const {
 			return b->note() < a->note();
 		}
 	};
 
 	struct EarlierNoteComparator {
-		inline bool operator()(const std::shared_ptr< const Note<Time> > a,
-		                       const std::shared_ptr< const Note<Time> > b) const {
+		typedef void is_transparent;
+		template<typename A, typename B>
+		inline bool operator()(A const & a, B const & b) const {
 			return a->time() < b->time();
 		}
+		template<typename A>
+		inline bool operator()(A const & a, Time const & t) const {
+			return a->time() < t;
+		}
+		template<typename B>
+		inline bool operator()(Time const & t, B const & b) const {
+			return t < b->time();
+		}
 	};
 
 #if 0 // NOT USED
@@ -158,12 +182,18 @@ public:
 
 	struct LaterNoteEndComparator {
 		typedef const Note<Time>* value_type;
-		inline bool operator()(const std::shared_ptr< const Note<Time> > a,
-		                       const std::shared_ptr< const Note<Time> > b) const {
+		template<typename A, typename B>
+		inline bool operator()(A const & a, B const & b) const {
 			return a->end_time() > b->end_time();
 		}
 	};
 
+	/** Create a new note, allocated together with its reference count */
+	template<typename... Args>
+	static NotePtr make_note (Args&&... args) {
+		return std::make_shared<Note<Time> > (std::forward<Args> (args)...);
+	}
+
 	typedef std::multiset<NotePtr, EarlierNoteComparator> Notes;
 	inline       Notes& notes()       { return _notes; }
 	inline const Notes& notes() const { return _notes; }
@@ -338,7 +368,7 @@ protected:
 		return 0;
 	}
 
-	typedef std::multiset<NotePtr, NoteNumberComparator>  Pitches;
+	typedef std::multiset<NotePtr, NoteNumberComparator> Pitches;
 	inline       Pitches& pitches(uint8_t chan)       { return _pitches[chan&0xf]; }
 	inline const Pitches& pitches(uint8_t chan) const { return _pitches[chan&0xf]; }
 
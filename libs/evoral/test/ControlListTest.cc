@@ -0,0 +1,160 @@
+#include <stdlib.h>
+#include <iostream>
+
+#include "pbd/microseconds.h"
+
+#include "evoral/ControlList.h"
+
+#include "ControlListTest.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (ControlListTest);
+
+using namespace Evoral;
+using namespace Temporal;
+
+/* points every `spacing' samples, with a sawtooth of values in [0, 1] */
+static const samplepos_t spacing = 64;
+
+static double
+point_value (int i)
+{
+	return (i % 101) / 100.0;
+}
+
+std::shared_ptr<ControlList>
+ControlListTest::TestCtrlList (ControlList::InterpolationStyle style, int n_points)
+{
+	Evoral::Parameter param (Evoral::Parameter (0));
+	const Evoral::ParameterDescriptor desc;
+	std::shared_ptr<ControlList> cl (new ControlList (param, desc, Temporal::TimeDomainProvider (Temporal::AudioTime)));
+
+	cl->set_interpolation (style);
+	cl->freeze ();
+	for (int i = 0; i < n_points; ++i) {
+		cl->fast_simple_add (timepos_t (i * spacing), point_value (i));
+	}
+	cl->thaw ();
+
+	return cl;
+}
+
+void
+ControlListTest::evalTest ()
+{
+	const int n_points = 10000;
+
+	std::shared_ptr<ControlList> lin  = TestCtrlList (ControlList::Linear, n_points);
+	std::shared_ptr<ControlList> disc = TestCtrlList (ControlList::Discrete, n_points);
+
+	srand (42);
+
+	for (int n = 0; n < 20000; ++n) {
+		samplepos_t const s = rand () % ((n_points + 1) * spacing);
+		int const         i = s / spacing;
+
+		double expect_lin;
+		double expect_disc;
+
+		if (i >= n_points - 1) {
+			expect_lin  = point_value (n_points - 1);
+			expect_disc = point_value (n_points - 1);
+		} else {
+			double const fraction = (s - i * spacing) / (double) spacing;
+			expect_lin  = point_value (i) + fraction * (point_value (i + 1) - point_value (i));
+			expect_disc = point_value (i);
+		}
+
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (expect_lin, lin->eval (timepos_t (s)), 1e-9);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (expect_disc, disc->eval (timepos_t (s)), 1e-9);
+
+		/* evaluating exactly at a control point returns its value */
+		if (i < n_points) {
+			CPPUNIT_ASSERT_DOUBLES_EQUAL (point_value (i), lin->eval (timepos_t (i * spacing)), 1e-9);
+			CPPUNIT_ASSERT (lin->has_event_at (timepos_t (i * spacing)));
+		}
+	}
+}
+
+void
+ControlListTest::editTest ()
+{
+	const int n_points = 1000;
+
+	std::shared_ptr<ControlList> cl = TestCtrlList (ControlList::Linear, n_points);
+
+	/* populate the index, then modify the list: evaluation must see the change */
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (point_value (10), cl->eval (timepos_t (10 * spacing)), 1e-9);
+
+	cl->editor_add (timepos_t (10 * spacing + spacing / 2), 0.5, false);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.5, cl->eval (timepos_t (10 * spacing + spacing / 2)), 1e-9);
+	CPPUNIT_ASSERT_EQUAL ((size_t) n_points + 1, cl->size ());
+
+	cl->erase_range (timepos_t (100 * spacing), timepos_t (199 * spacing));
+	CPPUNIT_ASSERT_EQUAL ((size_t) n_points + 1 - 100, cl->size ());
+	CPPUNIT_ASSERT (!cl->has_event_at (timepos_t (150 * spacing)));
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (point_value (99) + .5 * (point_value (200) - point_value (99)),
+	                              cl->eval (timepos_t (99 * spacing + 101 * spacing / 2)), 1e-9);
+
+	std::shared_ptr<ControlList> copy = cl->copy (timepos_t (300 * spacing), timepos_t (400 * spacing));
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (point_value (300), copy->eval (timepos_t (0)), 1e-9);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (point_value (350), copy->eval (timepos_t (50 * spacing)), 1e-9);
+
+	cl->clear (timepos_t (300 * spacing), timepos_t (400 * spacing));
+	CPPUNIT_ASSERT (!cl->has_event_at (timepos_t (350 * spacing)));
+}
+
+void
+ControlListTest::benchmark ()
+{
+	const int n_points = 1000000;
+	const int n_evals  = 1000000;
+	const int n_edits  = 100;
+
+	PBD::microseconds_t t0 = PBD::get_microseconds ();
+	std::shared_ptr<ControlList> cl = TestCtrlList (ControlList::Linear, n_points);
+	PBD::microseconds_t const t_build = PBD::get_microseconds () - t0;
+
+	srand (42);
+	double sum = 0;
+
+	t0 = PBD::get_microseconds ();
+	for (int n = 0; n < n_evals; ++n) {
+		sum += cl->eval (timepos_t ((samplepos_t) (rand () % (n_points * spacing))));
+	}
+	PBD::microseconds_t const t_eval = PBD::get_microseconds () - t0;
+
+	t0 = PBD::get_microseconds ();
+	for (int n = 0; n < n_edits; ++n) {
+		samplepos_t const s = (rand () % n_points) * spacing + spacing / 2;
+		cl->editor_add (timepos_t (s), 0.5, false);
+		sum += cl->eval (timepos_t (s));
+	}
+	PBD::microseconds_t const t_add = PBD::get_microseconds () - t0;
+
+	t0 = PBD::get_microseconds ();
+	for (int n = 0; n < n_edits; ++n) {
+		samplepos_t const s = (rand () % (n_points - 10)) * spacing;
+		cl->erase_range (timepos_t (s), timepos_t (s + 4 * spacing));
+		sum += cl->eval (timepos_t (s));
+	}
+	PBD::microseconds_t const t_erase = PBD::get_microseconds () - t0;
+
+	t0 = PBD::get_microseconds ();
+	for (int n = 0; n < n_edits; ++n) {
+		samplepos_t const s = (rand () % (n_points - 1000)) * spacing;
+		std::shared_ptr<ControlList> copy = cl->copy (timepos_t (s), timepos_t (s + 100 * spacing));
+		cl->clear (timepos_t (s + 200 * spacing), timepos_t (s + 300 * spacing));
+		sum += cl->eval (timepos_t (s));
+	}
+	PBD::microseconds_t const t_cut = PBD::get_microseconds () - t0;
+
+	CPPUNIT_ASSERT (sum > 0);
+
+	std::cerr << "\nControlList with " << n_points << " points:"
+	          << "\n  build:              " << t_build / 1000.0 << " ms"
+	          << "\n  " << n_evals << " x eval:     " << t_eval / 1000.0 << " ms"
+	          << "\n  " << n_edits << " x editor_add:  " << t_add / 1000.0 << " ms"
+	          << "\n  " << n_edits << " x erase_range: " << t_erase / 1000.0 << " ms"
+	          << "\n  " << n_edits << " x copy+clear:  " << t_cut / 1000.0 << " ms"
+	          << "\n";
+}
@@ -0,0 +1,23 @@
+#include <memory>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "evoral/ControlList.h"
+
+class ControlListTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (ControlListTest);
+	CPPUNIT_TEST (evalTest);
+	CPPUNIT_TEST (editTest);
+	CPPUNIT_TEST (benchmark);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void evalTest ();
+	void editTest ();
+	void benchmark ();
+
+private:
+	std::shared_ptr<Evoral::ControlList> TestCtrlList (Evoral::ControlList::InterpolationStyle, int n_points);
+};
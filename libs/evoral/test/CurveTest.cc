@@ -523,3 +523,71 @@ CurveTest::constrainedCubic ()
 		CPPUNIT_ASSERT_DOUBLES_EQUAL(v, g[x], 0.000008);
 	}
 }
+
+/* automation with points every `spacing' samples, flat runs included */
+std::shared_ptr<Evoral::ControlList>
+CurveTest::TestAutomation (ControlList::InterpolationStyle style, int n_points, int spacing)
+{
+	Evoral::Parameter param (Evoral::Parameter (0));
+	Evoral::ParameterDescriptor desc;
+
+	switch (style) {
+		case ControlList::Logarithmic:
+			desc.lower = 20;
+			desc.upper = 20000;
+			break;
+		case ControlList::Exponential:
+			desc.lower = 0;
+			desc.upper = 2;
+			break;
+		default:
+			desc.lower = -1;
+			desc.upper = 1;
+			break;
+	}
+
+	std::shared_ptr<Evoral::ControlList> cl (new Evoral::ControlList (param, desc, Temporal::TimeDomainProvider (Temporal::AudioTime)));
+	cl->create_curve ();
+	cl->set_interpolation (style);
+
+	srand (17);
+	double v = 0;
+	for (int i = 0; i < n_points; ++i) {
+		if (i % 7 != 3) {
+			/* every 7th segment is flat */
+			v = desc.lower + (desc.upper - desc.lower) * (rand () / (double) RAND_MAX);
+		}
+		cl->fast_simple_add (timepos_t (i * spacing), v);
+	}
+
+	return cl;
+}
+
+void
+CurveTest::blockEval ()
+{
+	const ControlList::InterpolationStyle styles[] = { ControlList::Discrete, ControlList::Linear, ControlList::Logarithmic, ControlList::Exponential };
+	const int n_points = 100;
+	const int spacing  = 333;
+
+	float vec[1000];
+
+	for (size_t s = 0; s < sizeof (styles) / sizeof (styles[0]); ++s) {
+		std::shared_ptr<Evoral::ControlList> cl = TestAutomation (styles[s], n_points, spacing);
+
+		/* blocks of various sizes, starting before the first and ending after the last point */
+		samplepos_t pos = -500;
+		int         len = 1;
+		while (pos < n_points * spacing + 500) {
+			cl->curve ().get_vector (timepos_t (pos), timepos_t (pos + len - 1), vec, len);
+			for (int i = 0; i < len; ++i) {
+				const double expect = cl->eval (timepos_t (pos + i));
+				char msg[128];
+				snprintf (msg, 128, "interpolation %d at %" PRId64 " (block of %d @ %" PRId64 ")", (int) styles[s], pos + i, len, pos);
+				CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE (msg, expect, vec[i], 1e-5 * std::max (1.0, fabs (expect)));
+			}
+			pos += len;
+			len = 1 + (len * 7 + 13) % 997;
+		}
+	}
+}
@@ -15,6 +15,7 @@ class CurveTest : public CppUnit::TestFixture
 	CPPUNIT_TEST (threePointDiscete);
 	CPPUNIT_TEST (constrainedCubic);
 	CPPUNIT_TEST (ctrlListEval);
+	CPPUNIT_TEST (blockEval);
 	CPPUNIT_TEST_SUITE_END ();
 
 public:
@@ -25,8 +26,11 @@ public:
 	void threePointDiscete ();
 	void constrainedCubic ();
 	void ctrlListEval ();
+	void blockEval ();
 
 private:
+	std::shared_ptr<Evoral::ControlList> TestAutomation (Evoral::ControlList::InterpolationStyle, int n_points, int spacing);
+
 	std::shared_ptr<Evoral::ControlList> TestCtrlList() {
 		Evoral::Parameter param (Evoral::Parameter(0));
 		const Evoral::ParameterDescriptor desc;
@@ -195,3 +195,41 @@ SequenceTest::controlInterpolationTest ()
 		last_value = i->second;
 	}
 }
+
+void
+SequenceTest::noteIndexTest ()
+{
+	seq->clear();
+
+	/* add notes in reverse order, the time index must sort them */
+	for (Notes::const_reverse_iterator i = test_notes.rbegin(); i != test_notes.rend(); ++i) {
+		CPPUNIT_ASSERT (seq->add_note_unlocked (Sequence<Time>::make_note (**i)));
+	}
+
+	CPPUNIT_ASSERT_EQUAL (test_notes.size(), seq->notes().size());
+
+	Time last = Time::from_double (-1);
+	for (Sequence<Time>::Notes::const_iterator i = seq->notes().begin(); i != seq->notes().end(); ++i) {
+		CPPUNIT_ASSERT (last < (*i)->time());
+		last = (*i)->time();
+	}
+
+	/* lookup by time */
+	CPPUNIT_ASSERT_EQUAL (Time::from_double (300), (*seq->note_lower_bound (Time::from_double (300)))->time());
+	CPPUNIT_ASSERT_EQUAL (Time::from_double (400), (*seq->note_lower_bound (Time::from_double (301)))->time());
+	CPPUNIT_ASSERT (seq->note_lower_bound (Time::from_double (1101)) == seq->notes().end());
+
+	/* lookup by pitch */
+	for (Notes::const_iterator i = test_notes.begin(); i != test_notes.end(); ++i) {
+		CPPUNIT_ASSERT (seq->contains (*i));
+	}
+	std::shared_ptr<Note<Time> > other (new Note<Time> (0, Time::from_double (100), Time::from_double (100), 64, 64));
+	CPPUNIT_ASSERT (!seq->contains (other));
+
+	/* removal has to find the note in both indexes */
+	Sequence<Time>::NotePtr n = *seq->note_lower_bound (Time::from_double (500));
+	seq->remove_note_unlocked (n);
+	CPPUNIT_ASSERT_EQUAL (test_notes.size() - 1, seq->notes().size());
+	CPPUNIT_ASSERT (!seq->contains (n));
+	CPPUNIT_ASSERT_EQUAL (Time::from_double (600), (*seq->note_lower_bound (Time::from_double (500)))->time());
+}
@@ -121,6 +121,7 @@ class SequenceTest : public CppUnit::TestFixture
 	CPPUNIT_TEST (preserveEventOrderingTest);
 	CPPUNIT_TEST (iteratorSeekTest);
 	CPPUNIT_TEST (controlInterpolationTest);
+	CPPUNIT_TEST (noteIndexTest);
 	CPPUNIT_TEST_SUITE_END ();
 
 public:
@@ -151,6 +152,7 @@ public:
 	void preserveEventOrderingTest ();
 	void iteratorSeekTest ();
 	void controlInterpolationTest ();
+	void noteIndexTest ();
 
 private:
 	DummyTypeMap*       type_map;
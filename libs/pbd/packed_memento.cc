@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "pbd/error.h"
+#include "pbd/packed_memento.h"
+#include "pbd/packed_xml.h"
+#include "pbd/undo_spill_log.h"
+#include "pbd/xml++.h"
+
+#include "pbd/i18n.h"
+
+using namespace PBD;
+
+PackedMemento::PackedMemento (XMLNode* before, XMLNode* after)
+	: _have_before (before != 0)
+	, _have_after (after != 0)
+	, _lost (false)
+	, _offset (-1)
+	, _before_size (0)
+	, _after_size (0)
+{
+	if (before) {
+		PackedXML::pack (*before, _before);
+		delete before;
+	}
+
+	if (after) {
+		std::string packed;
+		PackedXML::pack (*after, packed);
+		delete after;
+
+		if (_have_before) {
+			PackedXML::diff (_before, packed, _after);
+		} else {
+			_after.swap (packed);
+		}
+	}
+
+	_before.shrink_to_fit ();
+	_after.shrink_to_fit ();
+}
+
+PackedMemento::~PackedMemento ()
+{
+	if (_log) {
+		_log->release (_before_size + _after_size);
+	}
+}
+
+size_t
+PackedMemento::memory_size () const
+{
+	if (_log) {
+		return 0;
+	}
+	return _before.capacity () + _after.capacity ();
+}
+
+void
+PackedMemento::spill (std::shared_ptr<UndoSpillLog> const& log)
+{
+	if (_log || !log) {
+		return;
+	}
+
+	std::string data (_before);
+	data.append (_after);
+
+	int64_t const offset = log->append (data.data (), data.size ());
+
+	if (offset < 0) {
+		/* keep it in memory */
+		return;
+	}
+
+	_log         = log;
+	_offset      = offset;
+	_before_size = _before.size ();
+	_after_size  = _after.size ();
+
+	std::string ().swap (_before);
+	std::string ().swap (_after);
+}
+
+void
+PackedMemento::respill (std::shared_ptr<UndoSpillLog> const& log)
+{
+	if (!_log || !log || _log == log) {
+		return;
+	}
+
+	size_t const size = _before_size + _after_size;
+	std::string  data;
+
+	if (!_log->read (_offset, size, data)) {
+		/* leave it where it is */
+		return;
+	}
+
+	int64_t const offset = log->append (data.data (), data.size ());
+
+	if (offset < 0) {
+		return;
+	}
+
+	_log->release (size);
+	_log    = log;
+	_offset = offset;
+}
+
+bool
+PackedMemento::load (std::string& before, std::string& after) const
+{
+	if (!_log) {
+		before = _before;
+		after  = _after;
+		return true;
+	}
+
+	std::string data;
+
+	if (!_log->read (_offset, _before_size + _after_size, data)) {
+		if (!_lost) {
+			error << _("Cannot read undo data from spill file, the affected undo steps are lost") << endmsg;
+		}
+		_lost = true;
+		return false;
+	}
+
+	before.assign (data, 0, _before_size);
+	after.assign (data, _before_size, _after_size);
+	return true;
+}
+
+XMLNode*
+PackedMemento::before () const
+{
+	if (!_have_before) {
+		return 0;
+	}
+
+	if (!_log) {
+		return PackedXML::unpack (_before);
+	}
+
+	std::string before;
+	std::string after;
+
+	if (!load (before, after)) {
+		return 0;
+	}
+
+	return PackedXML::unpack (before);
+}
+
+XMLNode*
+PackedMemento::after () const
+{
+	if (!_have_after) {
+		return 0;
+	}
+
+	if (!_have_before && !_log) {
+		return PackedXML::unpack (_after);
+	}
+
+	std::string before;
+	std::string after;
+
+	if (!load (before, after)) {
+		return 0;
+	}
+
+	if (!_have_before) {
+		return PackedXML::unpack (after);
+	}
+
+	std::string packed;
+
+	if (!PackedXML::patch (before, after, packed)) {
+		if (!_lost) {
+			error << _("Cannot restore undo data, the affected undo steps are lost") << endmsg;
+		}
+		_lost = true;
+		return 0;
+	}
+
+	return PackedXML::unpack (packed);
+}
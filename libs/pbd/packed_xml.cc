@@ -0,0 +1,313 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <deque>
+#include <unordered_map>
+
+#include <stdint.h>
+
+#include "pbd/mutex.h"
+#include "pbd/packed_xml.h"
+#include "pbd/xml++.h"
+
+using namespace PBD;
+
+/* Encoding, all integers are LEB128 varints:
+ *
+ *   node     := name-id flags [content] n-props { name-id value } n-children { node }
+ *   flags    := bit 0: content node, bit 1: content follows
+ *   content  := length bytes
+ *   value    := length bytes
+ *
+ * and a delta:
+ *
+ *   delta    := prefix-length suffix-length bytes
+ */
+
+namespace {
+
+enum NodeFlags {
+	IsContent  = 0x1,
+	HasContent = 0x2,
+};
+
+class NameTable
+{
+public:
+	uint32_t intern (std::string const& name)
+	{
+		PBD::Mutex::Lock lm (_lock);
+		auto i = _ids.find (name);
+		if (i != _ids.end ()) {
+			return i->second;
+		}
+		uint32_t const id = _names.size ();
+		_names.push_back (name);
+		_ids.insert (std::make_pair (name, id));
+		return id;
+	}
+
+	/* deque elements are never moved, so the reference stays valid */
+	std::string const* name (uint32_t id)
+	{
+		PBD::Mutex::Lock lm (_lock);
+		if (id >= _names.size ()) {
+			return 0;
+		}
+		return &_names[id];
+	}
+
+private:
+	PBD::Mutex                                _lock;
+	std::unordered_map<std::string, uint32_t> _ids;
+	std::deque<std::string>                   _names;
+};
+
+NameTable&
+names ()
+{
+	static NameTable table;
+	return table;
+}
+
+inline void
+put_varint (std::string& out, uint64_t v)
+{
+	while (v >= 0x80) {
+		out.push_back ((char) ((v & 0x7f) | 0x80));
+		v >>= 7;
+	}
+	out.push_back ((char) v);
+}
+
+inline void
+put_string (std::string& out, std::string const& s)
+{
+	put_varint (out, s.size ());
+	out.append (s);
+}
+
+void
+pack_node (XMLNode const& node, std::string& out)
+{
+	put_varint (out, names ().intern (node.name ()));
+
+	uint8_t flags = 0;
+	if (node.is_content ()) {
+		flags |= IsContent;
+	}
+	if (!node.content ().empty ()) {
+		flags |= HasContent;
+	}
+	out.push_back ((char) flags);
+
+	if (flags & HasContent) {
+		put_string (out, node.content ());
+	}
+
+	XMLPropertyList const& props (node.properties ());
+	put_varint (out, props.size ());
+	for (auto const& p : props) {
+		put_varint (out, names ().intern (p->name ()));
+		put_string (out, p->value ());
+	}
+
+	XMLNodeList const& children (node.children ());
+	put_varint (out, children.size ());
+	for (auto const& c : children) {
+		pack_node (*c, out);
+	}
+}
+
+class Reader
+{
+public:
+	Reader (char const* data, size_t size)
+		: _p (reinterpret_cast<uint8_t const*> (data))
+		, _end (_p + size)
+	{}
+
+	bool   at_end () const { return _p == _end; }
+	size_t remaining () const { return _end - _p; }
+
+	bool varint (uint64_t& v)
+	{
+		v = 0;
+		for (int shift = 0; shift < 64; shift += 7) {
+			if (_p == _end) {
+				return false;
+			}
+			uint8_t const b = *_p++;
+			v |= (uint64_t) (b & 0x7f) << shift;
+			if (!(b & 0x80)) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool byte (uint8_t& b)
+	{
+		if (_p == _end) {
+			return false;
+		}
+		b = *_p++;
+		return true;
+	}
+
+	bool string (std::string& s)
+	{
+		uint64_t len;
+		if (!varint (len) || len > (uint64_t) (_end - _p)) {
+			return false;
+		}
+		s.assign (reinterpret_cast<char const*> (_p), len);
+		_p += len;
+		return true;
+	}
+
+	std::string const* name ()
+	{
+		uint64_t id;
+		if (!varint (id) || id > UINT32_MAX) {
+			return 0;
+		}
+		return names ().name (id);
+	}
+
+private:
+	uint8_t const* _p;
+	uint8_t const* _end;
+};
+
+XMLNode*
+unpack_node (Reader& r)
+{
+	std::string const* name = r.name ();
+	uint8_t            flags;
+
+	if (!name || !r.byte (flags)) {
+		return 0;
+	}
+
+	std::string content;
+	if ((flags & HasContent) && !r.string (content)) {
+		return 0;
+	}
+
+	/* mirror XMLNode's copy-constructor */
+	XMLNode* node = (flags & IsContent) ? new XMLNode (*name, content) : new XMLNode (*name);
+	if (!(flags & IsContent) && !content.empty ()) {
+		node->set_content (content);
+	}
+
+	uint64_t    n;
+	std::string value;
+
+	if (!r.varint (n)) {
+		delete node;
+		return 0;
+	}
+	while (n--) {
+		std::string const* pname = r.name ();
+		if (!pname || !r.string (value)) {
+			delete node;
+			return 0;
+		}
+		node->set_property (pname->c_str (), value);
+	}
+
+	if (!r.varint (n)) {
+		delete node;
+		return 0;
+	}
+	while (n--) {
+		XMLNode* child = unpack_node (r);
+		if (!child) {
+			delete node;
+			return 0;
+		}
+		node->add_child_nocopy (*child);
+	}
+
+	return node;
+}
+
+} // namespace
+
+void
+PackedXML::pack (XMLNode const& node, std::string& out)
+{
+	pack_node (node, out);
+}
+
+XMLNode*
+PackedXML::unpack (char const* data, size_t size)
+{
+	Reader   r (data, size);
+	XMLNode* node = unpack_node (r);
+
+	if (node && !r.at_end ()) {
+		delete node;
+		return 0;
+	}
+	return node;
+}
+
+void
+PackedXML::diff (std::string const& base, std::string const& target, std::string& out)
+{
+	size_t const n = std::min (base.size (), target.size ());
+
+	size_t prefix = 0;
+	while (prefix < n && base[prefix] == target[prefix]) {
+		++prefix;
+	}
+
+	size_t suffix = 0;
+	while (suffix < n - prefix && base[base.size () - 1 - suffix] == target[target.size () - 1 - suffix]) {
+		++suffix;
+	}
+
+	out.clear ();
+	put_varint (out, prefix);
+	put_varint (out, suffix);
+	out.append (target, prefix, target.size () - prefix - suffix);
+}
+
+bool
+PackedXML::patch (std::string const& base, std::string const& delta, std::string& out)
+{
+	Reader   r (delta.data (), delta.size ());
+	uint64_t prefix;
+	uint64_t suffix;
+
+	if (!r.varint (prefix) || !r.varint (suffix) || prefix + suffix > base.size ()) {
+		return false;
+	}
+
+	size_t const head = delta.size () - r.remaining ();
+
+	out.clear ();
+	out.reserve (prefix + r.remaining () + suffix);
+	out.append (base, 0, prefix);
+	out.append (delta, head, std::string::npos);
+	out.append (base, base.size () - suffix, suffix);
+	return true;
+}
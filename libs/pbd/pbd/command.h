@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 
 #include "pbd/libpbd_visibility.h"
@@ -30,6 +31,8 @@
 
 namespace PBD {
 
+class UndoSpillLog;
+
 /** Base class for Undo/Redo commands and changesets */
 class LIBPBD_API Command : public PBD::StatefulDestructible, public PBD::ScopedConnectionList
 {
@@ -51,6 +54,20 @@ public:
 		return false;
 	}
 
+	/** @return heap memory held by the undo/redo state of this command */
+	virtual size_t memory_size () const { return 0; }
+
+	/** Move the undo/redo state of this command from memory to @a log */
+	virtual void spill (std::shared_ptr<UndoSpillLog> const&) {}
+
+	/** Move undo/redo state that was already spilled to @a log */
+	virtual void respill (std::shared_ptr<UndoSpillLog> const&) {}
+
+	/** @return true if the undo/redo state of this command could not
+	 * be read back, so get_state() was incomplete
+	 */
+	virtual bool state_lost () const { return false; }
+
 protected:
 	Command() {}
 	Command(const std::string& name) : _name(name) {}
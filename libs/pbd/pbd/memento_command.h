@@ -23,9 +23,11 @@
 #pragma once
 
 #include <iostream>
+#include <memory>
 
 #include "pbd/libpbd_visibility.h"
 #include "pbd/command.h"
+#include "pbd/packed_memento.h"
 #include "pbd/xml++.h"
 #include "pbd/demangle.h"
 
@@ -98,28 +100,29 @@ private:
 /** This command class is initialized with before and after mementos
  * (from Stateful::get_state()), so undo becomes restoring the before
  * memento, and redo is restoring the after memento.
+ *
+ * The mementos are kept in packed form (see PBD::PackedMemento) and only
+ * expanded to XMLNodes when they are used.
  */
 template <class obj_T>
 class LIBPBD_TEMPLATE_API MementoCommand : public PBD::Command
 {
 public:
 	MementoCommand (obj_T& a_object, XMLNode* a_before, XMLNode* a_after)
-		: _binder (new SimpleMementoCommandBinder<obj_T> (a_object)), before (a_before), after (a_after)
+		: _binder (new SimpleMementoCommandBinder<obj_T> (a_object)), _memento (a_before, a_after)
 	{
 		/* The binder's object died, so we must die */
 		_binder->DropReferences.connect_same_thread (_binder_death_connection, std::bind (&MementoCommand::binder_dying, this));
 	}
 
 	MementoCommand (MementoCommandBinder<obj_T>* b, XMLNode* a_before, XMLNode* a_after)
-		: _binder (b), before (a_before), after (a_after)
+		: _binder (b), _memento (a_before, a_after)
 	{
 		/* The binder's object died, so we must die */
 		_binder->DropReferences.connect_same_thread (_binder_death_connection, std::bind (&MementoCommand::binder_dying, this));
 	}
 
 	~MementoCommand () {
-		delete before;
-		delete after;
 		delete _binder;
 	}
 
@@ -129,12 +132,14 @@ public:
 	}
 
 	void operator() () {
+		std::unique_ptr<XMLNode> after (_memento.after ());
 		if (after) {
 			_binder->set_state(*after, Stateful::current_state_version);
 		}
 	}
 
 	void undo() {
+		std::unique_ptr<XMLNode> before (_memento.before ());
 		if (before) {
 			_binder->set_state(*before, Stateful::current_state_version);
 		}
@@ -142,9 +147,9 @@ public:
 
 	virtual XMLNode &get_state() const {
 		std::string name;
-		if (before && after) {
+		if (_memento.has_before () && _memento.has_after ()) {
 			name = "MementoCommand";
-		} else if (before) {
+		} else if (_memento.has_before ()) {
 			name = "MementoUndoCommand";
 		} else {
 			name = "MementoRedoCommand";
@@ -155,21 +160,35 @@ public:
 
 		node->set_property ("type-name", _binder->type_name ());
 
-		if (before) {
-			node->add_child_copy(*before);
+		if (XMLNode* before = _memento.before ()) {
+			node->add_child_nocopy(*before);
 		}
 
-		if (after) {
-			node->add_child_copy(*after);
+		if (XMLNode* after = _memento.after ()) {
+			node->add_child_nocopy(*after);
 		}
 
 		return *node;
 	}
 
+	size_t memory_size () const {
+		return _memento.memory_size ();
+	}
+
+	void spill (std::shared_ptr<PBD::UndoSpillLog> const& log) {
+		_memento.spill (log);
+	}
+
+	void respill (std::shared_ptr<PBD::UndoSpillLog> const& log) {
+		_memento.respill (log);
+	}
+
+	bool state_lost () const {
+		return _memento.lost ();
+	}
+
 protected:
 	MementoCommandBinder<obj_T>* _binder;
-	XMLNode* before;
-	XMLNode* after;
-	PBD::ScopedConnection _binder_death_connection;
+	PBD::PackedMemento           _memento;
+	PBD::ScopedConnection        _binder_death_connection;
 };
-
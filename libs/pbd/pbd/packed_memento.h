@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <stdint.h>
+
+#include "pbd/libpbd_visibility.h"
+
+class XMLNode;
+
+namespace PBD {
+
+class UndoSpillLog;
+
+/** The before and after state of a MementoCommand.
+ *
+ * Both states are kept as PackedXML, the after state as a delta to the
+ * before state. The data can be moved to an UndoSpillLog, it is read back
+ * from there when the state is needed.
+ */
+class LIBPBD_API PackedMemento
+{
+public:
+	/** Pack and take ownership of @a before and @a after, either may be 0 */
+	PackedMemento (XMLNode* before, XMLNode* after);
+	~PackedMemento ();
+
+	bool has_before () const { return _have_before; }
+	bool has_after () const { return _have_after; }
+
+	/** @return a new XMLNode of the before state, or 0 if there is none
+	 * or it cannot be read back (see lost())
+	 */
+	XMLNode* before () const;
+	/** @return a new XMLNode of the after state, or 0 if there is none
+	 * or it cannot be read back (see lost())
+	 */
+	XMLNode* after () const;
+
+	/** @return true if a state could not be read back from the spill log */
+	bool lost () const { return _lost; }
+
+	/** @return heap memory used by the packed states */
+	size_t memory_size () const;
+
+	/** Move the packed states to @a log */
+	void spill (std::shared_ptr<UndoSpillLog> const& log);
+	/** Move already spilled states to @a log */
+	void respill (std::shared_ptr<UndoSpillLog> const& log);
+	bool spilled () const { return (bool) _log; }
+
+private:
+	bool load (std::string& before, std::string& after) const;
+
+	std::string _before;
+	std::string _after;
+	bool        _have_before;
+	bool        _have_after;
+	mutable bool _lost;
+
+	std::shared_ptr<UndoSpillLog> _log;
+	int64_t                       _offset;
+	size_t                        _before_size;
+	size_t                        _after_size;
+};
+
+} /* namespace */
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "pbd/libpbd_visibility.h"
+
+class XMLNode;
+
+namespace PBD {
+
+/** Compact binary representation of an XMLNode tree.
+ *
+ * Node and property names are interned in a process-wide table and
+ * stored as small integers, contents and property values as
+ * length-prefixed strings. A packed tree takes a fraction of the memory
+ * of the XMLNode tree it was made from.
+ *
+ * The interned names are not part of the data, so packed trees are only
+ * meaningful within the process that created them. This is not a file
+ * format.
+ */
+class LIBPBD_API PackedXML
+{
+public:
+	/** Append the packed form of @a node to @a out */
+	static void pack (XMLNode const& node, std::string& out);
+
+	/** @return a new XMLNode tree, or 0 if @a data is not a valid packed tree */
+	static XMLNode* unpack (char const* data, size_t size);
+
+	static XMLNode* unpack (std::string const& data) {
+		return unpack (data.data (), data.size ());
+	}
+
+	/** Store @a target as a delta to @a base in @a out.
+	 *
+	 * Successive states of an object usually differ in a small part, the
+	 * delta holds only the bytes between the common prefix and suffix.
+	 */
+	static void diff (std::string const& base, std::string const& target, std::string& out);
+
+	/** Reconstruct the target of diff() from @a base and @a delta.
+	 * @return false if @a delta does not apply to @a base
+	 */
+	static bool patch (std::string const& base, std::string const& delta, std::string& out);
+};
+
+} /* namespace */
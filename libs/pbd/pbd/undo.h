@@ -24,6 +24,7 @@
 
 #include <list>
 #include <map>
+#include <memory>
 #include <string>
 
 #include <glibmm/datetime.h>
@@ -63,6 +64,11 @@ public:
 
 	XMLNode& get_state () const;
 
+	size_t memory_size () const;
+	void   spill (std::shared_ptr<UndoSpillLog> const&);
+	void   respill (std::shared_ptr<UndoSpillLog> const&);
+	bool   state_lost () const;
+
 	void set_timestamp (GDateTime* t)
 	{
 		_timestamp = Glib::DateTime (t);
@@ -131,6 +137,17 @@ public:
 
 	void set_depth (uint32_t);
 
+	/** Limit the memory used by the undo history to @a bytes (0: no limit).
+	 * When the limit is exceeded, the state of the oldest transactions is
+	 * moved to an UndoSpillLog. They remain available for undo.
+	 */
+	void   set_memory_budget (size_t bytes);
+	size_t memory_budget () const { return _memory_budget; }
+	size_t memory_size () const;
+
+	/** Create the UndoSpillLog in @a dir (the session directory) */
+	void set_spill_directory (std::string const& dir) { _spill_directory = dir; }
+
 	PBD::Signal<void()> Changed;
 	PBD::Signal<void()> BeginUndoRedo;
 	PBD::Signal<void()> EndUndoRedo;
@@ -138,10 +155,16 @@ public:
 private:
 	bool                        _clearing;
 	uint32_t                    _depth;
+	size_t                      _memory_budget;
 	std::list<UndoTransaction*> UndoList;
 	std::list<UndoTransaction*> RedoList;
 
+	std::shared_ptr<UndoSpillLog> _spill_log;
+	std::string                   _spill_directory;
+
 	void remove (UndoTransaction*);
+	void enforce_memory_budget ();
+	void compact_spill_log ();
 };
 
 } /* namespace */
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include <stdint.h>
+
+#include "pbd/libpbd_visibility.h"
+
+namespace PBD {
+
+/** Append-only temporary file that holds undo data which was moved out of
+ * memory to keep UndoHistory within its memory budget.
+ *
+ * Data is read back through a read-only memory map of the file, so only
+ * the pages of the steps that are actually undone are loaded. The file
+ * is removed when the log is destroyed.
+ */
+class LIBPBD_API UndoSpillLog
+{
+public:
+	/** Create the log in @a dir, or in the system's temporary
+	 * directory if @a dir is empty or not writable.
+	 */
+	UndoSpillLog (std::string const& dir = std::string ());
+	~UndoSpillLog ();
+
+	/** @return offset of the data in the log, or -1 on error */
+	int64_t append (char const* data, size_t size);
+
+	/** Mark @a size bytes as no longer used by anyone */
+	void release (size_t size);
+
+	/** Discard all data. Only valid when nothing refers to the log. */
+	void truncate ();
+
+	/** Copy @a size bytes at @a offset to @a out.
+	 * @return true on success
+	 */
+	bool read (int64_t offset, size_t size, std::string& out);
+
+	/** @return number of bytes in the log */
+	int64_t size () const { return _size; }
+	/** @return number of bytes that are still in use */
+	int64_t live_size () const { return _live; }
+
+private:
+	UndoSpillLog (UndoSpillLog const&);
+
+	bool map ();
+	void unmap ();
+
+	int         _fd;
+	std::string _path;
+	int64_t     _size;
+	int64_t     _live;
+	char*       _map;
+	int64_t     _mapped;
+};
+
+} /* namespace */
@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _pbd_ws_deque_h_
+#define _pbd_ws_deque_h_
+
+#include <atomic>
+#include <cassert>
+#include <stdint.h>
+#include <stdlib.h>
+
+namespace PBD {
+
+/* Lock free, bounded single-owner work-stealing deque.
+ *
+ * The owning thread pushes and pops at the bottom (LIFO), any other
+ * thread may steal from the top (FIFO).
+ *
+ * Based on "Dynamic Circular Work-Stealing Deque" by Chase and Lev
+ * and the C11 formulation by Lê, Pop, Cohen and Zappa Nardelli.
+ * Unlike the original the buffer does not grow while in use: push_back()
+ * fails if the deque is full, and reserve() must only be called while no
+ * other thread accesses the deque.
+ */
+template <typename T>
+class /*LIBPBD_API*/ WSDeque
+{
+public:
+	WSDeque (size_t buffer_size = 8)
+		: _buffer (0)
+		, _buffer_mask (0)
+	{
+		reserve (buffer_size);
+	}
+
+	~WSDeque ()
+	{
+		delete[] _buffer;
+	}
+
+	size_t capacity () const {
+		return _buffer_mask + 1;
+	}
+
+	static size_t
+	power_of_two_size (size_t sz)
+	{
+		int32_t power_of_two;
+		for (power_of_two = 1; 1U << power_of_two < sz; ++power_of_two) ;
+		return 1U << power_of_two;
+	}
+
+	/* not RT safe, must not be called concurrently with any other method */
+	void
+	reserve (size_t buffer_size)
+	{
+		buffer_size = power_of_two_size (buffer_size);
+		assert ((buffer_size >= 2) && ((buffer_size & (buffer_size - 1)) == 0));
+		if (_buffer_mask >= buffer_size - 1) {
+			return;
+		}
+		delete[] _buffer;
+		_buffer      = new std::atomic<T>[buffer_size];
+		_buffer_mask = buffer_size - 1;
+		clear ();
+	}
+
+	void
+	clear ()
+	{
+		_top.store (0, std::memory_order_relaxed);
+		_bottom.store (0, std::memory_order_relaxed);
+	}
+
+	/* owner thread only */
+	bool
+	push_back (T const& data)
+	{
+		int64_t b = _bottom.load (std::memory_order_relaxed);
+		int64_t t = _top.load (std::memory_order_acquire);
+
+		if (b - t > (int64_t)_buffer_mask) {
+			return false;
+		}
+
+		_buffer[b & _buffer_mask].store (data, std::memory_order_relaxed);
+		std::atomic_thread_fence (std::memory_order_release);
+		_bottom.store (b + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	/* owner thread only */
+	bool
+	pop_back (T& data)
+	{
+		int64_t b = _bottom.load (std::memory_order_relaxed) - 1;
+		_bottom.store (b, std::memory_order_relaxed);
+		std::atomic_thread_fence (std::memory_order_seq_cst);
+		int64_t t = _top.load (std::memory_order_relaxed);
+
+		if (t > b) {
+			/* empty */
+			_bottom.store (b + 1, std::memory_order_relaxed);
+			return false;
+		}
+
+		data = _buffer[b & _buffer_mask].load (std::memory_order_relaxed);
+
+		if (t < b) {
+			return true;
+		}
+
+		/* last item, race against concurrent steal() */
+		bool rv = _top.compare_exchange_strong (t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+		_bottom.store (b + 1, std::memory_order_relaxed);
+		return rv;
+	}
+
+	/* any thread */
+	bool
+	steal (T& data)
+	{
+		int64_t t = _top.load (std::memory_order_acquire);
+		std::atomic_thread_fence (std::memory_order_seq_cst);
+		int64_t b = _bottom.load (std::memory_order_acquire);
+
+		if (t >= b) {
+			return false;
+		}
+
+		T d = _buffer[t & _buffer_mask].load (std::memory_order_relaxed);
+		if (!_top.compare_exchange_strong (t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			/* lost race against another thief or the owner */
+			return false;
+		}
+		data = d;
+		return true;
+	}
+
+private:
+	char                 _pad0[64];
+	std::atomic<T>*      _buffer;
+	size_t               _buffer_mask;
+	char                 _pad1[64 - sizeof (std::atomic<T>*) - sizeof (size_t)];
+	std::atomic<int64_t> _top;
+	char                 _pad2[64 - sizeof (int64_t)];
+	std::atomic<int64_t> _bottom;
+	char                 _pad3[64 - sizeof (int64_t)];
+};
+
+} // namespace PBD
+
+#endif
@@ -0,0 +1,174 @@
+#include <memory>
+
+#include "pbd/memento_command.h"
+#include "pbd/packed_xml.h"
+#include "pbd/stateful.h"
+#include "pbd/undo.h"
+#include "pbd/xml++.h"
+
+#include "undo_history_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (UndoHistoryTest);
+
+using namespace std;
+using namespace PBD;
+
+namespace {
+
+class Thing : public StatefulDestructible
+{
+public:
+	Thing () : value (0) {}
+	~Thing () { drop_references (); }
+
+	XMLNode& get_state () const
+	{
+		XMLNode* node = new XMLNode ("Thing");
+		node->set_property ("value", value);
+		/* some bulk, like the regions of a playlist */
+		for (int i = 0; i < 100; ++i) {
+			XMLNode* child = node->add_child ("Child");
+			child->set_property ("index", i);
+			child->set_property ("name", string ("child with a fairly long name"));
+		}
+		return *node;
+	}
+
+	int set_state (XMLNode const& node, int)
+	{
+		node.get_property ("value", value);
+		return 0;
+	}
+
+	int value;
+};
+
+}
+
+void
+UndoHistoryTest::testPackedXML ()
+{
+	XMLNode root ("Root");
+	root.set_property ("a", string ("<&\"escaped\">"));
+	root.set_property ("b", string ("\xc3\xa4\xc3\xb6\xc3\xbc"));
+	root.set_property ("empty", string ());
+	XMLNode* c = root.add_child ("Child");
+	c->add_content ("some text");
+	c->add_child ("Grandchild")->set_property ("x", 1);
+	root.add_child ("Other");
+
+	string packed;
+	PackedXML::pack (root, packed);
+
+	std::unique_ptr<XMLNode> copy (PackedXML::unpack (packed));
+	CPPUNIT_ASSERT (copy);
+	CPPUNIT_ASSERT (*copy == root);
+
+	/* truncated data is rejected */
+	CPPUNIT_ASSERT (!PackedXML::unpack (packed.data (), packed.size () - 1));
+}
+
+void
+UndoHistoryTest::testDelta ()
+{
+	const string base ("the quick brown fox jumps over the lazy dog");
+	const string targets[] = {
+		"the quick brown cat jumps over the lazy dog",
+		"the quick brown fox",
+		"jumps over the lazy dog",
+		"",
+		base,
+		base + base,
+	};
+
+	for (auto const& t : targets) {
+		string delta;
+		string out;
+		PackedXML::diff (base, t, delta);
+		CPPUNIT_ASSERT (PackedXML::patch (base, delta, out));
+		CPPUNIT_ASSERT_EQUAL (t, out);
+	}
+
+	string delta;
+	PackedXML::diff (base, targets[0], delta);
+	CPPUNIT_ASSERT (delta.size () < 8);
+}
+
+void
+UndoHistoryTest::testMemoryBudget ()
+{
+	Thing       thing;
+	UndoHistory history;
+	const int   n = 50;
+
+	for (int i = 0; i < n; ++i) {
+		XMLNode* before = &thing.get_state ();
+		thing.value = i + 1;
+		UndoTransaction* ut = new UndoTransaction;
+		ut->add_command (new MementoCommand<Thing> (thing, before, &thing.get_state ()));
+		history.add (ut);
+	}
+
+	size_t const unlimited = history.memory_size ();
+	CPPUNIT_ASSERT (unlimited > 0);
+
+	history.set_memory_budget (unlimited / 4);
+	CPPUNIT_ASSERT (history.memory_size () <= unlimited / 4);
+
+	/* spilled steps are still available */
+	history.undo (n);
+	CPPUNIT_ASSERT_EQUAL (0, thing.value);
+
+	history.redo (n);
+	CPPUNIT_ASSERT_EQUAL (n, thing.value);
+
+	/* and new steps are spilled as they are added */
+	for (int i = 0; i < n; ++i) {
+		XMLNode* before = &thing.get_state ();
+		thing.value = n + i + 1;
+		UndoTransaction* ut = new UndoTransaction;
+		ut->add_command (new MementoCommand<Thing> (thing, before, &thing.get_state ()));
+		history.add (ut);
+		CPPUNIT_ASSERT (history.memory_size () <= unlimited / 4);
+	}
+
+	history.undo (2 * n);
+	CPPUNIT_ASSERT_EQUAL (0, thing.value);
+
+	history.clear ();
+}
+
+void
+UndoHistoryTest::testTrimSpilled ()
+{
+	Thing       thing;
+	UndoHistory history;
+	const int   n = 50;
+
+	history.set_memory_budget (1);
+
+	for (int i = 0; i < n; ++i) {
+		XMLNode* before = &thing.get_state ();
+		thing.value = i + 1;
+		UndoTransaction* ut = new UndoTransaction;
+		ut->add_command (new MementoCommand<Thing> (thing, before, &thing.get_state ()));
+		history.add (ut);
+	}
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) 0, history.memory_size ());
+
+	/* trimming most of the history moves the rest to a new log */
+	history.set_depth (n / 4);
+	CPPUNIT_ASSERT_EQUAL ((unsigned long) (n / 4), history.undo_depth ());
+
+	std::unique_ptr<XMLNode> state (&history.get_state (-1));
+	CPPUNIT_ASSERT_EQUAL ((size_t) (n / 4), state->children ().size ());
+
+	history.undo (n / 4);
+	CPPUNIT_ASSERT_EQUAL (n - n / 4, thing.value);
+
+	history.redo (n / 4);
+	CPPUNIT_ASSERT_EQUAL (n, thing.value);
+
+	history.clear ();
+}
@@ -0,0 +1,18 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class UndoHistoryTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (UndoHistoryTest);
+	CPPUNIT_TEST (testPackedXML);
+	CPPUNIT_TEST (testDelta);
+	CPPUNIT_TEST (testMemoryBudget);
+	CPPUNIT_TEST (testTrimSpilled);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void testPackedXML ();
+	void testDelta ();
+	void testMemoryBudget ();
+	void testTrimSpilled ();
+};
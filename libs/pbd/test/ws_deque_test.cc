@@ -0,0 +1,124 @@
+#include <pthread.h>
+
+#include "ws_deque_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (WSDequeTest);
+
+using namespace std;
+
+#define N_ITEMS 100000
+
+WSDequeTest::WSDequeTest ()
+	: _deque (1024)
+	, _seen (N_ITEMS)
+{
+}
+
+void
+WSDequeTest::testOrder ()
+{
+	PBD::WSDeque<intptr_t> q (16);
+	intptr_t               v;
+
+	CPPUNIT_ASSERT (!q.pop_back (v));
+	CPPUNIT_ASSERT (!q.steal (v));
+
+	for (intptr_t i = 0; i < 4; ++i) {
+		CPPUNIT_ASSERT (q.push_back (i));
+	}
+
+	/* owner is LIFO, thieves are FIFO */
+	CPPUNIT_ASSERT (q.pop_back (v) && v == 3);
+	CPPUNIT_ASSERT (q.steal (v) && v == 0);
+	CPPUNIT_ASSERT (q.steal (v) && v == 1);
+	CPPUNIT_ASSERT (q.pop_back (v) && v == 2);
+
+	CPPUNIT_ASSERT (!q.pop_back (v));
+	CPPUNIT_ASSERT (!q.steal (v));
+}
+
+void
+WSDequeTest::testCapacity ()
+{
+	PBD::WSDeque<intptr_t> q (5);
+	intptr_t               v;
+
+	CPPUNIT_ASSERT_EQUAL ((size_t)8, q.capacity ());
+
+	for (intptr_t i = 0; i < 8; ++i) {
+		CPPUNIT_ASSERT (q.push_back (i));
+	}
+	CPPUNIT_ASSERT (!q.push_back (8));
+
+	CPPUNIT_ASSERT (q.steal (v) && v == 0);
+	CPPUNIT_ASSERT (q.push_back (8));
+	CPPUNIT_ASSERT (q.pop_back (v) && v == 8);
+}
+
+static void*
+launch_thief (void* self)
+{
+	WSDequeTest* t = static_cast<WSDequeTest*> (self);
+	t->steal_thread ();
+	return NULL;
+}
+
+void
+WSDequeTest::steal_thread ()
+{
+	intptr_t v;
+	while (!_done.load () || _consumed.load () < N_ITEMS) {
+		if (_deque.steal (v)) {
+			_seen[v].fetch_add (1);
+			_consumed.fetch_add (1);
+		}
+	}
+}
+
+void
+WSDequeTest::testSteal ()
+{
+	for (auto& s : _seen) {
+		s.store (0);
+	}
+	_consumed.store (0);
+	_done.store (0);
+
+	pthread_t thieves[3];
+	for (int i = 0; i < 3; ++i) {
+		CPPUNIT_ASSERT (pthread_create (&thieves[i], NULL, launch_thief, this) == 0);
+	}
+
+	intptr_t next = 0;
+	intptr_t v;
+
+	while (next < N_ITEMS) {
+		for (int k = 0; k < 4 && next < N_ITEMS; ++k) {
+			if (_deque.push_back (next)) {
+				++next;
+			}
+		}
+		if (_deque.pop_back (v)) {
+			_seen[v].fetch_add (1);
+			_consumed.fetch_add (1);
+		}
+	}
+
+	while (_deque.pop_back (v)) {
+		_seen[v].fetch_add (1);
+		_consumed.fetch_add (1);
+	}
+
+	_done.store (1);
+
+	void* return_value;
+	for (int i = 0; i < 3; ++i) {
+		CPPUNIT_ASSERT (pthread_join (thieves[i], &return_value) == 0);
+	}
+
+	/* every item must have been consumed exactly once */
+	CPPUNIT_ASSERT_EQUAL (N_ITEMS, _consumed.load ());
+	for (auto const& s : _seen) {
+		CPPUNIT_ASSERT_EQUAL (1, s.load ());
+	}
+}
@@ -0,0 +1,29 @@
+#include <atomic>
+#include <vector>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "pbd/ws_deque.h"
+
+class WSDequeTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (WSDequeTest);
+	CPPUNIT_TEST (testOrder);
+	CPPUNIT_TEST (testCapacity);
+	CPPUNIT_TEST (testSteal);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	WSDequeTest ();
+	void testOrder ();
+	void testCapacity ();
+	void testSteal ();
+
+	void steal_thread ();
+
+private:
+	PBD::WSDeque<intptr_t>         _deque;
+	std::vector<std::atomic<int> > _seen;
+	std::atomic<int>               _consumed;
+	std::atomic<int>               _done;
+};
@@ -53,6 +53,57 @@ write_xml(const string& filename)
 	return true;
 }
 
+/* reference: serialize a tree via a libxml2 document */
+void
+add_xml_node (xmlDocPtr doc, XMLNode const* n, xmlNodePtr parent)
+{
+	xmlNodePtr node;
+
+	if (!parent) {
+		node = doc->children = xmlNewDocNode (doc, 0, (const xmlChar*) n->name().c_str(), 0);
+	} else {
+		node = xmlNewChild (parent, 0, (const xmlChar*) n->name().c_str(), 0);
+	}
+
+	if (n->is_content()) {
+		node->type = XML_TEXT_NODE;
+		xmlNodeSetContentLen (node, (const xmlChar*) n->content().c_str(), n->content().length());
+	}
+
+	for (XMLPropertyConstIterator i = n->properties().begin(); i != n->properties().end(); ++i) {
+		xmlSetProp (node, (const xmlChar*) (*i)->name().c_str(), (const xmlChar*) (*i)->value().c_str());
+	}
+
+	for (XMLNodeConstIterator i = n->children().begin(); i != n->children().end(); ++i) {
+		add_xml_node (doc, *i, node);
+	}
+}
+
+bool
+write_xml_tree (XMLNode const* root, const string& filename)
+{
+	xmlKeepBlanksDefault(0);
+	xmlDocPtr doc = xmlNewDoc(xml_version);
+	add_xml_node (doc, root, 0);
+
+	int result = xmlSaveFormatFileEnc(filename.c_str(), doc, "UTF-8", 1);
+
+	xmlFreeDoc(doc);
+
+	return result != -1;
+}
+
+string
+read_file (const string& path)
+{
+	gchar* contents = 0;
+	gsize  length = 0;
+	CPPUNIT_ASSERT (g_file_get_contents (path.c_str (), &contents, &length, 0));
+	string ret (contents, length);
+	g_free (contents);
+	return ret;
+}
+
 }
 
 void
@@ -83,6 +134,60 @@ XMLTest::testXMLFilenameEncoding ()
 	}
 }
 
+void
+XMLTest::testWriteMatchesLibXML ()
+{
+	const string output_dir = test_output_directory ("XMLWriteMatchesLibXML");
+	const string streamed   = Glib::build_filename (output_dir, "streamed.xml");
+	const string reference  = Glib::build_filename (output_dir, "reference.xml");
+
+	XMLTree tree;
+	XMLNode* root = new XMLNode ("Session");
+	tree.set_root (root);
+
+	/* characters that need escaping, in attributes and content */
+	root->add_child ("Escape")->set_property ("value", std::string ("<&>\"'\n\r\t \xc3\xbc\xe2\x82\xac"));
+	root->add_child ("Text")->add_content ("<&> \r\n\"' \xc3\xbc");
+	root->add_child ("Empty")->set_property ("value", std::string ());
+
+	/* mixed content is written without indentation */
+	XMLNode* mixed = root->add_child ("Mixed");
+	mixed->add_child ("Before");
+	mixed->add_content ("content");
+	mixed->add_child ("After")->add_child ("Nested");
+
+	/* libxml2 limits indentation depth */
+	XMLNode* node = root;
+	for (int i = 0; i < 40; ++i) {
+		node = node->add_child ("Deep");
+		node->set_property ("level", i);
+	}
+
+	CPPUNIT_ASSERT (tree.write (streamed));
+	CPPUNIT_ASSERT (write_xml_tree (tree.root (), reference));
+	CPPUNIT_ASSERT (read_file (streamed) == read_file (reference));
+
+	/* and a real session file */
+	std::string session_path;
+	CPPUNIT_ASSERT (find_file (test_search_path (), "TestSession.ardour", session_path));
+
+	XMLTree session (session_path);
+	CPPUNIT_ASSERT (session.root ());
+
+	PBD::Timing streamed_timing;
+	CPPUNIT_ASSERT (session.write (streamed));
+	streamed_timing.update ();
+
+	PBD::Timing reference_timing;
+	CPPUNIT_ASSERT (write_xml_tree (session.root (), reference));
+	reference_timing.update ();
+
+	CPPUNIT_ASSERT (read_file (streamed) == read_file (reference));
+
+	std::cerr << std::endl;
+	std::cerr << "   Streamed : " << streamed_timing.elapsed () << " us" << std::endl;
+	std::cerr << "   libxml2  : " << reference_timing.elapsed () << " us" << std::endl;
+}
 
 static const char * const root_node_name = "Session";
 static const char * const child_node_name = "Child";
@@ -25,9 +25,14 @@
 #include <string>
 #include <time.h>
 
+#include "pbd/compose.h"
+#include "pbd/error.h"
 #include "pbd/undo.h"
+#include "pbd/undo_spill_log.h"
 #include "pbd/xml++.h"
 
+#include "pbd/i18n.h"
+
 using namespace std;
 using namespace sigc;
 using namespace PBD;
@@ -171,6 +176,43 @@ UndoTransaction::get_state () const
 	return *node;
 }
 
+size_t
+UndoTransaction::memory_size () const
+{
+	size_t s = 0;
+	for (list<Command*>::const_iterator i = actions.begin (); i != actions.end (); ++i) {
+		s += (*i)->memory_size ();
+	}
+	return s;
+}
+
+void
+UndoTransaction::spill (std::shared_ptr<UndoSpillLog> const& log)
+{
+	for (list<Command*>::iterator i = actions.begin (); i != actions.end (); ++i) {
+		(*i)->spill (log);
+	}
+}
+
+void
+UndoTransaction::respill (std::shared_ptr<UndoSpillLog> const& log)
+{
+	for (list<Command*>::iterator i = actions.begin (); i != actions.end (); ++i) {
+		(*i)->respill (log);
+	}
+}
+
+bool
+UndoTransaction::state_lost () const
+{
+	for (list<Command*>::const_iterator i = actions.begin (); i != actions.end (); ++i) {
+		if ((*i)->state_lost ()) {
+			return true;
+		}
+	}
+	return false;
+}
+
 class UndoRedoSignaller
 {
 public:
@@ -191,8 +233,82 @@ private:
 
 UndoHistory::UndoHistory ()
 {
-	_clearing = false;
-	_depth    = 0;
+	_clearing      = false;
+	_depth         = 0;
+	_memory_budget = 0;
+}
+
+void
+UndoHistory::set_memory_budget (size_t bytes)
+{
+	_memory_budget = bytes;
+	enforce_memory_budget ();
+}
+
+size_t
+UndoHistory::memory_size () const
+{
+	size_t s = 0;
+	for (std::list<UndoTransaction*>::const_iterator i = UndoList.begin (); i != UndoList.end (); ++i) {
+		s += (*i)->memory_size ();
+	}
+	for (std::list<UndoTransaction*>::const_iterator i = RedoList.begin (); i != RedoList.end (); ++i) {
+		s += (*i)->memory_size ();
+	}
+	return s;
+}
+
+void
+UndoHistory::enforce_memory_budget ()
+{
+	if (_memory_budget == 0) {
+		return;
+	}
+
+	size_t total = memory_size ();
+
+	/* spill the oldest transactions first */
+	for (std::list<UndoTransaction*>::iterator i = UndoList.begin (); i != UndoList.end () && total > _memory_budget; ++i) {
+		size_t const s = (*i)->memory_size ();
+		if (s == 0) {
+			continue;
+		}
+		if (!_spill_log) {
+			_spill_log.reset (new UndoSpillLog (_spill_directory));
+		}
+		(*i)->spill (_spill_log);
+		total -= s - (*i)->memory_size ();
+	}
+}
+
+void
+UndoHistory::compact_spill_log ()
+{
+	if (!_spill_log) {
+		return;
+	}
+
+	if (_spill_log->live_size () == 0) {
+		/* all spilled transactions are gone */
+		_spill_log->truncate ();
+		return;
+	}
+
+	/* rewrite the log once most of it belongs to trimmed transactions */
+	if (_spill_log->live_size () * 2 > _spill_log->size ()) {
+		return;
+	}
+
+	std::shared_ptr<UndoSpillLog> log (new UndoSpillLog (_spill_directory));
+
+	for (std::list<UndoTransaction*>::iterator i = UndoList.begin (); i != UndoList.end (); ++i) {
+		(*i)->respill (log);
+	}
+	for (std::list<UndoTransaction*>::iterator i = RedoList.begin (); i != RedoList.end (); ++i) {
+		(*i)->respill (log);
+	}
+
+	_spill_log = log;
 }
 
 void
@@ -215,6 +331,8 @@ UndoHistory::set_depth (uint32_t d)
 			UndoList.pop_front ();
 			delete ut;
 		}
+
+		compact_spill_log ();
 	}
 }
 
@@ -252,6 +370,9 @@ UndoHistory::add (UndoTransaction* const ut)
 
 	/* we are now owners of the transaction and must delete it when finished with it */
 
+	compact_spill_log ();
+	enforce_memory_budget ();
+
 	Changed (); /* EMIT SIGNAL */
 }
 
@@ -329,6 +450,8 @@ UndoHistory::clear_redo ()
 	RedoList.clear ();
 	_clearing = false;
 
+	compact_spill_log ();
+
 	Changed (); /* EMIT SIGNAL */
 }
 
@@ -342,6 +465,8 @@ UndoHistory::clear_undo ()
 	UndoList.clear ();
 	_clearing = false;
 
+	compact_spill_log ();
+
 	Changed (); /* EMIT SIGNAL */
 }
 
@@ -351,6 +476,9 @@ UndoHistory::clear ()
 	clear_undo ();
 	clear_redo ();
 
+	/* nothing refers to it anymore */
+	_spill_log.reset ();
+
 	Changed (); /* EMIT SIGNAL */
 }
 
@@ -361,26 +489,27 @@ UndoHistory::get_state (int32_t depth)
 
 	if (depth == 0) {
 		return (*node);
+	}
 
-	} else if (depth < 0) {
-		/* everything */
-
-		for (list<UndoTransaction*>::iterator it = UndoList.begin (); it != UndoList.end (); ++it) {
-			node->add_child_nocopy ((*it)->get_state ());
-		}
-
-	} else {
-		/* just the last "depth" transactions */
+	/* all (depth < 0) or just the last "depth" transactions, newest
+	 * first, so that saving stops at a transaction whose state was lost.
+	 * Older transactions cannot be undone past it.
+	 */
 
-		list<UndoTransaction*> in_order;
+	list<XMLNode*> in_order;
 
-		for (list<UndoTransaction*>::reverse_iterator it = UndoList.rbegin (); it != UndoList.rend () && depth; ++it, depth--) {
-			in_order.push_front (*it);
+	for (list<UndoTransaction*>::reverse_iterator it = UndoList.rbegin (); it != UndoList.rend () && depth != 0; ++it, --depth) {
+		XMLNode& state ((*it)->get_state ());
+		if ((*it)->state_lost ()) {
+			delete &state;
+			error << string_compose (_("Undo history is incomplete, only the last %1 operations are saved"), in_order.size ()) << endmsg;
+			break;
 		}
+		in_order.push_front (&state);
+	}
 
-		for (list<UndoTransaction*>::iterator it = in_order.begin (); it != in_order.end (); it++) {
-			node->add_child_nocopy ((*it)->get_state ());
-		}
+	for (list<XMLNode*>::iterator it = in_order.begin (); it != in_order.end (); ++it) {
+		node->add_child_nocopy (**it);
 	}
 
 	return *node;
@@ -0,0 +1,229 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cerrno>
+
+#include <fcntl.h>
+#include <sys/types.h>
+
+#ifdef PLATFORM_WINDOWS
+#include <io.h>
+#else
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+#include <glib.h>
+#include "pbd/gstdio_compat.h"
+
+#include "pbd/compose.h"
+#include "pbd/error.h"
+#include "pbd/undo_spill_log.h"
+
+#include "pbd/i18n.h"
+
+using namespace PBD;
+
+UndoSpillLog::UndoSpillLog (std::string const& dir)
+	: _fd (-1)
+	, _size (0)
+	, _live (0)
+	, _map (0)
+	, _mapped (0)
+{
+	gchar* name = 0;
+
+	if (!dir.empty ()) {
+		/* prefer the session's disk over the temporary directory,
+		 * which is often a RAM backed tmpfs.
+		 */
+		name = g_build_filename (dir.c_str (), ".undo-XXXXXX", NULL);
+		_fd  = g_mkstemp (name);
+		if (_fd < 0) {
+			g_free (name);
+			name = 0;
+		}
+	}
+
+	if (_fd < 0) {
+		GError* err = 0;
+
+		_fd = g_file_open_tmp ("ardour-undo-XXXXXX", &name, &err);
+
+		if (_fd < 0) {
+			error << string_compose (_("Cannot create undo spill file (%1)"), err ? err->message : "") << endmsg;
+			if (err) {
+				g_error_free (err);
+			}
+			return;
+		}
+	}
+
+	_path = name;
+	g_free (name);
+
+#ifndef PLATFORM_WINDOWS
+	/* the open descriptor keeps the file alive, and nothing is left
+	 * behind if the process does not exit cleanly.
+	 */
+	::g_unlink (_path.c_str ());
+	_path.clear ();
+#endif
+}
+
+UndoSpillLog::~UndoSpillLog ()
+{
+	unmap ();
+
+	if (_fd >= 0) {
+		::close (_fd);
+	}
+
+	if (!_path.empty ()) {
+		::g_unlink (_path.c_str ());
+	}
+}
+
+int64_t
+UndoSpillLog::append (char const* data, size_t size)
+{
+	if (_fd < 0) {
+		return -1;
+	}
+
+	if (lseek (_fd, _size, SEEK_SET) != _size) {
+		return -1;
+	}
+
+	size_t written = 0;
+
+	while (written < size) {
+		ssize_t const n = ::write (_fd, data + written, size - written);
+		if (n < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			error << string_compose (_("Cannot write to undo spill file (%1)"), g_strerror (errno)) << endmsg;
+			return -1;
+		}
+		written += n;
+	}
+
+	int64_t const offset = _size;
+	_size += size;
+	_live += size;
+	return offset;
+}
+
+void
+UndoSpillLog::release (size_t size)
+{
+	_live -= std::min<int64_t> (_live, size);
+}
+
+void
+UndoSpillLog::truncate ()
+{
+	unmap ();
+
+	if (_fd < 0) {
+		return;
+	}
+
+#ifdef PLATFORM_WINDOWS
+	if (_chsize (_fd, 0) != 0) {
+#else
+	if (ftruncate (_fd, 0) != 0) {
+#endif
+		error << string_compose (_("Cannot truncate undo spill file (%1)"), g_strerror (errno)) << endmsg;
+		return;
+	}
+
+	_size = 0;
+	_live = 0;
+}
+
+bool
+UndoSpillLog::read (int64_t offset, size_t size, std::string& out)
+{
+	if (_fd < 0 || offset < 0 || offset + (int64_t) size > _size) {
+		return false;
+	}
+
+#ifdef PLATFORM_WINDOWS
+	out.resize (size);
+
+	if (lseek (_fd, offset, SEEK_SET) != offset) {
+		return false;
+	}
+
+	size_t done = 0;
+	while (done < size) {
+		int const n = ::read (_fd, &out[done], size - done);
+		if (n <= 0) {
+			return false;
+		}
+		done += n;
+	}
+	return true;
+#else
+	if (offset + (int64_t) size > _mapped && !map ()) {
+		return false;
+	}
+
+	out.assign (_map + offset, size);
+	return true;
+#endif
+}
+
+bool
+UndoSpillLog::map ()
+{
+#ifdef PLATFORM_WINDOWS
+	return false;
+#else
+	unmap ();
+
+	if (_size == 0) {
+		return false;
+	}
+
+	void* m = mmap (0, _size, PROT_READ, MAP_SHARED, _fd, 0);
+
+	if (m == MAP_FAILED) {
+		return false;
+	}
+
+	_map    = static_cast<char*> (m);
+	_mapped = _size;
+	return true;
+#endif
+}
+
+void
+UndoSpillLog::unmap ()
+{
+#ifndef PLATFORM_WINDOWS
+	if (_map) {
+		munmap (_map, _mapped);
+	}
+#endif
+	_map    = 0;
+	_mapped = 0;
+}
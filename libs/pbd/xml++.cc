@@ -9,6 +9,7 @@
 #include <string.h>
 #include <iostream>
 
+#include "pbd/gstdio_compat.h"
 #include "pbd/utf8_utils.h"
 #include "pbd/xml++.h"
 
@@ -24,6 +25,167 @@ static XMLNode*           readnode(xmlNodePtr);
 static void               writenode(xmlDocPtr, XMLNode*, xmlNodePtr, int);
 static XMLSharedNodeList* find_impl(xmlXPathContext* ctxt, const string& xpath);
 
+namespace {
+
+/** Serializes a node tree directly to a file.
+ *
+ * The output is identical to what xmlSaveFormatFileEnc (.., "UTF-8", 1)
+ * produces for the same tree, but no intermediate xmlDoc is created, and
+ * data is written in fixed size chunks.
+ */
+class XMLStreamWriter
+{
+public:
+	XMLStreamWriter (FILE* file)
+		: _file (file)
+		, _ok (true)
+	{
+		_buf.reserve (buffer_size + 1024);
+	}
+
+	bool write (XMLNode const& root)
+	{
+		put ("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+		write_node (root, 0, true);
+		put ('\n');
+		flush ();
+		return _ok;
+	}
+
+private:
+	static const size_t buffer_size = 65536;
+
+	/* same as libxml2's MAX_INDENT / strlen (xmlTreeIndentString) */
+	static const int max_indent = 30;
+
+	void flush ()
+	{
+		if (!_buf.empty () && fwrite (_buf.data (), 1, _buf.size (), _file) != _buf.size ()) {
+			_ok = false;
+		}
+		_buf.clear ();
+	}
+
+	void put (char c)
+	{
+		_buf.push_back (c);
+	}
+
+	void put (char const* str)
+	{
+		_buf.append (str);
+	}
+
+	void put (std::string const& str)
+	{
+		_buf.append (str);
+		if (_buf.size () >= buffer_size) {
+			flush ();
+		}
+	}
+
+	void indent (int level)
+	{
+		_buf.append (2 * std::min (level, max_indent), ' ');
+	}
+
+	void put_text (std::string const& str)
+	{
+		for (std::string::const_iterator i = str.begin (); i != str.end (); ++i) {
+			switch (*i) {
+				case '<':  put ("&lt;"); break;
+				case '>':  put ("&gt;"); break;
+				case '&':  put ("&amp;"); break;
+				case '\r': put ("&#13;"); break;
+				default:   put (*i); break;
+			}
+		}
+		if (_buf.size () >= buffer_size) {
+			flush ();
+		}
+	}
+
+	void put_attribute (std::string const& str)
+	{
+		for (std::string::const_iterator i = str.begin (); i != str.end (); ++i) {
+			switch (*i) {
+				case '<':  put ("&lt;"); break;
+				case '>':  put ("&gt;"); break;
+				case '&':  put ("&amp;"); break;
+				case '"':  put ("&quot;"); break;
+				case '\n': put ("&#10;"); break;
+				case '\r': put ("&#13;"); break;
+				case '\t': put ("&#9;"); break;
+				default:   put (*i); break;
+			}
+		}
+	}
+
+	void write_node (XMLNode const& node, int level, bool format)
+	{
+		if (node.is_content ()) {
+			put_text (node.content ());
+			return;
+		}
+
+		XMLNodeList const& children = node.children ();
+
+		/* like libxml2, do not add whitespace to mixed content */
+		for (XMLNodeConstIterator i = children.begin (); format && i != children.end (); ++i) {
+			if ((*i)->is_content ()) {
+				format = false;
+			}
+		}
+
+		put ('<');
+		put (node.name ());
+
+		XMLPropertyList const& props = node.properties ();
+		for (XMLPropertyConstIterator i = props.begin (); i != props.end (); ++i) {
+			put (' ');
+			put ((*i)->name ());
+			put ("=\"");
+			put_attribute ((*i)->value ());
+			put ('"');
+		}
+
+		if (children.empty ()) {
+			put ("/>");
+			return;
+		}
+
+		put ('>');
+
+		if (format) {
+			put ('\n');
+		}
+
+		for (XMLNodeConstIterator i = children.begin (); i != children.end (); ++i) {
+			if (format) {
+				indent (level + 1);
+			}
+			write_node (**i, level + 1, format);
+			if (format) {
+				put ('\n');
+			}
+		}
+
+		if (format) {
+			indent (level);
+		}
+
+		put ("</");
+		put (node.name ());
+		put ('>');
+	}
+
+	FILE*       _file;
+	std::string _buf;
+	bool        _ok;
+};
+
+}
+
 XMLTree::XMLTree()
 	: _filename()
 	, _root(0)
@@ -163,6 +325,19 @@ XMLTree::write() const
 	XMLNodeList children;
 	int result;
 
+	if (_compression == 0 && _root) {
+		/* stream the tree, libxml2 is only needed for compressed output */
+		FILE* file = g_fopen (_filename.c_str (), "wb");
+		if (!file) {
+			return false;
+		}
+		bool ok = XMLStreamWriter (file).write (*_root);
+		if (fclose (file) != 0) {
+			ok = false;
+		}
+		return ok;
+	}
+
 	xmlKeepBlanksDefault(0);
 	doc = xmlNewDoc(xml_version);
 	xmlSetDocCompressMode(doc, _compression);
@@ -60,6 +60,7 @@
 #include "ardour/plugin.h"
 #include "ardour/plugin_insert.h"
 #include "ardour/presentation_info.h"
+#include "ardour/process_profiler.h"
 #include "ardour/profile.h"
 #include "ardour/send.h"
 #include "ardour/internal_send.h"
@@ -626,6 +627,8 @@ OSC::register_callbacks()
 		REGISTER_CALLBACK (serv, X_("/strip/plugin/list"), "i", route_plugin_list);
 		REGISTER_CALLBACK (serv, X_("/strip/plugin/descriptor"), "ii", route_plugin_descriptor);
 		REGISTER_CALLBACK (serv, X_("/strip/plugin/reset"), "ii", route_plugin_reset);
+		REGISTER_CALLBACK (serv, X_("/strip/dsp_stats"), "i", route_dsp_stats);
+		REGISTER_CALLBACK (serv, X_("/dsp_profiler"), "i", dsp_profiler_enable);
 
 		/* this is a special catchall handler,
 		 * register at the end so this is only called if no
@@ -5414,6 +5417,62 @@ OSC::route_plugin_list (int ssid, lo_message msg) {
 	return 0;
 }
 
+static void
+add_dsp_stats (lo_message reply, PBD::ID const& id)
+{
+	PBD::microseconds_t min, max, p99;
+	double              avg;
+
+	if (!ProcessProfiler::get_stats (id, min, max, avg, p99)) {
+		min = max = p99 = avg = -1;
+	}
+	lo_message_add_float (reply, min);
+	lo_message_add_float (reply, avg);
+	lo_message_add_float (reply, max);
+	lo_message_add_float (reply, p99);
+}
+
+int
+OSC::route_dsp_stats (int ssid, lo_message msg) {
+	if (!session) {
+		return -1;
+	}
+
+	std::shared_ptr<Route> r = std::dynamic_pointer_cast<Route>(get_strip (ssid, get_address (msg)));
+
+	if (!r) {
+		PBD::error << "OSC: Invalid Remote Control ID '" << ssid << "'" << endmsg;
+		return -1;
+	}
+
+	/* ssid, route min/avg/max/p99 [usec], followed by name, min/avg/max/p99 for each processor */
+	lo_message reply = lo_message_new ();
+	lo_message_add_int32 (reply, ssid);
+	add_dsp_stats (reply, r->id ());
+
+	for (uint32_t n = 0;; ++n) {
+		std::shared_ptr<Processor> proc = r->nth_processor (n);
+		if (!proc) {
+			break;
+		}
+		if (!proc->display_to_user ()) {
+			continue;
+		}
+		lo_message_add_string (reply, proc->display_name ().c_str ());
+		add_dsp_stats (reply, proc->id ());
+	}
+
+	lo_send_message (get_address (msg), X_("/strip/dsp_stats"), reply);
+	lo_message_free (reply);
+	return 0;
+}
+
+int
+OSC::dsp_profiler_enable (int yn, lo_message msg) {
+	ProcessProfiler::set_enabled (yn != 0);
+	return 0;
+}
+
 int
 OSC::route_plugin_descriptor (int ssid, int piid, lo_message msg) {
 	if (!session) {
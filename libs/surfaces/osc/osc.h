@@ -667,6 +667,8 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 	PATH_CALLBACK1_MSG(route_plugin_list,i);
 	PATH_CALLBACK2_MSG(route_plugin_descriptor,i,i);
 	PATH_CALLBACK2_MSG(route_plugin_reset,i,i);
+	PATH_CALLBACK1_MSG(route_dsp_stats,i);
+	PATH_CALLBACK1_MSG(dsp_profiler_enable,i);
 
 	PATH_CALLBACK2(tbank_set_size,i,i);
 
@@ -697,6 +699,8 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 	int route_plugin_list(int ssid, lo_message msg);
 	int route_plugin_descriptor(int ssid, int piid, lo_message msg);
 	int route_plugin_reset(int ssid, int piid, lo_message msg);
+	int route_dsp_stats (int ssid, lo_message msg);
+	int dsp_profiler_enable (int yn, lo_message msg);
 
 	int trigger_bang(int rid, int stop_now, lo_message msg);
 	int trigger_unbang(int rid, int stop_now, lo_message msg);
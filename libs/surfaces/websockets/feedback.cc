@@ -17,6 +17,7 @@
  */
 
 #include "ardour/plugin_insert.h"
+#include "ardour/process_profiler.h"
 #include "ardour/session.h"
 #include "ardour/tempo.h"
 
@@ -219,6 +220,25 @@ ArdourFeedback::poll () const
 		update_all (Node::strip_meter, it->first, db);
 	}
 
+	if (ProcessProfiler::enabled ()) {
+		for (ArdourMixer::StripMap::iterator it = mixer ().strips ().begin (); it != mixer ().strips ().end (); ++it) {
+			PBD::microseconds_t min, max, p99;
+			double              avg;
+			if (!ProcessProfiler::get_stats (it->second->stripable ()->id (), min, max, avg, p99)) {
+				continue;
+			}
+			/* min, avg, max, 99th percentile in usec */
+			AddressVector addr = AddressVector ();
+			addr.push_back (it->first);
+			ValueVector val = ValueVector ();
+			val.push_back ((double)min);
+			val.push_back (avg);
+			val.push_back ((double)max);
+			val.push_back ((double)p99);
+			server ().update_all_clients (NodeState (Node::strip_dsp_stats, addr, val), false);
+		}
+	}
+
 	return true;
 }
 
@@ -35,6 +35,7 @@ namespace Node
 {
 	const std::string strip_description              = "strip_description";
 	const std::string strip_meter                    = "strip_meter";
+	const std::string strip_dsp_stats                = "strip_dsp_stats";
 	const std::string strip_gain                     = "strip_gain";
 	const std::string strip_pan                      = "strip_pan";
 	const std::string strip_mute                     = "strip_mute";
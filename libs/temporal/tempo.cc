@@ -976,6 +976,8 @@ TempoMap::operator= (TempoMap const & other)
 void
 TempoMap::copy_points (TempoMap const & other)
 {
+	_index.clear ();
+
 	MusicTimePoint const * mt;
 	TempoPoint const * tp;
 	MeterPoint const * mp;
@@ -1429,6 +1431,8 @@ TempoMap::add_meter (MeterPoint* mp)
 bool
 TempoMap::clear_tempos_before (timepos_t const & t, bool stop_at_music_time)
 {
+	_index.clear ();
+
 	if (_tempos.size() < 2) {
 		return false;
 	}
@@ -1483,6 +1487,8 @@ TempoMap::clear_tempos_before (timepos_t const & t, bool stop_at_music_time)
 bool
 TempoMap::clear_tempos_after (timepos_t const & t, bool stop_at_music_time)
 {
+	_index.clear ();
+
 	if (_tempos.size() < 2) {
 		return false;
 	}
@@ -1633,6 +1639,8 @@ TempoMap::set_tempo (Tempo const & t, timepos_t const & time, Beats const & beat
 void
 TempoMap::smf_begin ()
 {
+	_index.clear ();
+
 	_tempos.clear ();
 	_meters.clear ();
 	_points.clear ();
@@ -1647,6 +1655,8 @@ TempoMap::smf_end ()
 void
 TempoMap::smf_add (TempoPoint & tp)
 {
+	_index.clear ();
+
 	assert (&tp.map() == this);
 	/* all other tempos must be earlier; other points must be earlier or identical */
 	assert (_tempos.empty() || _tempos.back().sclock() < tp.sclock());
@@ -1658,6 +1668,8 @@ TempoMap::smf_add (TempoPoint & tp)
 void
 TempoMap::smf_add (MeterPoint & mp)
 {
+	_index.clear ();
+
 	assert (&mp.map() == this);
 	/* all other meters must be earlier; other points must be earlier or identical */
 	assert (_meters.empty() || _meters.back().sclock() < mp.sclock());
@@ -1669,6 +1681,8 @@ TempoMap::smf_add (MeterPoint & mp)
 void
 TempoMap::core_add_point (Point* pp)
 {
+	_index.clear ();
+
 	Points::iterator p;
 	const Beats beats_limit = pp->beats();
 
@@ -2001,6 +2015,8 @@ TempoMap::remove_bartime (MusicTimePoint const & mtp, bool with_reset)
 void
 TempoMap::remove_point (Point const & point)
 {
+	_index.clear ();
+
 	for (auto p = _points.begin(); p != _points.end(); ++p) {
 		if (&(*p) == &point) {
 			// XXX need to fix this leak by deleting point;
@@ -2013,6 +2029,8 @@ TempoMap::remove_point (Point const & point)
 void
 TempoMap::reset_starting_at (superclock_t sc, bool constant_bbt)
 {
+	_index.clear ();
+
 	DEBUG_TRACE (DEBUG::MapReset, string_compose ("reset starting at %1\n", sc));
 #ifndef NDEBUG
 	if (DEBUG_ENABLED(DEBUG::MapReset)) {
@@ -2222,6 +2240,8 @@ TempoMap::reset_section (Points::iterator& begin, superclock_t section_limit, Te
 bool
 TempoMap::move_meter (MeterPoint const & mp, timepos_t const & when, bool push)
 {
+	_index.clear ();
+
 	TEMPO_MAP_ASSERT (!_tempos.empty());
 	TEMPO_MAP_ASSERT (!_meters.empty());
 
@@ -2361,6 +2381,8 @@ TempoMap::move_meter (MeterPoint const & mp, timepos_t const & when, bool push)
 bool
 TempoMap::move_tempo (TempoPoint const & tp, timepos_t const & when, bool push)
 {
+	_index.clear ();
+
 	TEMPO_MAP_ASSERT (!_tempos.empty());
 	TEMPO_MAP_ASSERT (!_meters.empty());
 
@@ -2805,6 +2827,38 @@ TempoMap::_get_tempo_and_meter (typename const_traits_t::tempo_point_type & tp,
 
 	can_match = (can_match || arg == typename const_traits_t::time_type ());
 
+	size_t n;
+
+	if (index_count (arg, can_match, n)) {
+
+		/* Published map: binary search, with the same results as the
+		 * walk below.
+		 */
+
+		tp = tstart;
+		mp = mstart;
+
+		if (n == 0) {
+			return endi;
+		}
+
+		if (_index.tempos[n-1]) {
+			tp = _index.tempos[n-1];
+		}
+		if (_index.meters[n-1]) {
+			mp = _index.meters[n-1];
+		}
+
+		if (ret_iterator_after_not_at) {
+			if (n == _index.points.size()) {
+				return endi;
+			}
+			return Points::s_iterator_to (*_index.points[n]);
+		}
+
+		return Points::s_iterator_to (*_index.points[n-1]);
+	}
+
 	/* Set return tempo and meter points by value using the starting tempo
 	 * and meter passed in.
 	 *
@@ -2861,6 +2915,122 @@ TempoMap::_get_tempo_and_meter (typename const_traits_t::tempo_point_type & tp,
 	return last_used;
 }
 
+void
+TempoMap::PointIndex::clear ()
+{
+	sclocks.clear ();
+	beats.clear ();
+	bbts.clear ();
+	points.clear ();
+	tempos.clear ();
+	meters.clear ();
+	bbt_valid = false;
+}
+
+void
+TempoMap::build_index ()
+{
+	_index.clear ();
+
+	const Points::size_type npoints = _points.size();
+
+	_index.sclocks.reserve (npoints);
+	_index.beats.reserve (npoints);
+	_index.bbts.reserve (npoints);
+	_index.points.reserve (npoints);
+	_index.tempos.reserve (npoints);
+	_index.meters.reserve (npoints);
+
+	TempoPoint* tp = 0;
+	MeterPoint* mp = 0;
+	bool bbt_monotonic = true;
+
+	for (auto & p : _points) {
+
+		if (!_index.points.empty()) {
+			if (p.sclock() < _index.sclocks.back() || p.beats() < _index.beats.back()) {
+				/* should not happen, but binary search would give wrong results */
+				DEBUG_TRACE (DEBUG::TemporalMap, "tempo map points are not sorted, not building index\n");
+				_index.clear ();
+				return;
+			}
+			if (p.bbt() < _index.bbts.back()) {
+				bbt_monotonic = false;
+			}
+		}
+
+		TempoPoint* t;
+		MeterPoint* m;
+
+		if ((t = dynamic_cast<TempoPoint*> (&p)) != 0) {
+			tp = t;
+		}
+		if ((m = dynamic_cast<MeterPoint*> (&p)) != 0) {
+			mp = m;
+		}
+
+		_index.sclocks.push_back (p.sclock());
+		_index.beats.push_back (p.beats());
+		_index.bbts.push_back (p.bbt());
+		_index.points.push_back (&p);
+		_index.tempos.push_back (tp);
+		_index.meters.push_back (mp);
+	}
+
+	/* BBT markers restart BBT time, and lookups need the BBT_Argument
+	 * reference time. Those are left to the walk in ::get_tempo_and_meter_bbt()
+	 */
+	_index.bbt_valid = bbt_monotonic && _bartimes.empty();
+}
+
+bool
+TempoMap::index_count (superclock_t sc, bool can_match, size_t& n) const
+{
+	if (_index.empty()) {
+		return false;
+	}
+
+	if (can_match) {
+		n = std::upper_bound (_index.sclocks.begin(), _index.sclocks.end(), sc) - _index.sclocks.begin();
+	} else {
+		n = std::lower_bound (_index.sclocks.begin(), _index.sclocks.end(), sc) - _index.sclocks.begin();
+	}
+
+	return true;
+}
+
+bool
+TempoMap::index_count (Beats const & b, bool can_match, size_t& n) const
+{
+	if (_index.empty()) {
+		return false;
+	}
+
+	if (can_match) {
+		n = std::upper_bound (_index.beats.begin(), _index.beats.end(), b) - _index.beats.begin();
+	} else {
+		n = std::lower_bound (_index.beats.begin(), _index.beats.end(), b) - _index.beats.begin();
+	}
+
+	return true;
+}
+
+bool
+TempoMap::index_count (BBT_Time const & bbt, bool can_match, size_t& n) const
+{
+	if (_index.empty() || !_index.bbt_valid) {
+		return false;
+	}
+
+	if (can_match) {
+		n = std::upper_bound (_index.bbts.begin(), _index.bbts.end(), bbt) - _index.bbts.begin();
+	} else {
+		n = std::lower_bound (_index.bbts.begin(), _index.bbts.end(), bbt) - _index.bbts.begin();
+	}
+
+	return true;
+}
+
 Points::const_iterator
 TempoMap::get_tempo_and_meter_bbt (TempoPoint const *& t, MeterPoint const *& m, BBT_Argument const & bbt, bool can_match, bool ret_iterator_after_not_at) const
 {
@@ -2904,6 +3074,39 @@ TempoMap::get_tempo_and_meter_bbt (TempoPoint const *& t, MeterPoint const *& m,
 
 	can_match = (can_match || bbt == BBT_Time());
 
+	size_t n;
+
+	if (index_count (bbt, can_match, n)) {
+
+		/* Published map without BBT markers: binary search, with the
+		 * same results as the walk below.
+		 */
+
+		if (n == 0) {
+			return _points.end();
+		}
+
+		if (_index.tempos[n-1]) {
+			t = _index.tempos[n-1];
+		}
+		if (_index.meters[n-1]) {
+			m = _index.meters[n-1];
+		}
+
+		if (!t || !m) {
+			return _points.end();
+		}
+
+		if (ret_iterator_after_not_at) {
+			if (n == _index.points.size()) {
+				return _points.end();
+			}
+			return _points.s_iterator_to (*_index.points[n]);
+		}
+
+		return _points.s_iterator_to (*_index.points[n-1]);
+	}
+
 	/* Set return tempo and meter points by value using the starting tempo
 	 * and meter passed in.
 	 *
@@ -3886,6 +4089,8 @@ TempoMap::get_state () const
 int
 TempoMap::set_state (XMLNode const & node, int version)
 {
+	_index.clear ();
+
 	if (version <= 6000) {
 		return set_state_3x (node);
 	}
@@ -4813,6 +5018,7 @@ void
 TempoMap::init ()
 {
 	WritableSharedPtr new_map (new TempoMap ());
+	new_map->build_index ();
 	_map_mgr.init (new_map);
 	fetch ();
 }
@@ -4826,6 +5032,9 @@ TempoMap::write_copy()
 int
 TempoMap::update (TempoMap::WritableSharedPtr m)
 {
+	/* the map is not modified once it is published */
+	m->build_index ();
+
 	if (!_map_mgr.update (m)) {
 		return -1;
 	}
@@ -5077,6 +5286,8 @@ TempoMap::parse_meter_state_3x (const XMLNode& node, LegacyMeterState& lms)
 int
 TempoMap::set_state_3x (const XMLNode& node)
 {
+	_index.clear ();
+
 	XMLNodeList nlist;
 	XMLNodeConstIterator niter;
 
@@ -929,6 +929,15 @@ class /*LIBTEMPORAL_API*/ TempoMap : public PBD::StatefulDestructible
 			return _tempos.front();
 		}
 
+		size_t n;
+		if (index_count (when, false, n)) {
+			/* last tempo strictly before @p when */
+			if (n == 0 || !_index.tempos[n-1]) {
+				return _tempos.front();
+			}
+			return *_index.tempos[n-1];
+		}
+
 		Tempos::const_iterator prev = _tempos.end();
 		for (Tempos::const_iterator t = _tempos.begin(); t != _tempos.end(); ++t) {
 			if (cmp (*t, when)) {
@@ -950,6 +959,15 @@ class /*LIBTEMPORAL_API*/ TempoMap : public PBD::StatefulDestructible
 			return _meters.front();
 		}
 
+		size_t n;
+		if (index_count (when, false, n)) {
+			/* last meter strictly before @p when */
+			if (n == 0 || !_index.meters[n-1]) {
+				return _meters.front();
+			}
+			return *_index.meters[n-1];
+		}
+
 		Meters::const_iterator prev = _meters.end();
 		for (Meters::const_iterator m = _meters.begin(); m != _meters.end(); ++m) {
 			if (cmp (*m, when)) {
@@ -1063,6 +1081,43 @@ class /*LIBTEMPORAL_API*/ TempoMap : public PBD::StatefulDestructible
 	Points       _points;
 	ScopedTempoMapOwner* _scope_owner;
 
+	/* Sorted arrays over _points, so that the tempo and meter in effect
+	 * at a given time can be found by binary search. They are built by
+	 * ::update() and ::init() just before the map is published, and are
+	 * empty for maps that are being modified (copies made by
+	 * ::write_copy()), which use a linear walk of _points instead.
+	 *
+	 * tempos[n] and meters[n] are the tempo and meter in effect at
+	 * points[n] (including points[n] itself), or null.
+	 */
+	struct PointIndex {
+		std::vector<superclock_t> sclocks;
+		std::vector<Beats>        beats;
+		std::vector<BBT_Time>     bbts;
+		std::vector<Point*>       points;
+		std::vector<TempoPoint*>  tempos;
+		std::vector<MeterPoint*>  meters;
+		bool                      bbt_valid; /* BBT time is monotonic, there are no BBT markers */
+
+		PointIndex () : bbt_valid (false) {}
+
+		bool empty () const { return points.empty(); }
+		void clear ();
+	};
+
+	PointIndex _index;
+
+	void build_index ();
+
+	/* Set @p n to the number of points at or before (if @p can_match is
+	 * true) or before (if @p can_match is false) the given time.
+	 *
+	 * @return false if the index cannot be used for the given time domain
+	 */
+	bool index_count (superclock_t, bool can_match, size_t& n) const;
+	bool index_count (Beats const &, bool can_match, size_t& n) const;
+	bool index_count (BBT_Time const &, bool can_match, size_t& n) const;
+
 	int set_tempos_from_state (XMLNode const &);
 	int set_meters_from_state (XMLNode const &);
 	int set_music_times_from_state (XMLNode const &);
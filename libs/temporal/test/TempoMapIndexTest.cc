@@ -0,0 +1,109 @@
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+
+#include "pbd/microseconds.h"
+
+#include "temporal/tempo.h"
+
+#include "TempoMapIndexTest.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TempoMapIndexTest);
+
+using namespace Temporal;
+
+/* Publish a map with @p n_tempos ramped tempo changes, one every bar,
+ * and a meter change every 16 bars.
+ */
+static TempoMap::SharedPtr
+publish_large_map (int n_tempos)
+{
+	TempoMap::WritableSharedPtr tmap (TempoMap::write_copy());
+
+	for (int i = 1; i < n_tempos; ++i) {
+		double const npm  = 90 + (i % 60);
+		double const enpm = 90 + ((i + 1) % 60);
+		tmap->set_tempo (Tempo (npm, enpm, 4), timepos_t (Beats (i * 4, 0)));
+		if ((i % 16) == 0) {
+			tmap->set_meter (Meter (4, 4), timepos_t (Beats (i * 4, 0)));
+		}
+	}
+
+	TempoMap::update (tmap);
+	return TempoMap::use ();
+}
+
+void
+TempoMapIndexTest::lookupTest()
+{
+	TempoMap::SharedPtr indexed = publish_large_map (500);
+
+	/* a copy is not indexed, and walks the list of points */
+	TempoMap walked (*indexed);
+
+	const superclock_t end = indexed->superclock_at (Beats (500 * 4, 0));
+
+	srand (1);
+
+	for (int n = 0; n < 5000; ++n) {
+		/* include the exact position of points */
+		const Beats b = (n % 4) ? Beats::ticks (rand () % (500 * 4 * Beats::PPQN)) : Beats ((rand () % 500) * 4, 0);
+		const superclock_t sc = (n % 4) ? (superclock_t) (end * (rand () / (double) RAND_MAX)) : indexed->superclock_at (b);
+
+		CPPUNIT_ASSERT_EQUAL (walked.superclock_at (b), indexed->superclock_at (b));
+		CPPUNIT_ASSERT_EQUAL (walked.quarters_at_superclock (sc), indexed->quarters_at_superclock (sc));
+		CPPUNIT_ASSERT_EQUAL (walked.bbt_at (b), indexed->bbt_at (b));
+		CPPUNIT_ASSERT_EQUAL (walked.tempo_at (sc).sclock (), indexed->tempo_at (sc).sclock ());
+		CPPUNIT_ASSERT_EQUAL (walked.meter_at (b).beats (), indexed->meter_at (b).beats ());
+
+		const BBT_Argument bbt (indexed->bbt_at (b));
+		CPPUNIT_ASSERT_EQUAL (walked.quarters_at (bbt), indexed->quarters_at (bbt));
+	}
+
+	Temporal::reset ();
+}
+
+void
+TempoMapIndexTest::benchmarkTest()
+{
+	const int n_tempos = 10000;
+	const int n_lookups = 20000;
+
+	TempoMap::SharedPtr indexed = publish_large_map (n_tempos);
+	TempoMap walked (*indexed);
+
+	const superclock_t end = indexed->superclock_at (Beats (n_tempos * 4, 0));
+
+	std::vector<superclock_t> sclocks;
+	std::vector<Beats>        beats;
+
+	srand (1);
+
+	for (int n = 0; n < n_lookups; ++n) {
+		sclocks.push_back ((superclock_t) (end * (rand () / (double) RAND_MAX)));
+		beats.push_back (Beats::ticks (rand () % (n_tempos * 4 * Beats::PPQN)));
+	}
+
+	PBD::microseconds_t t[2];
+	int64_t sum[2];
+
+	TempoMap const* maps[2] = { &walked, indexed.get () };
+
+	for (int m = 0; m < 2; ++m) {
+		PBD::microseconds_t const start = PBD::get_microseconds ();
+		sum[m] = 0;
+		for (int n = 0; n < n_lookups; ++n) {
+			sum[m] += maps[m]->quarters_at_superclock (sclocks[n]).to_ticks ();
+			sum[m] += maps[m]->sample_at (beats[n]);
+			sum[m] += maps[m]->bbt_at (beats[n]).bars;
+		}
+		t[m] = PBD::get_microseconds () - start;
+	}
+
+	std::cerr << "\nTempoMap with " << n_tempos << " tempos, " << n_lookups << " x (quarters_at, sample_at, bbt_at): "
+	          << "walk " << t[0] / 1000.0 << " ms, index " << t[1] / 1000.0 << " ms\n";
+
+	CPPUNIT_ASSERT_EQUAL (sum[0], sum[1]);
+
+	Temporal::reset ();
+}
@@ -0,0 +1,14 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class TempoMapIndexTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE(TempoMapIndexTest);
+	CPPUNIT_TEST(lookupTest);
+	CPPUNIT_TEST(benchmarkTest);
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void lookupTest();
+	void benchmarkTest();
+};
@@ -127,8 +127,6 @@ WaveView::~WaveView ()
 #ifdef ENABLE_THREADED_WAVEFORM_RENDERING
 	WaveViewThreads::deinitialize ();
 #endif
-
-	reset_cache_group ();
 }
 
 string
@@ -233,15 +231,79 @@ WaveView::set_clip_level (double dB)
 	}
 }
 
-std::shared_ptr<WaveViewDrawRequest>
-WaveView::create_draw_request (WaveViewProperties const& props) const
+void
+WaveView::tile_range (Rect const& self, Rect const& draw, int64_t& first, int64_t& last, double& origin) const
 {
-	assert (props.is_valid());
+	/* Calculate the sample that corresponds to the region-rectangle's left edge
+	 * in the editor at current zoom (see TimeAxisViewItem::set_position).
+	 */
+	double const           samples_per_pixel = _props->samples_per_pixel;
+	samplepos_t const      region_position   = _region->position().samples();
+	samplepos_t const      region_view_x     = round (round (region_position / samples_per_pixel) * samples_per_pixel);
+	ARDOUR::sampleoffset_t region_view_dx    = region_position - region_view_x;
+
+	/* the pixel that corresponds to the first sample of the source, tile N
+	 * starts at origin + N * WaveViewTile::width in item coordinates.
+	 */
+	origin = (region_view_dx - _props->region_start) / samples_per_pixel;
+
+	first = std::max<int64_t> (0, floor ((draw.x0 - self.x0 - origin) / WaveViewTile::width));
+	last  = std::max<int64_t> (first, ceil ((draw.x1 - self.x0 - origin) / WaveViewTile::width));
+}
+
+std::shared_ptr<WaveViewTile>
+WaveView::get_tile (int64_t index, bool draw_in_gui_thread) const
+{
+	std::shared_ptr<AudioSource> source = _region->audio_source (_props->channel);
+	assert (source);
+
+	WaveViewCache*        cache = WaveViewCache::get_instance ();
+	WaveViewTileKey const key (source.get (), *_props, index);
+
+	std::shared_ptr<WaveViewTile> tile = cache->lookup (key);
 
-	std::shared_ptr<WaveViewDrawRequest> request (new WaveViewDrawRequest);
+	if (!tile) {
+		/* the cache may have evicted a tile that is still in use */
+		for (std::vector<std::shared_ptr<WaveViewTile> >::const_iterator i = _tiles.begin (); i != _tiles.end (); ++i) {
+			if ((*i)->key == key) {
+				tile = *i;
+				cache->add (tile);
+				break;
+			}
+		}
+	}
+
+	if (tile) {
+		if (tile->source.lock () != source) {
+			// Tile of a deleted source that used the same address
+			tile.reset ();
+		} else if (tile->stopped ()) {
+			tile.reset ();
+		} else if (tile->finished () && tile->is_stale (source->length ().samples ())) {
+			tile.reset ();
+		}
+	}
+
+	if (tile) {
+		// The tile may not be finished at this point but that is fine, it is
+		// only drawn once.
+		return tile;
+	}
+
+	tile.reset (new WaveViewTile (key, source));
+
+	// Add it to the cache so that other WaveViews can refer to the same tile
+	cache->add (tile);
 
-	request->image = std::shared_ptr<WaveViewImage> (new WaveViewImage (_region, props));
-	return request;
+	std::shared_ptr<WaveViewDrawRequest> request (new WaveViewDrawRequest (_region, tile));
+
+	if (draw_in_gui_thread) {
+		process_draw_request (request);
+	} else {
+		WaveViewThreads::enqueue_draw_request (request);
+	}
+
+	return tile;
 }
 
 void
@@ -252,6 +314,10 @@ WaveView::prepare_for_render (Rect const& area) const
 		return;
 	}
 
+	if (_props->height < 1) {
+		return;
+	}
+
 	Rect draw_rect;
 	Rect self_rect;
 
@@ -260,29 +326,22 @@ WaveView::prepare_for_render (Rect const& area) const
 		return;
 	}
 
-	double const image_start_pixel_offset = draw_rect.x0 - self_rect.x0;
-	double const image_end_pixel_offset = draw_rect.x1 - self_rect.x0;
-
-	WaveViewProperties required_props = *_props;
+	int64_t first;
+	int64_t last;
+	double  origin;
 
-	required_props.set_sample_positions_from_pixel_offsets (image_start_pixel_offset,
-	                                                        image_end_pixel_offset);
+	tile_range (self_rect, draw_rect, first, last, origin);
 
-	if (!required_props.is_valid ()) {
-		return;
-	}
+	/* Also request the tiles on either side, so that they are likely
+	 * available when scrolling, as long as they are part of the region.
+	 */
+	double const  tile_samples = WaveViewTile::width * _props->samples_per_pixel;
+	int64_t const region_first = floor (_props->region_start / tile_samples);
+	int64_t const region_last  = ceil (_props->region_end / tile_samples);
 
-	if (_image) {
-		if (_image->props.is_equivalent (required_props)) {
-			return;
-		} else {
-			// Image does not contain sample area required
-		}
+	for (int64_t t = std::max (first - 1, region_first); t < std::min (last + 1, region_last); ++t) {
+		get_tile (t, false);
 	}
-
-	std::shared_ptr<WaveViewDrawRequest> request = create_draw_request (required_props);
-
-	queue_draw_request (request);
 }
 
 bool
@@ -348,42 +407,6 @@ WaveView::get_item_and_draw_rect_in_window_coords (Rect const& canvas_rect, Rect
 	return true;
 }
 
-void
-WaveView::queue_draw_request (std::shared_ptr<WaveViewDrawRequest> const& request) const
-{
-	// Don't enqueue any requests without a thread to dequeue them.
-	assert (WaveViewThreads::enabled());
-
-	if (!request || !request->is_valid()) {
-		return;
-	}
-
-	if (current_request) {
-		current_request->cancel ();
-	}
-
-	std::shared_ptr<WaveViewImage> cached_image =
-	    get_cache_group ()->lookup_image (request->image->props);
-
-	if (cached_image) {
-		// The image may not be finished at this point but that is fine, great in
-		// fact as it means it should only need to be drawn once.
-		request->image = cached_image;
-		current_request = request;
-	} else {
-		// now we can finally set an optimal image now that we are not using the
-		// properties for comparisons.
-		request->image->props.set_width_samples (optimal_image_width_samples ());
-
-		current_request = request;
-
-		// Add it to the cache so that other WaveViews can refer to the same image
-		get_cache_group()->add_image (current_request->image);
-
-		WaveViewThreads::enqueue_draw_request (current_request);
-	}
-}
-
 void
 WaveView::compute_tips (ARDOUR::PeakData const& peak, WaveView::LineTips& tips,
                         double const effective_height)
@@ -501,12 +524,12 @@ WaveView::draw_image (Cairo::RefPtr<Cairo::ImageSurface>& image, PeakData* peaks
 	   has been scaled by scale_amplitude() already.
 	*/
 
-	const double clip_level = _global_clip_level * fabs (req->image->props.amplitude);
+	const double clip_level = _global_clip_level * fabs (req->tile->key.amplitude);
 
-	const Shape shape = req->image->props.shape;
-	const bool logscaled = req->image->props.logscaled;
+	const Shape shape = req->tile->key.shape;
+	const bool logscaled = req->tile->key.logscaled;
 
-	if (req->image->props.shape == WaveView::Rectified) {
+	if (req->tile->key.shape == WaveView::Rectified) {
 
 		/* each peak is a line from the bottom of the waveview
 		 * to a point determined by max (peaks[i].max,
@@ -707,7 +730,7 @@ WaveView::draw_image (Cairo::RefPtr<Cairo::ImageSurface>& image, PeakData* peaks
 
 			/* zero line, show only if there is enough spread
 			or the waveform line does not cross zero line */
-			bool const show_zero_line = req->image->props.show_zero;
+			bool const show_zero_line = req->tile->key.show_zero;
 
 			if (show_zero_line && ((tips[i].spread >= 5.0) || (tips[i].top > height_zero ) || (tips[i].bot < height_zero)) ) {
 				zero_context->move_to (i, height_zero);
@@ -757,8 +780,8 @@ WaveView::draw_image (Cairo::RefPtr<Cairo::ImageSurface>& image, PeakData* peaks
 
 	/* Here we set a source colour and use the various components as a mask. */
 
-	const Color fill_color = req->image->props.fill_color;
-	const double gradient_depth = req->image->props.gradient_depth;
+	const Color fill_color = req->tile->key.fill_color;
+	const double gradient_depth = req->tile->key.gradient_depth;
 
 	if (gradient_depth != 0.0) {
 
@@ -804,99 +827,26 @@ WaveView::draw_image (Cairo::RefPtr<Cairo::ImageSurface>& image, PeakData* peaks
 	context->mask (images.wave, 0, 0);
 	context->fill ();
 
-	set_source_rgba (context, req->image->props.outline_color);
+	set_source_rgba (context, req->tile->key.outline_color);
 	context->mask (images.outline, 0, 0);
 	context->fill ();
 
-	set_source_rgba (context, req->image->props.clip_color);
+	set_source_rgba (context, req->tile->key.clip_color);
 	context->mask (images.clip, 0, 0);
 	context->fill ();
 
-	set_source_rgba (context, req->image->props.zero_color);
+	set_source_rgba (context, req->tile->key.zero_color);
 	context->mask (images.zero, 0, 0);
 	context->fill ();
 }
 
-samplecnt_t
-WaveView::optimal_image_width_samples () const
-{
-	/* Compute how wide the image should be in samples.
-	 *
-	 * The resulting image should be wider than the canvas width so that the
-	 * image does not have to be redrawn each time the canvas offset changes, but
-	 * drawing too much unnecessarily, for instance when zooming into the canvas
-	 * the part of the image that is outside of the visible canvas area may never
-	 * be displayed and will just increase apparent render time and reduce
-	 * responsiveness in non-threaded rendering and cause "flashing" waveforms in
-	 * threaded rendering mode.
-	 *
-	 * Another thing to consider is that if there are a number of waveforms on
-	 * the canvas that are the width of the canvas then we don't want to have to
-	 * draw the images for them all at once as it will cause a spike in render
-	 * time, or in threaded rendering mode it will mean all the draw requests will
-	 * the queued during the same sample/expose event. This issue can be
-	 * alleviated by using an element of randomness in selecting the image width.
-	 *
-	 * If the value of samples per pixel is less than 1/10th of a second, use
-	 * 1/10th of a second instead.
-	 */
-
-	samplecnt_t canvas_width_samples = _canvas->visible_area().width() * _props->samples_per_pixel;
-	const samplecnt_t one_tenth_of_second = _region->session().sample_rate() / 10;
-
-	/* If zoomed in where a canvas item interects with the canvas area but
-	 * stretches for many pages either side, to avoid having draw all images when
-	 * the canvas scrolls by a page width the multiplier would have to be a
-	 * randomized amount centered around 3 times the visible canvas width, but
-	 * for other operations like zooming or even with a stationary playhead it is
-	 * a lot of extra drawing that can affect performance.
-	 *
-	 * So without making things too complicated with different widths for
-	 * different operations, try to use a width that is a balance and will work
-	 * well for scrolling(non-page width) so all the images aren't redrawn at the
-	 * same time but also faster for sequential zooming operations.
-	 *
-	 * Canvas items that don't intersect with the edges of the visible canvas
-	 * will of course only draw images that are the pixel width of the item.
-	 *
-	 * It is a perhaps a coincidence that these values are centered roughly
-	 * around the golden ratio but they did work well in my testing.
-	 */
-	const double min_multiplier = 1.4;
-	const double max_multiplier = 1.8;
-
-	/**
-	 * A combination of high resolution screens, high samplerates and high
-	 * zoom levels(1 sample per pixel) can cause 1/10 of a second(in
-	 * pixels) to exceed the cairo image size limit.
-	 */
-	const double cairo_image_limit = 32767.0;
-	const double max_image_width = cairo_image_limit / max_multiplier;
-
-	samplecnt_t max_width_samples = floor (max_image_width / _props->samples_per_pixel);
-
-	const samplecnt_t one_tenth_of_second_limited = std::min (one_tenth_of_second, max_width_samples);
-
-	samplecnt_t new_sample_count = std::max (canvas_width_samples, one_tenth_of_second_limited);
-
-	const double multiplier = g_random_double_range (min_multiplier, max_multiplier);
-
-	return new_sample_count * multiplier;
-}
-
-void
-WaveView::set_image (std::shared_ptr<WaveViewImage> img) const
-{
-	get_cache_group ()->add_image (img);
-	_image = img;
-}
-
 void
 WaveView::process_draw_request (std::shared_ptr<WaveViewDrawRequest> req)
 {
-	std::shared_ptr<const ARDOUR::AudioRegion> region = req->image->region.lock();
+	std::shared_ptr<const ARDOUR::AudioRegion> region = req->region.lock();
+	std::shared_ptr<ARDOUR::AudioSource>       source = req->tile->source.lock();
 
-	if (!region) {
+	if (!region || !source) {
 		return;
 	}
 
@@ -906,33 +856,36 @@ WaveView::process_draw_request (std::shared_ptr<WaveViewDrawRequest> req)
 
 	(void) Temporal::TempoMap::fetch();
 
-	WaveViewProperties const& props = req->image->props;
+	WaveViewTile&          tile = *req->tile;
+	WaveViewTileKey const& key  = tile.key;
 
-	const int n_peaks = props.get_width_pixels ();
-
-	assert (n_peaks > 0 && n_peaks < 32767);
+	const int n_peaks = WaveViewTile::width;
 
 	std::unique_ptr<ARDOUR::PeakData[]> peaks (new PeakData[n_peaks]);
 
+	/* data that is added to the source after this, is drawn again */
+	samplepos_t const source_length = source->length ().samples ();
+	samplepos_t const sample_start  = tile.sample_start ();
+	samplepos_t const sample_end    = tile.sample_end ();
+
 	/* Note that Region::read_peaks() takes a start position based on an
 	   offset into the Region's **SOURCE**, rather than an offset into
 	   the Region itself.
 	*/
 
 	samplecnt_t peaks_read =
-	    region->read_peaks (peaks.get (), n_peaks, props.get_sample_start (),
-	                        props.get_length_samples (), props.channel, props.samples_per_pixel);
+	    region->read_peaks (peaks.get (), n_peaks, sample_start,
+	                        sample_end - sample_start, key.channel, key.samples_per_pixel);
 
 	if (req->stopped()) {
 		return;
 	}
 
 	Cairo::RefPtr<Cairo::ImageSurface> cairo_image =
-	    Cairo::ImageSurface::create (Cairo::FORMAT_ARGB32, n_peaks, req->image->props.height);
+	    Cairo::ImageSurface::create (Cairo::FORMAT_ARGB32, n_peaks, key.height);
 
 	// https://cairographics.org/manual/cairo-Image-Surfaces.html#cairo-image-surface-create
 	// This function always returns a valid pointer, but it will return a pointer to a "nil" surface..
-	// but there's some evidence that req->image can be NULL.
 	// https://tracker.ardour.org/view.php?id=6478
 	assert (cairo_image);
 
@@ -944,7 +897,7 @@ WaveView::process_draw_request (std::shared_ptr<WaveViewDrawRequest> req)
 		 * rendering.
 		 */
 
-		const double amplitude_above_axis = props.amplitude_above_axis;
+		const double amplitude_above_axis = key.amplitude_above_axis;
 
 		if (amplitude_above_axis != 1.0) {
 			for (samplecnt_t i = 0; i < n_peaks; ++i) {
@@ -963,9 +916,12 @@ WaveView::process_draw_request (std::shared_ptr<WaveViewDrawRequest> req)
 		return;
 	}
 
-	// Assign now that we are sure all drawing is complete as that is what
-	// determines whether a request was finished.
-	req->image->cairo_image = cairo_image;
+	/* without peak data, the tile is stale until peaks are available */
+	tile.valid_end   = peaks_read > 0 ? std::min (sample_end, source_length) : sample_start;
+	tile.cairo_image = cairo_image;
+
+	// Set finished now that we are sure all drawing is complete
+	tile.set_finished ();
 }
 
 bool
@@ -1006,163 +962,88 @@ WaveView::render (Rect const & area, Cairo::RefPtr<Cairo::Context> context) cons
 		return;
 	}
 
-	double const image_start_pixel_offset = draw.x0 - self.x0;
-	double const image_end_pixel_offset = draw.x1 - self.x0;
-
-	if (image_start_pixel_offset == image_end_pixel_offset) {
+	if (draw.x0 == draw.x1) {
 		// this may happen if zoomed very far out with a small region
 		return;
 	}
 
-	WaveViewProperties required_props = *_props;
-
-	required_props.set_sample_positions_from_pixel_offsets (image_start_pixel_offset,
-	                                                        image_end_pixel_offset);
+	int64_t first;
+	int64_t last;
+	double  origin;
 
-	assert (required_props.is_valid());
+	tile_range (self, draw, first, last, origin);
 
-	std::shared_ptr<WaveViewImage> image_to_draw;
-
-	if (current_request) {
-		if (!current_request->image->props.is_equivalent (required_props)) {
-			// The WaveView properties may have been updated during recording between
-			// prepare_for_render and render calls and the new required props have
-			// different end sample value.
-			current_request->cancel ();
-			current_request.reset ();
-		} else if (current_request->finished ()) {
-			image_to_draw = current_request->image;
-			current_request.reset ();
-		}
-	} else {
-		// No current Request
-	}
+	bool const in_gui_thread = draw_image_in_gui_thread ();
+	bool       pending       = false;
 
-	if (!image_to_draw && _image) {
-		if (_image->props.is_equivalent (required_props)) {
-			// Image contains required properties
-			image_to_draw = _image;
-		} else {
-			// Image does not contain properties required
-		}
-	}
+	std::vector<std::shared_ptr<WaveViewTile> > tiles;
+	tiles.reserve (last - first);
 
-	if (!image_to_draw) {
-		image_to_draw = get_cache_group ()->lookup_image (required_props);
-		if (image_to_draw && !image_to_draw->finished ()) {
-			// Found equivalent but unfinished Image in cache
-			image_to_draw.reset ();
-		}
-	}
+	for (int64_t t = first; t < last; ++t) {
 
-	if (!image_to_draw) {
-		// No existing image to draw
+		std::shared_ptr<WaveViewTile> tile = get_tile (t, in_gui_thread);
 
-		std::shared_ptr<WaveViewDrawRequest> const request = create_draw_request (required_props);
+		tiles.push_back (tile);
 
-		if (draw_image_in_gui_thread ()) {
-			// now that we have to draw something, draw more than required.
-			request->image->props.set_width_samples (optimal_image_width_samples ());
+		if (!tile->finished ()) {
+			pending = true;
+			/* until the tile is drawn, scale one that was drawn for a
+			 * different height (or a stale one), if there is one.
+			 */
+			tile = WaveViewCache::get_instance ()->lookup_any_height (tile->key);
+			if (!tile) {
+				continue;
+			}
+		}
 
-			process_draw_request (request);
+		/* round tile origin position to an exact pixel in device space to
+		 * avoid blurring
+		 */
 
-			image_to_draw = request->image;
+		double x  = self.x0 + origin + t * WaveViewTile::width;
+		double y  = self.y0;
+		context->user_to_device (x, y);
+		x = floor (x);
+		y = floor (y);
+		context->device_to_user (x, y);
 
-		} else if (current_request) {
-			if (current_request->finished ()) {
-				// There is a chance the request is now finished since checking above
-				image_to_draw = current_request->image;
-				current_request.reset ();
-			} else if (_canvas->get_microseconds_since_render_start () < 15000) {
-				current_request->cancel ();
-				current_request.reset ();
+		double const x0 = max (draw.x0, x);
+		double const x1 = min (draw.x1, x + WaveViewTile::width);
 
-				// Drawing image in GUI thread as we have time
+		if (x1 <= x0) {
+			continue;
+		}
 
-				// now that we have to draw something, draw more than required.
-				request->image->props.set_width_samples (optimal_image_width_samples ());
+		context->rectangle (x0, draw.y0, x1 - x0, draw.height());
 
-				process_draw_request (request);
+		/* the coordinates specify where in "user coordinates" (i.e. what we
+		 * generally call "canvas coordinates" in this code) the image origin
+		 * will appear. So specifying (10,10) will put the upper left corner of
+		 * the image at (10,10) in user space.
+		 */
 
-				image_to_draw = request->image;
-			} else {
-				// Waiting for current request to finish
-				redraw ();
-				return;
-			}
+		if (tile->key.height == _props->height) {
+			context->set_source (tile->cairo_image, x, y);
+			context->fill ();
 		} else {
-			// Defer the rendering to another thread or perhaps render pass if
-			// a thread cannot generate it in time.
-			queue_draw_request (request);
-			redraw ();
-			return;
+			context->save ();
+			context->translate (x, y);
+			context->scale (1.0, _props->height / tile->key.height);
+			context->set_source (tile->cairo_image, 0, 0);
+			context->fill ();
+			context->restore ();
 		}
 	}
 
+	_tiles.swap (tiles);
+
 	/* reset this so that future missing images can be generated in a worker thread. */
 	_draw_image_in_gui_thread = false;
 
-	assert (image_to_draw);
-
-	/* Calculate the sample that corresponds to the region-rectangle's left edge
-	 * in the editor at current zoom (see TimeAxisViewItem::set_position).
-	 */
-	double const           samples_per_pixel = _props->samples_per_pixel;
-	samplepos_t const      region_position   = _region->position().samples();
-	samplepos_t const      region_view_x     = round (round (region_position / samples_per_pixel) * samples_per_pixel);
-	ARDOUR::sampleoffset_t region_view_dx    = region_position - region_view_x;
-
-	/* compute the first pixel of the image that should be used when we
-	 * render the specified range.
-	 */
-
-	double image_origin_in_self_coordinates = (image_to_draw->props.get_sample_start () - _props->region_start + region_view_dx) / samples_per_pixel;
-
-	/* the image may only be a best-effort ... it may not span the entire
-	 * range requested, though it is guaranteed to cover the start. So
-	 * determine how many pixels we can actually draw.
-	 */
-
-	const double draw_start_pixel = draw.x0;
-	const double draw_end_pixel = draw.x1;
-
-	double draw_width_pixels = draw_end_pixel - draw_start_pixel;
-
-	if (image_to_draw != _image) {
-
-		/* the image is guaranteed to start at or before
-		 * draw_start. But if it starts before draw_start, that reduces
-		 * the maximum available width we can render with.
-		 *
-		 * so .. clamp the draw width to the smaller of what we need to
-		 * draw or the available width of the image.
-		 */
-		draw_width_pixels = min ((double)image_to_draw->cairo_image->get_width (), draw_width_pixels);
-
-		set_image (image_to_draw);
+	if (pending) {
+		// Wait for worker threads to finish the remaining tiles
+		redraw ();
 	}
-
-	context->rectangle (draw_start_pixel, draw.y0, draw_width_pixels, draw.height());
-
-	/* round image origin position to an exact pixel in device space to
-	 * avoid blurring
-	 */
-
-	double x  = self.x0 + image_origin_in_self_coordinates;
-	double y  = self.y0;
-	context->user_to_device (x, y);
-	x = floor (x);
-	y = floor (y);
-	context->device_to_user (x, y);
-
-	/* the coordinates specify where in "user coordinates" (i.e. what we
-	 * generally call "canvas coordinates" in this code) the image origin
-	 * will appear. So specifying (10,10) will put the upper left corner of
-	 * the image at (10,10) in user space.
-	 */
-
-	context->set_source (image_to_draw->cairo_image, x, y);
-	context->fill ();
 }
 
 void
@@ -1187,7 +1068,6 @@ WaveView::set_height (Distance height)
 		begin_change ();
 
 		_props->height = height;
-		_draw_image_in_gui_thread = true;
 
 		set_bbox_dirty ();
 		end_change ();
@@ -1200,7 +1080,6 @@ WaveView::set_channel (int channel)
 	if (_props->channel != channel) {
 		begin_change ();
 		_props->channel = channel;
-		reset_cache_group ();
 		set_bbox_dirty ();
 		end_change ();
 	}
@@ -1407,24 +1286,3 @@ WaveView::set_image_cache_size (uint64_t sz)
 {
 	WaveViewCache::get_instance()->set_image_cache_threshold (sz);
 }
-
-std::shared_ptr<WaveViewCacheGroup>
-WaveView::get_cache_group () const
-{
-	if (_cache_group) {
-		return _cache_group;
-	}
-
-	std::shared_ptr<AudioSource> source = _region->audio_source (_props->channel);
-	assert (source);
-
-	_cache_group = WaveViewCache::get_instance ()->get_cache_group (source);
-
-	return _cache_group;
-}
-
-void
-WaveView::reset_cache_group ()
-{
-	WaveViewCache::get_instance()->reset_cache_group (_cache_group);
-}
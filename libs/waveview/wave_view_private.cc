@@ -20,7 +20,6 @@
 #include <cmath>
 #include "ardour/lmath.h"
 
-#include "pbd/assert.h"
 #include "pbd/cpus.h"
 #include "pbd/pthread_utils.h"
 
@@ -48,118 +47,76 @@ WaveViewProperties::WaveViewProperties (std::shared_ptr<ARDOUR::AudioRegion> reg
     , shape (WaveView::global_shape())
     , gradient_depth (WaveView::global_gradient_depth ())
     , start_shift (0.0) // currently unused
-    , sample_start (0)
-    , sample_end (0)
 {
 
 }
 
 /*-------------------------------------------------*/
 
-WaveViewImage::WaveViewImage (std::shared_ptr<const ARDOUR::AudioRegion> const& region_ptr,
-                              WaveViewProperties const& properties)
-	: region (region_ptr)
-	, props (properties)
-	, timestamp (0)
+WaveViewTileKey::WaveViewTileKey (ARDOUR::AudioSource const* src, WaveViewProperties const& props, int64_t tile_index)
+	: source (src)
+	, tile (tile_index)
+	, samples_per_pixel (props.samples_per_pixel)
+	, channel (props.channel)
+	, height (props.height)
+	, amplitude (props.amplitude)
+	, amplitude_above_axis (props.amplitude_above_axis)
+	, fill_color (props.fill_color)
+	, outline_color (props.outline_color)
+	, zero_color (props.zero_color)
+	, clip_color (props.clip_color)
+	, show_zero (props.show_zero)
+	, logscaled (props.logscaled)
+	, shape (props.shape)
+	, gradient_depth (props.gradient_depth)
 {
-
 }
 
-WaveViewImage::~WaveViewImage ()
+bool
+WaveViewTileKey::operator== (WaveViewTileKey const& other) const
 {
-
+	return (source == other.source && tile == other.tile &&
+	        samples_per_pixel == other.samples_per_pixel && channel == other.channel &&
+	        height == other.height && amplitude == other.amplitude &&
+	        amplitude_above_axis == other.amplitude_above_axis && fill_color == other.fill_color &&
+	        outline_color == other.outline_color && zero_color == other.zero_color &&
+	        clip_color == other.clip_color && show_zero == other.show_zero &&
+	        logscaled == other.logscaled && shape == other.shape &&
+	        gradient_depth == other.gradient_depth);
 }
 
-/*-------------------------------------------------*/
-
-WaveViewCacheGroup::WaveViewCacheGroup (WaveViewCache& parent_cache)
-	: _parent_cache (parent_cache)
+static inline void
+hash_combine (size_t& seed, size_t v)
 {
-
+	seed ^= v + 0x9e3779b9 + (seed << 6) + (seed >> 2);
 }
 
-WaveViewCacheGroup::~WaveViewCacheGroup ()
+size_t
+WaveViewTileKey::Hash::operator() (WaveViewTileKey const& k) const
 {
-	clear_cache ();
+	/* the remaining properties rarely differ between tiles */
+	size_t h = std::hash<ARDOUR::AudioSource const*> () (k.source);
+	hash_combine (h, std::hash<int64_t> () (k.tile));
+	hash_combine (h, std::hash<double> () (k.samples_per_pixel));
+	hash_combine (h, std::hash<double> () (k.height));
+	hash_combine (h, k.channel);
+	return h;
 }
 
-void
-WaveViewCacheGroup::add_image (std::shared_ptr<WaveViewImage> image)
-{
-	if (!image) {
-		// Not adding invalid image to cache
-		return;
-	}
-
-	ImageCache::iterator oldest_image_it = _cached_images.begin();
-	ImageCache::iterator second_oldest_image_it = _cached_images.end();
-
-	for (ImageCache::iterator it = _cached_images.begin (); it != _cached_images.end (); ++it) {
-		if ((*it) == image) {
-			// Must never be more than one instance of the image in the cache
-			(*it)->timestamp = g_get_monotonic_time ();
-			return;
-		} else if ((*it)->props.is_equivalent (image->props)) {
-			// Equivalent Image already in cache, updating timestamp
-			(*it)->timestamp = g_get_monotonic_time ();
-			return;
-		}
-
-		if ((*it)->timestamp < (*oldest_image_it)->timestamp) {
-			second_oldest_image_it = oldest_image_it;
-			oldest_image_it = it;
-		}
-	}
-
-	// no duplicate or equivalent image so we are definitely adding it to cache
-	image->timestamp = g_get_monotonic_time ();
-
-	if (_parent_cache.full () || full ()) {
-		if (oldest_image_it != _cached_images.end()) {
-			// Replacing oldest Image in cache
-			_parent_cache.decrease_size ((*oldest_image_it)->size_in_bytes ());
-			*oldest_image_it = image;
-			_parent_cache.increase_size (image->size_in_bytes ());
-
-			if (second_oldest_image_it != _cached_images.end ()) {
-				// Removing second oldest Image in cache
-				_parent_cache.decrease_size ((*second_oldest_image_it)->size_in_bytes ());
-				_cached_images.erase (second_oldest_image_it);
-			}
-			return;
-		} else {
-			/**
-			 * Add the image to the cache even if the threshold is exceeded so that
-			 * new WaveViews can still cache images with a full cache, the size of
-			 * the cache will quickly equalize back to the threshold as new images
-			 * are added and the size of the cache is reduced.
-			 */
-		}
-	}
-
-	_cached_images.push_back (image);
-	_parent_cache.increase_size (image->size_in_bytes ());
-}
+/*-------------------------------------------------*/
 
-std::shared_ptr<WaveViewImage>
-WaveViewCacheGroup::lookup_image (WaveViewProperties const& props)
+WaveViewTile::WaveViewTile (WaveViewTileKey const& k, std::shared_ptr<ARDOUR::AudioSource> const& src)
+	: key (k)
+	, source (src)
+	, valid_end (0)
 {
-	for (ImageCache::iterator i = _cached_images.begin (); i != _cached_images.end (); ++i) {
-		if ((*i)->props.is_equivalent (props)) {
-			return (*i);
-		}
-	}
-	return std::shared_ptr<WaveViewImage>();
+	_finished.store (0);
+	_stop.store (0);
 }
 
-void
-WaveViewCacheGroup::clear_cache ()
+WaveViewTile::~WaveViewTile ()
 {
-	// Tell the parent cache about the images we are about to drop references to
-	for (ImageCache::iterator it = _cached_images.begin (); it != _cached_images.end (); ++it) {
-		_parent_cache.decrease_size ((*it)->size_in_bytes ());
-	}
-	_cached_images.clear ();
+
 }
 
 /*-------------------------------------------------*/
@@ -182,75 +139,127 @@ WaveViewCache::get_instance ()
 	return instance;
 }
 
-void
-WaveViewCache::increase_size (uint64_t bytes)
+static inline WaveViewTileKey
+any_height (WaveViewTileKey const& key)
 {
-	image_cache_size += bytes;
+	WaveViewTileKey k (key);
+	k.height = 0;
+	return k;
 }
 
 void
-WaveViewCache::decrease_size (uint64_t bytes)
+WaveViewCache::remember_finished (std::shared_ptr<WaveViewTile> const& tile)
 {
-	assert (bytes > 0);
-	assert (bytes <= image_cache_size);
-	image_cache_size -= bytes;
+	_latest[any_height (tile->key)] = tile;
+}
+
+std::shared_ptr<WaveViewTile>
+WaveViewCache::lookup (WaveViewTileKey const& key)
+{
+	TileMap::iterator it = _tile_map.find (key);
+
+	if (it == _tile_map.end ()) {
+		return std::shared_ptr<WaveViewTile> ();
+	}
+
+	/* move to front, iterators remain valid */
+	_tiles.splice (_tiles.begin (), _tiles, it->second);
+
+	std::shared_ptr<WaveViewTile> tile = *it->second;
+
+	if (tile->finished ()) {
+		remember_finished (tile);
+	}
+
+	return tile;
 }
 
-std::shared_ptr<WaveViewCacheGroup>
-WaveViewCache::get_cache_group (std::shared_ptr<ARDOUR::AudioSource> source)
+std::shared_ptr<WaveViewTile>
+WaveViewCache::lookup_any_height (WaveViewTileKey const& key)
 {
-	CacheGroups::iterator it = cache_group_map.find (source);
+	LatestMap::iterator it = _latest.find (any_height (key));
 
-	if (it != cache_group_map.end()) {
-		// Found existing CacheGroup for AudioSource
-		return it->second;
+	if (it == _latest.end ()) {
+		return std::shared_ptr<WaveViewTile> ();
 	}
 
-	std::shared_ptr<WaveViewCacheGroup> new_group (new WaveViewCacheGroup (*this));
+	std::shared_ptr<WaveViewTile> tile = it->second.lock ();
 
-	bool inserted = cache_group_map.insert (std::make_pair (source, new_group)).second;
-	x_assert (inserted, inserted);
+	if (!tile) {
+		_latest.erase (it);
+	}
 
-	return new_group;
+	return tile;
 }
 
 void
-WaveViewCache::reset_cache_group (std::shared_ptr<WaveViewCacheGroup>& group)
+WaveViewCache::add (std::shared_ptr<WaveViewTile> tile)
 {
-	if (!group) {
+	if (!tile) {
 		return;
 	}
 
-	CacheGroups::iterator it = cache_group_map.begin();
+	TileMap::iterator it = _tile_map.find (tile->key);
 
-	while (it != cache_group_map.end()) {
-		if (it->second == group) {
-			break;
-		}
-		++it;
+	if (it != _tile_map.end ()) {
+		// Replacing stale tile
+		image_cache_size -= (*it->second)->size_in_bytes ();
+		_tiles.erase (it->second);
+		_tile_map.erase (it);
 	}
 
-	assert (it != cache_group_map.end ());
+	_tiles.push_front (tile);
+	_tile_map.insert (std::make_pair (tile->key, _tiles.begin ()));
+	image_cache_size += tile->size_in_bytes ();
+
+	if (tile->finished ()) {
+		remember_finished (tile);
+	}
 
-	group.reset();
+	evict ();
+}
 
-	if (it->second.unique()) {
-		cache_group_map.erase (it);
+void
+WaveViewCache::evict ()
+{
+	/* never drop the most recently used tile, so that a tile can be
+	 * added even if it exceeds the threshold by itself.
+	 */
+	while (full () && _tiles.size () > 1) {
+		std::shared_ptr<WaveViewTile> tile = _tiles.back ();
+
+		LatestMap::iterator l = _latest.find (any_height (tile->key));
+		if (l != _latest.end () && (l->second.expired () || l->second.lock () == tile)) {
+			_latest.erase (l);
+		}
+
+		_tile_map.erase (tile->key);
+		_tiles.pop_back ();
+
+		assert (tile->size_in_bytes () <= image_cache_size);
+		image_cache_size -= tile->size_in_bytes ();
 	}
 }
 
 void
 WaveViewCache::clear_cache ()
 {
-	for (CacheGroups::iterator it = cache_group_map.begin (); it != cache_group_map.end (); ++it) {
-		(*it).second->clear_cache ();
+	for (TileList::iterator it = _tiles.begin (); it != _tiles.end (); ++it) {
+		if (!(*it)->finished ()) {
+			(*it)->cancel ();
+		}
 	}
+	_tiles.clear ();
+	_tile_map.clear ();
+	_latest.clear ();
+	image_cache_size = 0;
 }
 
 void
 WaveViewCache::set_image_cache_threshold (uint64_t sz)
 {
 	_image_cache_threshold = sz;
+	evict ();
 }
 
 /*-------------------------------------------------*/
@@ -377,9 +386,10 @@ WaveViewThreads::stop_threads ()
 }
 
 /*-------------------------------------------------*/
-WaveViewDrawRequest::WaveViewDrawRequest ()
+WaveViewDrawRequest::WaveViewDrawRequest (std::shared_ptr<const ARDOUR::AudioRegion> const& r, std::shared_ptr<WaveViewTile> const& t)
+	: region (r)
+	, tile (t)
 {
-	_stop.store (0);
 }
 
 WaveViewDrawRequest::~WaveViewDrawRequest ()
@@ -504,8 +514,8 @@ WaveViewThreads::_thread_proc ()
 			try {
 				WaveView::process_draw_request (req);
 			} catch (...) {
-				/* just in case it was set before the exception, whatever it was */
-				req->image->cairo_image.clear ();
+				/* the tile is never finished, a WaveView will request a new one */
+				req->cancel ();
 			}
 		}
 	}
@@ -22,6 +22,7 @@
 #define _WAVEVIEW_WAVE_VIEW_H_
 
 #include <memory>
+#include <vector>
 
 #include <glibmm/refptr.h>
 
@@ -39,12 +40,11 @@ namespace Gdk {
 
 namespace ArdourWaveView {
 
-class WaveViewCacheGroup;
 class WaveViewDrawRequest;
 class WaveViewDrawRequestQueue;
-class WaveViewImage;
 class WaveViewProperties;
 class WaveViewDrawingThread;
+class WaveViewTile;
 
 class LIBWAVEVIEW_API WaveView : public ArdourCanvas::Item, public sigc::trackable
 {
@@ -64,11 +64,11 @@ public:
 	   when drawing, we will map the zeroth-pixel of the waveview
 	   into a window.
 
-	   The waveview itself contains a set of pre-rendered Cairo::ImageSurfaces
-	   that cache sections of the display. This is filled on-demand and
-	   never cleared until something explicitly marks the cache invalid
-	   (such as a change in samples_per_pixel, the log scaling, rectified or
-	   other view parameters).
+	   The display is composed of fixed-width tiles, pre-rendered into
+	   Cairo::ImageSurfaces. Tiles are aligned to the start of the source
+	   and kept in a global cache, shared by all waveviews of the source
+	   until they are evicted (or something explicitly clears the cache).
+	   Tiles that have not been rendered before are drawn by worker threads.
 	*/
 
 	WaveView (ArdourCanvas::Canvas*, std::shared_ptr<ARDOUR::AudioRegion>);
@@ -153,9 +153,10 @@ private:
 
 	const std::unique_ptr<WaveViewProperties> _props;
 
-	mutable std::shared_ptr<WaveViewImage> _image;
-
-	mutable std::shared_ptr<WaveViewCacheGroup> _cache_group;
+	/** tiles used by the most recent render, these are kept even
+	 * if the cache evicts them.
+	 */
+	mutable std::vector<std::shared_ptr<WaveViewTile> > _tiles;
 
 	bool _shape_independent;
 	bool _logscaled_independent;
@@ -174,14 +175,14 @@ private:
 	ARDOUR::samplepos_t region_end () const;
 
 	/**
-	 * _image stays non-null after the first time it is set
+	 * _tiles stays non-empty after the first render
 	 */
-	bool rendered () const { return _image.get(); }
+	bool rendered () const { return !_tiles.empty (); }
 
 	bool draw_image_in_gui_thread () const;
 
-	/** If true, calls to render() will render a missing wave image in the GUI
-	 * thread. Generally set to false, but true after a call to set_height().
+	/** If true, calls to render() will render missing tiles in the GUI
+	 * thread. Generally set to false, but true after a change of gain.
 	 */
 	mutable bool _draw_image_in_gui_thread;
 
@@ -193,8 +194,6 @@ private:
 
 	void init();
 
-	mutable std::shared_ptr<WaveViewDrawRequest> current_request;
-
 	PBD::ScopedConnectionList invalidation_connection;
 
 	static double _global_gradient_depth;
@@ -226,29 +225,25 @@ private:
 	                        std::shared_ptr<WaveViewDrawRequest>);
 	static void draw_absent_image (Cairo::RefPtr<Cairo::ImageSurface>&, ARDOUR::PeakData*, int);
 
-	ARDOUR::samplecnt_t optimal_image_width_samples () const;
-
-	void set_image (std::shared_ptr<WaveViewImage> img) const;
-
 	// @return true if item area intersects with draw area
 	bool get_item_and_draw_rect_in_window_coords (ArdourCanvas::Rect const& canvas_rect,
 	                                              ArdourCanvas::Rect& item_area,
 	                                              ArdourCanvas::Rect& draw_rect) const;
 
-	std::shared_ptr<WaveViewDrawRequest> create_draw_request (WaveViewProperties const&) const;
+	/** Compute the tiles that intersect \p draw_rect.
+	 * @param first first tile index
+	 * @param last tile index after the last one
+	 * @param origin position of the start of the source in item coordinates
+	 */
+	void tile_range (ArdourCanvas::Rect const& item_rect, ArdourCanvas::Rect const& draw_rect,
+	                 int64_t& first, int64_t& last, double& origin) const;
 
-	void queue_draw_request (std::shared_ptr<WaveViewDrawRequest> const&) const;
+	/** Find the tile with the current properties in the cache, or
+	 * create it and draw it, either immediately or in a worker thread.
+	 */
+	std::shared_ptr<WaveViewTile> get_tile (int64_t index, bool draw_in_gui_thread) const;
 
 	static void process_draw_request (std::shared_ptr<WaveViewDrawRequest>);
-
-	std::shared_ptr<WaveViewCacheGroup> get_cache_group () const;
-
-	/**
-	 * Notify the Cache that we are dropping our reference to the
-	 * CacheGroup so it can also do so if it is the only reference holder
-	 * of the cache group.
-	 */
-	void reset_cache_group ();
 };
 
 } /* namespace */
@@ -20,6 +20,8 @@
 #define _WAVEVIEW_WAVE_VIEW_PRIVATE_H_
 
 #include <deque>
+#include <list>
+#include <unordered_map>
 
 #include "pbd/mutex.h"
 #include "pbd/pthread_utils.h"
@@ -27,6 +29,7 @@
 
 namespace ARDOUR {
 	class AudioRegion;
+	class AudioSource;
 }
 
 namespace ArdourWaveView {
@@ -58,201 +61,114 @@ public: // member variables
 	WaveView::Shape       shape;
 	double                gradient_depth;
 	double                start_shift;
+};
 
-private: // member variables
+/** Identifies one tile of rendered waveform: a fixed number of pixels
+ * of a source channel at a given zoom level, together with all visual
+ * properties that affect how it is drawn.
+ *
+ * Tiles are aligned to the start of the source, so that all regions that
+ * use the same source share them, regardless of their start offset.
+ */
+struct WaveViewTileKey
+{
+public: // ctors
+	WaveViewTileKey (ARDOUR::AudioSource const*, WaveViewProperties const&, int64_t tile_index);
 
-	samplepos_t            sample_start;
-	samplepos_t            sample_end;
+public: // member variables
+	ARDOUR::AudioSource const* source;
+	int64_t                    tile;
+	double                     samples_per_pixel;
+	uint16_t                   channel;
+	double                     height;
+	double                     amplitude;
+	double                     amplitude_above_axis;
+	Gtkmm2ext::Color           fill_color;
+	Gtkmm2ext::Color           outline_color;
+	Gtkmm2ext::Color           zero_color;
+	Gtkmm2ext::Color           clip_color;
+	bool                       show_zero;
+	bool                       logscaled;
+	WaveView::Shape            shape;
+	double                     gradient_depth;
 
 public: // methods
+	bool operator== (WaveViewTileKey const&) const;
 
-	bool is_valid () const
-	{
-		return (sample_end != 0 && samples_per_pixel != 0);
-	}
-
-	void set_width_samples (ARDOUR::samplecnt_t const width_samples)
-	{
-		assert (is_valid());
-		assert (width_samples != 0);
-		ARDOUR::samplecnt_t half_width = width_samples / 2;
-		samplepos_t new_sample_start = std::max (region_start, get_center_sample () - half_width);
-		samplepos_t new_sample_end = std::min (get_center_sample () + half_width, region_end);
-		assert (new_sample_start <= new_sample_end);
-		sample_start = new_sample_start;
-		sample_end = new_sample_end;
-	}
-
-	uint64_t get_width_pixels () const
-	{
-		return (uint64_t)std::max (1LL, llrint (ceil (get_length_samples () / samples_per_pixel)));
-	}
-
-
-	void set_sample_offsets (samplepos_t const start, samplepos_t const end)
-	{
-		assert (start <= end);
-
-		// sample_start and sample_end are bounded by the region limits.
-		if (start < region_start) {
-			sample_start = region_start;
-		} else if (start > region_end) {
-			sample_start = region_end;
-		} else {
-			sample_start = start;
-		}
-
-		if (end > region_end) {
-			sample_end = region_end;
-		} else if (end < region_start) {
-			sample_end = region_start;
-		} else {
-			sample_end = end;
-		}
-
-		assert (sample_start <= sample_end);
-	}
-
-	samplepos_t get_sample_start () const
-	{
-		return sample_start;
-	}
-
-	samplepos_t get_sample_end () const
-	{
-		return sample_end;
-	}
-
-	void set_sample_positions_from_pixel_offsets (double start_pixel, double end_pixel)
-	{
-		assert (start_pixel <= end_pixel);
-		/**
-		 * It is possible for the new sample positions to be past the region_end,
-		 * so we have to do bounds checking/adjustment for this in set_sample_offsets.
-		 */
-		samplepos_t new_sample_start = region_start + (start_pixel * samples_per_pixel);
-		samplepos_t new_sample_end = region_start + (end_pixel * samples_per_pixel);
-		set_sample_offsets (new_sample_start, new_sample_end);
-	}
-
-	ARDOUR::samplecnt_t get_length_samples () const
-	{
-		assert (sample_start <= sample_end);
-		return sample_end - sample_start;
-	}
-
-	samplepos_t get_center_sample () const
-	{
-		return sample_start + (get_length_samples() / 2);
-	}
-
-	bool is_equivalent (WaveViewProperties const& other)
-	{
-		return (samples_per_pixel == other.samples_per_pixel &&
-		        contains (other.sample_start, other.sample_end) && channel == other.channel &&
-		        height == other.height && amplitude == other.amplitude &&
-		        amplitude_above_axis == other.amplitude_above_axis && fill_color == other.fill_color &&
-		        outline_color == other.outline_color && zero_color == other.zero_color &&
-		        clip_color == other.clip_color && show_zero == other.show_zero &&
-		        logscaled == other.logscaled && shape == other.shape &&
-		        gradient_depth == other.gradient_depth);
-		// region_start && start_shift??
-	}
-
-	bool contains (samplepos_t start, samplepos_t end)
-	{
-		return (sample_start <= start && end <= sample_end);
-	}
+	struct Hash {
+		size_t operator() (WaveViewTileKey const&) const;
+	};
 };
 
-struct WaveViewImage {
+struct WaveViewTile {
 public: // ctors
-	WaveViewImage (std::shared_ptr<const ARDOUR::AudioRegion> const& region_ptr,
-	               WaveViewProperties const& properties);
+	WaveViewTile (WaveViewTileKey const&, std::shared_ptr<ARDOUR::AudioSource> const&);
+	~WaveViewTile ();
 
-	~WaveViewImage ();
+	/** width of every tile, in pixels */
+	static const int width = 256;
 
 public: // member variables
-	std::weak_ptr<const ARDOUR::AudioRegion> region;
-	WaveViewProperties props;
-	Cairo::RefPtr<Cairo::ImageSurface> cairo_image;
-	uint64_t timestamp;
+	WaveViewTileKey                      key;
+	std::weak_ptr<ARDOUR::AudioSource>   source;
+	Cairo::RefPtr<Cairo::ImageSurface>   cairo_image;
+
+	/** Source position up to which cairo_image shows actual data. Tiles
+	 * at the end of a source that is still being written to, or that were
+	 * drawn before peaks were available, become stale.
+	 */
+	samplepos_t valid_end;
 
 public: // methods
-	bool finished() { return static_cast<bool>(cairo_image); }
+	/* cairo_image and valid_end must only be accessed once finished () */
+	bool finished () const { return _finished.load (); }
+	void set_finished () { _finished.store (1); }
 
-	bool
-	contains_image_with_properties (WaveViewProperties const& other_props)
-	{
-		return cairo_image && props.is_equivalent (other_props);
-	}
+	bool stopped () const { return (bool) _stop.load (); }
+	void cancel () { _stop.store (1); }
 
-	bool is_valid () {
-		return props.is_valid ();
-	}
+	samplepos_t sample_start () const { return llrint (key.tile * width * key.samples_per_pixel); }
+	samplepos_t sample_end () const { return llrint ((key.tile + 1) * width * key.samples_per_pixel); }
 
-	size_t size_in_bytes ()
+	bool is_stale (samplepos_t source_length) const
 	{
-		// 4 = bytes per FORMAT_ARGB32 pixel
-		return props.height * props.get_width_pixels() * 4;
+		return valid_end < std::min (sample_end (), source_length);
 	}
-};
 
-struct WaveViewDrawRequest
-{
-public:
-	WaveViewDrawRequest ();
-	~WaveViewDrawRequest ();
-
-	bool stopped() const { return (bool) _stop.load (); }
-	void cancel() { _stop.store (1); }
-	bool finished() { return image->finished(); }
-
-	std::shared_ptr<WaveViewImage> image;
-
-	bool is_valid () {
-		return (image && image->is_valid());
+	size_t size_in_bytes () const
+	{
+		// 4 = bytes per FORMAT_ARGB32 pixel
+		return key.height * width * 4;
 	}
 
 private:
+	std::atomic<int> _finished; /* intended for atomic access */
 	std::atomic<int> _stop; /* intended for atomic access */
 };
 
-class WaveViewCache;
-
-class WaveViewCacheGroup
+struct WaveViewDrawRequest
 {
 public:
-	WaveViewCacheGroup (WaveViewCache& parent_cache);
-
-	~WaveViewCacheGroup ();
-
-public:
-
-	// @return image with matching properties or null
-	std::shared_ptr<WaveViewImage> lookup_image (WaveViewProperties const&);
-
-	void add_image (std::shared_ptr<WaveViewImage>);
-
-	bool full () const { return _cached_images.size() > max_size(); }
-
-	static uint32_t max_size () { return 16; }
-
-	void clear_cache ();
-
-private:
+	WaveViewDrawRequest (std::shared_ptr<const ARDOUR::AudioRegion> const&, std::shared_ptr<WaveViewTile> const&);
+	~WaveViewDrawRequest ();
 
-	/**
-	 * At time of writing we don't strictly need a reference to the parent cache
-	 * as there is only a single global cache but if the image cache ever becomes
-	 * a per canvas cache then a using a reference is handy.
+	/* A tile that was evicted from the cache, and is not used by any
+	 * WaveView is only referenced by this request, and need not be drawn.
 	 */
-	WaveViewCache& _parent_cache;
+	bool stopped() const { return tile->stopped () || tile.use_count () < 2; }
+	void cancel() { tile->cancel (); }
+	bool finished() { return tile->finished (); }
 
-	typedef std::list<std::shared_ptr<WaveViewImage> > ImageCache;
-	ImageCache _cached_images;
+	std::weak_ptr<const ARDOUR::AudioRegion> region;
+	std::shared_ptr<WaveViewTile> tile;
 };
 
+/** A global cache of rendered tiles, shared by all WaveViews.
+ *
+ * Tiles are kept in least-recently-used order, and the oldest ones are
+ * dropped when the total size of their images exceeds the threshold.
+ * The cache is only accessed from the GUI thread.
+ */
 class WaveViewCache
 {
 public:
@@ -263,28 +179,37 @@ public:
 
 	void clear_cache ();
 
-	std::shared_ptr<WaveViewCacheGroup> get_cache_group (std::shared_ptr<ARDOUR::AudioSource>);
+	/** @return tile with the given key, or null */
+	std::shared_ptr<WaveViewTile> lookup (WaveViewTileKey const&);
+
+	/** @return a finished tile that only differs from the given key by
+	 * height, or null. Used as placeholder until a tile of the required
+	 * height is available.
+	 */
+	std::shared_ptr<WaveViewTile> lookup_any_height (WaveViewTileKey const&);
 
-	void reset_cache_group (std::shared_ptr<WaveViewCacheGroup>&);
+	/** add tile, replacing any existing tile with the same key */
+	void add (std::shared_ptr<WaveViewTile>);
 
 private:
 	WaveViewCache();
 	~WaveViewCache();
 
 private:
-	typedef std::map<std::shared_ptr<ARDOUR::AudioSource>, std::shared_ptr<WaveViewCacheGroup> >
-	    CacheGroups;
+	typedef std::list<std::shared_ptr<WaveViewTile> > TileList;
+	typedef std::unordered_map<WaveViewTileKey, TileList::iterator, WaveViewTileKey::Hash> TileMap;
+	typedef std::unordered_map<WaveViewTileKey, std::weak_ptr<WaveViewTile>, WaveViewTileKey::Hash> LatestMap;
 
-	CacheGroups cache_group_map;
+	TileList  _tiles; ///< most recently used first
+	TileMap   _tile_map;
+	LatestMap _latest; ///< most recently used finished tile, by key with height 0
 
 	uint64_t image_cache_size;
 	uint64_t _image_cache_threshold;
 
 private:
-	friend class WaveViewCacheGroup;
-
-	void increase_size (uint64_t bytes);
-	void decrease_size (uint64_t bytes);
+	void remember_finished (std::shared_ptr<WaveViewTile> const&);
+	void evict ();
 
 	bool full () { return image_cache_size > _image_cache_threshold; }
 };
@@ -21,6 +21,7 @@ export const JSON_INF = 1.0e+128;
 export const StateNode = Object.freeze({
 	STRIP_DESCRIPTION              : 'strip_description',
 	STRIP_METER                    : 'strip_meter',
+	STRIP_DSP_STATS                : 'strip_dsp_stats',
 	STRIP_GAIN                     : 'strip_gain',
 	STRIP_PAN                      : 'strip_pan',
 	STRIP_MUTE                     : 'strip_mute',